@@ -1,4 +1,8 @@
 #include <QString>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QPair>
 
 #include <Sloppy/libSloppy.h>
 
@@ -6,6 +10,8 @@
 #include "TournamentDB.h"
 #include "PlayerMngr.h"
 #include "CatMngr.h"
+#include "TeamMngr.h"
+#include "CentralSignalEmitter.h"
 
 namespace QTournament
 {
@@ -104,12 +110,47 @@ namespace QTournament
 
   //----------------------------------------------------------------------------
 
+  /**
+   * Checks a list of import records for errors and conflicts.
+   *
+   * All existing player names and all categories are read from the database
+   * only once before the records are checked. Redundant names within the
+   * list are detected using a hash map, so the total effort is linear
+   * in the number of records.
+   *
+   * @param db the tournament database
+   * @param data the records to check
+   *
+   * @return a list of all errors, sorted by row
+   */
   vector<CSVError> analyseCSV(TournamentDB* db, const vector<CSVImportRecord>& data)
   {
     vector<CSVError> result;
 
-    PlayerMngr pm{db};
+    // preload the names of all existing players
+    PlayerNameMap existingNames = PlayerMngr{db}.getAllPlayerNames();
+
+    // preload the relevant properties of all categories
+    struct CatInfo
+    {
+      bool canAddPlayers;
+      CAT_ADD_STATE addStateBySex[3];   // indexed by M, F, DONT_CARE
+    };
+    QHash<QString, CatInfo> catName2Info;
     CatMngr cm{db};
+    for (const Category& cat : cm.getAllCategories())
+    {
+      CatInfo ci;
+      ci.canAddPlayers = cat.canAddPlayers();
+      for (SEX s : {M, F, DONT_CARE})
+      {
+        ci.addStateBySex[s] = ci.canAddPlayers ? cat.getAddState(s) : CAT_CLOSED;
+      }
+      catName2Info.insert(cat.getName(), ci);
+    }
+
+    // maps a (first name, last name) pair to all earlier rows with this name
+    QHash<QPair<QString, QString>, vector<int>> name2Rows;
 
     int row = 0;
     for (const CSVImportRecord& rec : data)
@@ -136,9 +177,11 @@ namespace QTournament
         result.push_back(err);
       }
 
+      auto name = qMakePair(rec.getFirstName(), rec.getLastName());
+
       // check if the name is globally unique
       // (--> not yet in the database)
-      if (rec.hasExistingName())
+      if (rec.hasLastName() && rec.hasFirstName() && existingNames.contains(name))
       {
         CSVError err{row, CSVFieldsIndex::FirstName, CSVErrCode::NameNotUnique, "", false};
         result.push_back(err);
@@ -150,49 +193,44 @@ namespace QTournament
       // (--> not yet in this list of records)
       if (rec.hasLastName() && rec.hasFirstName())
       {
-        for (int earlierRow = 0; earlierRow < row; ++earlierRow)
+        vector<int>& earlierRows = name2Rows[name];
+        for (int earlierRow : earlierRows)
         {
-          const CSVImportRecord& other = data[earlierRow];
-          if ((rec.getLastName() == other.getLastName()) && (rec.getFirstName() == other.getFirstName()))
-          {
-            // generate an error and add 1 to the row number
-            // so that it matches the row numbers in the tab widget
-            CSVError err{row, CSVFieldsIndex::FirstName, CSVErrCode::NameRedundant, QString::number(earlierRow + 1), true};
-            result.push_back(err);
-            err = CSVError{row, CSVFieldsIndex::LastName, CSVErrCode::NameRedundant, QString::number(earlierRow + 1), true};
-            result.push_back(err);
-          }
+          // generate an error and add 1 to the row number
+          // so that it matches the row numbers in the tab widget
+          CSVError err{row, CSVFieldsIndex::FirstName, CSVErrCode::NameRedundant, QString::number(earlierRow + 1), true};
+          result.push_back(err);
+          err = CSVError{row, CSVFieldsIndex::LastName, CSVErrCode::NameRedundant, QString::number(earlierRow + 1), true};
+          result.push_back(err);
         }
+        earlierRows.push_back(row);
       }
 
       // check for valid categories
-      if (!(rec.getCatNames().empty()))
+      for (const QString& cName : rec.getCatNames())
       {
-        for (const QString& cName : rec.getCatNames())
+        // does the category exist?
+        auto it = catName2Info.constFind(cName);
+        if (it == catName2Info.constEnd())
         {
-          // does the category exist?
-          if (!(cm.hasCategory(cName)))
-          {
-            CSVError err{row, CSVFieldsIndex::Categories, CSVErrCode::CategoryNotExisting, cName, false};
-            result.push_back(err);
+          CSVError err{row, CSVFieldsIndex::Categories, CSVErrCode::CategoryNotExisting, cName, false};
+          result.push_back(err);
 
-            continue;
-          }
+          continue;
+        }
 
-          // can players be added to the category?
-          Category cat = cm.getCategory(cName);
-          if (cat.canAddPlayers())
+        // can players be added to the category?
+        const CatInfo& ci = it.value();
+        if (ci.canAddPlayers)
+        {
+          if (ci.addStateBySex[rec.getSex()] != CAN_JOIN)
           {
-            CAT_ADD_STATE as = cat.getAddState(rec.getSex());
-            if (as != CAN_JOIN)
-            {
-              CSVError err{row, CSVFieldsIndex::Categories, CSVErrCode::CategoryNotSuitable, cName, false};
-              result.push_back(err);
-            }
-          } else {
-            CSVError err{row, CSVFieldsIndex::Categories, CSVErrCode::CategoryLocked, cName, false};
+            CSVError err{row, CSVFieldsIndex::Categories, CSVErrCode::CategoryNotSuitable, cName, false};
             result.push_back(err);
           }
+        } else {
+          CSVError err{row, CSVFieldsIndex::Categories, CSVErrCode::CategoryLocked, cName, false};
+          result.push_back(err);
         }
       }
 
@@ -203,6 +241,118 @@ namespace QTournament
     return result;
   }
 
+  /**
+   * Imports a list of (error free) records into the tournament.
+   *
+   * Missing teams are created, new players are inserted and all players
+   * are assigned to their categories. Everything happens in a single
+   * transaction, so the import either succeeds completely or leaves the
+   * database untouched. Category assignments that are not possible
+   * (e.g., wrong sex) are silently skipped.
+   *
+   * Instead of one signal per object, all models are reset once.
+   *
+   * @param db the tournament database
+   * @param data the records to import; they should have been checked with analyseCSV() before
+   *
+   * @return OK or an error code
+   */
+  ERR importCSV(TournamentDB* db, const vector<CSVImportRecord>& data)
+  {
+    if (data.empty()) return OK;
+
+    PlayerNameMap existingNames = PlayerMngr{db}.getAllPlayerNames();
+
+    // collect the teams and players that have to be created
+    QStringList teamNames;
+    vector<NewPlayerData> newPlayers;
+    for (const CSVImportRecord& rec : data)
+    {
+      if (rec.hasTeamName() && !(teamNames.contains(rec.getTeamName())))
+      {
+        teamNames.append(rec.getTeamName());
+      }
+
+      auto name = qMakePair(rec.getFirstName(), rec.getLastName());
+      if (!(existingNames.contains(name)))
+      {
+        newPlayers.push_back(NewPlayerData{rec.getFirstName(), rec.getLastName(), rec.getSex(), rec.getTeamName()});
+      }
+    }
+
+    // map all category names to IDs
+    CatMngr cm{db};
+    QHash<QString, int> catName2Id;
+    for (const Category& cat : cm.getAllCategories())
+    {
+      catName2Id[cat.getName()] = cat.getId();
+    }
+
+    CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+    cse->beginResetAllModels();
+
+    // lock the database before writing
+    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
+
+    bool isDbErr;
+    auto tg = db->acquireTransactionGuard(false, &isDbErr);
+    ERR err = isDbErr ? DATABASE_ERROR : OK;
+
+    // step 1: teams
+    if ((err == OK) && !(teamNames.isEmpty()))
+    {
+      TeamMngr tm{db};
+      err = tm.createNewTeams(teamNames);
+    }
+
+    // step 2: players
+    if ((err == OK) && !(newPlayers.empty()))
+    {
+      PlayerMngr pm{db};
+      vector<int> newIds;
+      err = pm.createNewPlayers(newPlayers, &newIds);
+      if (err == OK)
+      {
+        for (size_t idx = 0; idx < newPlayers.size(); ++idx)
+        {
+          existingNames[qMakePair(newPlayers[idx].firstName, newPlayers[idx].lastName)] = PlayerIdAndSex{newIds[idx], newPlayers[idx].sex};
+        }
+      }
+    }
+
+    // step 3: category assignments
+    if (err == OK)
+    {
+      vector<pair<int, int>> playerAndCatIds;
+      for (const CSVImportRecord& rec : data)
+      {
+        int playerId = existingNames.value(qMakePair(rec.getFirstName(), rec.getLastName()), PlayerIdAndSex{-1, DONT_CARE}).id;
+        if (playerId < 1) continue;
+
+        for (const QString& cName : rec.getCatNames())
+        {
+          // skip non-existing categories
+          auto it = catName2Id.constFind(cName);
+          if (it == catName2Id.constEnd()) continue;
+
+          playerAndCatIds.push_back(make_pair(playerId, it.value()));
+        }
+      }
+
+      err = cm.addPlayersToCategories(playerAndCatIds);
+    }
+
+    if ((err == OK) && (tg != nullptr))
+    {
+      if (!(tg->commit())) err = DATABASE_ERROR;
+    }
+    tg.reset();  // implicit rollback in case of errors
+
+    cse->endResetAllModels();
+
+    return err;
+  }
+
   //----------------------------------------------------------------------------
   //----------------------------------------------------------------------------
   //----------------------------------------------------------------------------
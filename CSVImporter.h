@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "TournamentDataDefs.h"
+#include "TournamentErrorCodes.h"
 #include "Player.h"
 
 using namespace std;
@@ -90,6 +91,7 @@ namespace QTournament
   vector<vector<string>> splitCSV(const string& rawText, const string& delim = ",", const string& optionalCatName="");
   vector<CSVImportRecord> convertCSVfromPlainText(TournamentDB* db, const vector<vector<string>>& splitData);
   vector<CSVError> analyseCSV(TournamentDB* db, const vector<CSVImportRecord>& data);
+  ERR importCSV(TournamentDB* db, const vector<CSVImportRecord>& data);
 
 }
 
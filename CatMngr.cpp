@@ -20,6 +20,9 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qjsonarray.h>
 #include <QList>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
 
 #include <SqliteOverlay/Transaction.h>
 
@@ -35,6 +38,7 @@
 #include "HelperFunc.h"
 #include "CentralSignalEmitter.h"
 #include "MatchMngr.h"
+#include "HotPathTracer.h"
 #include "PlayerMngr.h"
 
 namespace QTournament
@@ -105,9 +109,8 @@ namespace QTournament
       return INVALID_NAME;
     }
 
-    // try create a new category until we've found a valid name
+    // find a name for the clone that is not yet in use
     int cnt = 0;
-    ERR err;
     QString dstCatName;
     do
     {
@@ -122,64 +125,96 @@ namespace QTournament
         dstCatName = trimmedSrcCatName + " - " + catNamePostfix + " " + QString::number(cnt);
         trimmedSrcCatName.chop(1);
       } while (dstCatName.length() > MAX_NAME_LEN);
-
-      // try to actually create the category
-      err = createNewCategory(dstCatName);
-    } while ((err == NAME_EXISTS) && (cnt < 100));   // a maximum limit of 100 retries
+    } while (hasCategory(dstCatName) && (cnt < 100));   // a maximum limit of 100 retries
 
     // did we succeed?
-    if (err != OK)
-    {
-      return err;   // give up
-    }
-    Category clone = getCategory(dstCatName);
-
-    // copy the settings fromt the source category to clone
-    err = clone.setMatchSystem(src.getMatchSystem());
-    assert(err == OK);
-    err = clone.setMatchType(src.getMatchType());
-    assert(err == OK);
-    err = clone.setSex(src.getSex());
-    assert(err == OK);
-    bool isOk = setCatParam_AllowDraw(clone, src.getParameter_bool(ALLOW_DRAW));
-    assert(isOk);
-    isOk = setCatParam_Score(clone, src.getParameter_int(WIN_SCORE), false);
-    assert(isOk);
-    setCatParam_Score(clone, src.getParameter_int(DRAW_SCORE), true);  // no assert here; setting draw score may fail if draw is not allowed
-    KO_Config ko{src.getParameter_string(GROUP_CONFIG)};
-    isOk = clone.setParameter(GROUP_CONFIG, ko.toString());
-    assert(isOk);
-    setCatParameter(clone, ROUND_ROBIN_ITERATIONS, src.getParameter_int(ROUND_ROBIN_ITERATIONS));
+    if (hasCategory(dstCatName))
+    {
+      return NAME_EXISTS;   // give up
+    }
+
+    // the category, its players and its pairs are copied with
+    // one INSERT ... SELECT per table instead of re-creating them
+    // through the regular API with checks and signals for each
+    // single player and pair
+    //
+    // the settings of the source category are valid, so the
+    // same settings are valid for the clone as well
+    CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+    cse->beginResetAllModels();
+
+    // lock the database before writing
+    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
 
+    bool isDbErr;
+    auto tg = db->acquireTransactionGuard(false, &isDbErr);
+    ERR err = isDbErr ? DATABASE_ERROR : OK;
+
+    // step 1: the category itself, in state CONFIG and
+    // with the next free sequence number
+    //
     // Do not copy the BracketVisData here, because the clone is still in
     // CONFIG and BracketVisData is created when starting the cat
+    int cloneId = -1;
+    if (err == OK)
+    {
+      // the name is not part of any SQL string, so
+      // it may contain quotes or '%' characters
+      SqliteOverlay::ColumnValueClause cvc;
+      cvc.addStringCol(GENERIC_NAME_FIELD_NAME, dstCatName.toUtf8().constData());
+      cvc.addIntCol(GENERIC_STATE_FIELD_NAME, static_cast<int>(STAT_CAT_CONFIG));
+      cvc.addIntCol(GENERIC_SEQNUM_FIELD_NAME, tab->length());
 
-    // assign the players to the category
-    for (const Player& pl : src.getAllPlayersInCategory())
+      int dbErr;
+      cloneId = tab->insertRow(cvc, &dbErr);
+      if ((cloneId < 1) || (dbErr != SQLITE_DONE)) err = DATABASE_ERROR;
+    }
+
+    // step 1b: copy the settings of the source category
+    if (err == OK)
     {
-      err = addPlayerToCategory(pl, clone);
-      if (err != OK)
+      QStringList settingCols{CAT_MATCH_TYPE, CAT_SEX, CAT_SYS, CAT_ACCEPT_DRAW, CAT_WIN_SCORE,
+                              CAT_DRAW_SCORE, CAT_GROUP_CONFIG, CAT_ROUND_ROBIN_ITERATIONS};
+      QStringList assignments;
+      for (const QString& col : settingCols)
       {
-        return err;   // shouldn't happen
+        assignments << QString{"%1 = (SELECT %1 FROM %2 WHERE id = %3)"}.arg(col).arg(TAB_CATEGORY).arg(src.getId());
       }
+
+      QString sql = "UPDATE %1 SET %2 WHERE id = %3";
+      sql = sql.arg(TAB_CATEGORY).arg(assignments.join(", ")).arg(cloneId);
+      if (!(db->execNonQuery(sql.toUtf8().constData()))) err = DATABASE_ERROR;
     }
 
-    // pair players, if applicable
-    if (src.getMatchType() != SINGLES)
+    // step 2: the player assignments
+    if (err == OK)
     {
-      for (const PlayerPair& pp : src.getPlayerPairs())
-      {
-        if (!(pp.hasPlayer2())) continue;
+      QString sql = "INSERT INTO %1 (%2, %3) SELECT %2, %4 FROM %1 WHERE %3 = %5";
+      sql = sql.arg(TAB_P2C).arg(P2C_PLAYER_REF).arg(P2C_CAT_REF).arg(cloneId).arg(src.getId());
+      if (!(db->execNonQuery(sql.toUtf8().constData()))) err = DATABASE_ERROR;
+    }
 
-        err = pairPlayers(clone, pp.getPlayer1(), pp.getPlayer2());
-        if (err != OK)
-        {
-          return err;   // shouldn't happen
-        }
-      }
+    // step 3: the player pairs, if applicable; only "real"
+    // pairs with two players, without group assignments
+    // or initial ranks
+    if ((err == OK) && (src.getMatchType() != SINGLES))
+    {
+      QString sql = "INSERT INTO %1 (%2, %3, %4, %5) SELECT %6, %3, %4, %7 FROM %1 WHERE %2 = %8 AND %4 IS NOT NULL";
+      sql = sql.arg(TAB_PAIRS).arg(PAIRS_CAT_REF).arg(PAIRS_PLAYER1_REF).arg(PAIRS_PLAYER2_REF).arg(PAIRS_GRP_NUM);
+      sql = sql.arg(cloneId).arg(GRP_NUM__NOT_ASSIGNED).arg(src.getId());
+      if (!(db->execNonQuery(sql.toUtf8().constData()))) err = DATABASE_ERROR;
     }
 
-    return OK;
+    if ((err == OK) && (tg != nullptr))
+    {
+      if (!(tg->commit())) err = DATABASE_ERROR;
+    }
+    tg.reset();  // implicit rollback in case of errors
+
+    // a single notification for the category, players and pairs
+    cse->endResetAllModels();
+
+    return err;
   }
 
 //----------------------------------------------------------------------------
@@ -246,6 +281,7 @@ namespace QTournament
     // TODO: implement checks, updates to other tables etc
     int sysInt = static_cast<int>(s);    
     c.row.update(CAT_SYS, sysInt);
+    db->getCatParameterCache()->invalidate(c.getId());
     
     // if we switch to single elimination categories or
     // to the ranking system, we want to
@@ -309,6 +345,7 @@ namespace QTournament
     // change the match type
     int typeInt = static_cast<int>(t);    
     c.row.update(CAT_MATCH_TYPE, typeInt);
+    db->getCatParameterCache()->invalidate(c.getId());
     
     // try to recreate as many pairs as possible
     for (const PlayerPair& pp : pairList)
@@ -402,6 +439,7 @@ namespace QTournament
     // execute the actual change
     int sexInt = static_cast<int>(s);    
     c.row.update(CAT_SEX, sexInt);
+    db->getCatParameterCache()->invalidate(c.getId());
     
     return OK;
   }
@@ -441,6 +479,110 @@ namespace QTournament
     return OK;
   }
 
+//----------------------------------------------------------------------------
+
+  /**
+   * Adds a list of players to categories in a single transaction.
+   *
+   * Assignments that would fail in addPlayerToCategory() (closed category,
+   * player already in category, player not suitable) are silently skipped.
+   * The player's sex and the existing assignments are read only once for
+   * the whole list.
+   *
+   * In contrast to addPlayerToCategory(), no signals are emitted. The caller
+   * is responsible for resetting all models.
+   *
+   * @param playerAndCatIds a list of (player ID, category ID) pairs
+   * @param nAdded optional pointer to an int that receives the number of actually added players
+   *
+   * @return OK or an error code; in case of errors, no player has been added
+   */
+  ERR CatMngr::addPlayersToCategories(const vector<pair<int, int>>& playerAndCatIds, int* nAdded)
+  {
+    if (nAdded != nullptr) *nAdded = 0;
+    if (playerAndCatIds.empty()) return OK;
+
+    // read the sex of all players at once
+    bool isDbErr;
+    QHash<int, SEX> playerId2Sex;
+    for (const PlayerIdAndSex& pis : PlayerMngr{db}.getAllPlayerNames(&isDbErr))
+    {
+      playerId2Sex[pis.id] = pis.sex;
+    }
+    if (isDbErr) return DATABASE_ERROR;
+
+    // read all existing assignments at once
+    QSet<QPair<int, int>> existingAssignments;
+    auto stmt = db->execContentQuery(string{"SELECT "} + P2C_PLAYER_REF + "," + P2C_CAT_REF + " FROM " + TAB_P2C);
+    if (stmt == nullptr) return DATABASE_ERROR;
+    while (stmt->hasData())
+    {
+      int playerId;
+      int catId;
+      stmt->getInt(0, &playerId);
+      stmt->getInt(1, &catId);
+      existingAssignments.insert(qMakePair(playerId, catId));
+      stmt->step();
+    }
+
+    // determine the add states for each category only once
+    QHash<int, QHash<int, CAT_ADD_STATE>> catId2AddStates;
+
+    // lock the database before writing
+    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
+
+    // join the caller's transaction, if any (e.g., from importCSV())
+    unique_ptr<TournamentDB::TransactionGuard> tg;
+    if (!(db->isTransactionRunning())) tg = db->acquireTransactionGuard(false, &isDbErr);
+    if (isDbErr) return DATABASE_ERROR;
+
+    SqliteOverlay::DbTab* p2cTab = db->getTab(TAB_P2C);
+    int cnt = 0;
+    for (const pair<int, int>& pc : playerAndCatIds)
+    {
+      auto itSex = playerId2Sex.constFind(pc.first);
+      if (itSex == playerId2Sex.constEnd()) continue;
+
+      auto assignment = qMakePair(pc.first, pc.second);
+      if (existingAssignments.contains(assignment)) continue;
+
+      if (!(catId2AddStates.contains(pc.second)))
+      {
+        auto cat = getCategory(pc.second);
+        if (cat == nullptr) continue;
+
+        QHash<int, CAT_ADD_STATE> addStates;
+        for (SEX s : {M, F})
+        {
+          addStates[s] = cat->getAddState(s);
+        }
+        catId2AddStates[pc.second] = addStates;
+      }
+      if (catId2AddStates[pc.second].value(itSex.value(), WRONG_SEX) != CAN_JOIN) continue;
+
+      SqliteOverlay::ColumnValueClause cvc;
+      cvc.addIntCol(P2C_CAT_REF, pc.second);
+      cvc.addIntCol(P2C_PLAYER_REF, pc.first);
+
+      int dbErr;
+      int newId = p2cTab->insertRow(cvc, &dbErr);
+      if ((newId < 1) || (dbErr != SQLITE_DONE))
+      {
+        return DATABASE_ERROR;   // implicit rollback through tg's dtor
+      }
+
+      existingAssignments.insert(assignment);
+      ++cnt;
+    }
+
+    bool isOkay = tg ? tg->commit() : true;
+    if (!isOkay) return DATABASE_ERROR;
+
+    if (nAdded != nullptr) *nAdded = cnt;
+
+    return OK;
+  }
+
 //----------------------------------------------------------------------------
 
   ERR CatMngr::removePlayerFromCategory(const Player& p, const Category& c) const
@@ -518,10 +660,11 @@ namespace QTournament
     CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
     cse->beginDeleteCategory(oldSeqNum);
     tab->deleteRowsByColumnValue("id", catId);
-    fixSeqNumberAfterDelete(tab, oldSeqNum);
+    bool isOkay = fixSeqNumberAfterDelete(tab, oldSeqNum);
+    db->getCatParameterCache()->invalidate(catId);
     cse->endDeleteCategory();
 
-    return OK;
+    return isOkay ? OK : DATABASE_ERROR;
   }
 
   //----------------------------------------------------------------------------
@@ -592,29 +735,10 @@ namespace QTournament
 
     // deletion 3a: matches, they are refered to by bracket vis data only
     // deletion 3b: match groups, they are refered to only by ranking data and matches
-    t = db->getTab(TAB_MATCH);
-    auto mgTab = db->getTab(TAB_MATCH_GROUP);
-    for (const MatchGroup& mg : mm.getAllMatchGroups())
-    {
-      if (mg.getCategory() == cat)
-      {
-        auto matchesInGroup = mg.getMatches();
-        for (const Match& ma : matchesInGroup)
-        {
-          int deletedSeqNum = ma.getSeqNum();
-          t->deleteRowsByColumnValue("id", ma.getId(), &dbErr);
-          if (dbErr != SQLITE_DONE) return DATABASE_ERROR;  // implicit rollback through tg's dtor
-          fixSeqNumberAfterDelete(t, deletedSeqNum);
-        }
-
-        // the match group has incoming links from matches
-        // and ranking and both have been deleted by now
-        int deletedSeqNum = mg.getSeqNum();
-        mgTab->deleteRowsByColumnValue("id", mg.getId(), &dbErr);
-        if (dbErr != SQLITE_DONE) return DATABASE_ERROR;  // implicit rollback through tg's dtor
-        fixSeqNumberAfterDelete(mgTab, deletedSeqNum);
-      }
-    }
+    //
+    // both are deleted with one statement per table instead of row by row
+    ERR e = mm.deleteMatchGroupsAndMatches(mm.getMatchGroupsForCat(cat));
+    if (e != OK) return e;  // implicit rollback through tg's dtor
 
     // deletion 4: player pairs
     t = db->getTab(TAB_PAIRS);
@@ -630,7 +754,7 @@ namespace QTournament
     int deletedSeqNum = cat.getSeqNum();
     tab->deleteRowsByColumnValue("id", catId, &dbErr);
     if (dbErr != SQLITE_DONE) return DATABASE_ERROR;  // implicit rollback through tg's dtor
-    fixSeqNumberAfterDelete(tab, deletedSeqNum);
+    if (!(fixSeqNumberAfterDelete(tab, deletedSeqNum))) return DATABASE_ERROR;  // implicit rollback through tg's dtor
 
     //
     // deletion completed
@@ -638,6 +762,7 @@ namespace QTournament
     bool isOkay = tg ? tg->commit() : true;
     if (!isOkay) return DATABASE_ERROR;
     tg.reset();  // explicit deletion, otherwise tg's dtor might interfere with other transactions
+    db->getCatParameterCache()->invalidate(catId);
 
     // refresh all models and the reports tab
     cse->endResetAllModels();
@@ -730,6 +855,7 @@ namespace QTournament
       DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
 
       c.row.update(CAT_GROUP_CONFIG, v.toString().toUtf8().constData());
+      db->getCatParameterCache()->invalidate(c.getId());
       return true;
     }
     if (p == ROUND_ROBIN_ITERATIONS)
@@ -744,6 +870,7 @@ namespace QTournament
       DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
 
       c.row.update(CAT_ROUND_ROBIN_ITERATIONS, iterations);
+      db->getCatParameterCache()->invalidate(c.getId());
       return true;
     }
     
@@ -798,6 +925,7 @@ namespace QTournament
 
     // set the new status
     c.row.update(CAT_ACCEPT_DRAW, allowDraw);
+    db->getCatParameterCache()->invalidate(c.getId());
     return true;
   }
 
@@ -837,6 +965,7 @@ namespace QTournament
       }
       
       c.row.update(CAT_DRAW_SCORE, newScore);
+      db->getCatParameterCache()->invalidate(c.getId());
       return true;
     }
 
@@ -847,6 +976,7 @@ namespace QTournament
     }
 
     c.row.update(CAT_WIN_SCORE, newScore);
+    db->getCatParameterCache()->invalidate(c.getId());
     return true;
   }
 
@@ -957,7 +1087,8 @@ namespace QTournament
     DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
 
     c.row.update(GENERIC_NAME_FIELD_NAME, newName.toUtf8().constData());
-    
+    CentralSignalEmitter::getInstance()->categoryRenamed(c);
+
     return OK;
   }
 
@@ -1114,6 +1245,8 @@ namespace QTournament
 
   ERR CatMngr::startCategory(const Category &c, vector<PlayerPairList> grpCfg, PlayerPairList seed, ProgressQueue *progressNotificationQueue)
   {
+    TRACE_SCOPE("CatMngr::startCategory");
+
     // we can only transition to "IDLE" if we are "FROZEN"
     if (c.getState() != STAT_CAT_FROZEN)
     {
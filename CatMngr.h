@@ -71,6 +71,7 @@ namespace QTournament
     // modifications
     ERR renameCategory(Category& c, const QString& newName);
     ERR addPlayerToCategory(const Player& p, const Category& c);
+    ERR addPlayersToCategories(const vector<pair<int, int>>& playerAndCatIds, int* nAdded = nullptr);
     ERR removePlayerFromCategory(const Player& p, const Category& c) const;
     ERR deleteCategory(const Category& cat) const;
     ERR deleteRunningCategory(const Category& cat) const;
@@ -0,0 +1,143 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include "CatParameterCache.h"
+#include "TournamentDB.h"
+
+namespace QTournament
+{
+
+  CatParameterCache::CatParameterCache(TournamentDB* _db)
+    :db(_db), globalVersion{0}
+  {
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * @param catId the ID of the category
+   *
+   * @return the current parameters of the category; throws if the category doesn't exist
+   */
+  spCatParameterSnapshot CatParameterCache::getSnapshot(int catId)
+  {
+    auto it = catId2Snapshot.find(catId);
+    if (it != catId2Snapshot.end()) return it->second;
+
+    spCatParameterSnapshot snap = loadSnapshot(catId);
+    if (snap == nullptr)
+    {
+      throw std::invalid_argument("Can't read parameters of non-existing category");
+    }
+
+    catId2Snapshot[catId] = snap;
+    return snap;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatParameterCache::invalidate(int catId)
+  {
+    catId2Snapshot.erase(catId);
+    ++catId2Version[catId];
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatParameterCache::invalidateAll()
+  {
+    catId2Snapshot.clear();
+    ++globalVersion;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * @return the version number of a category's parameters; a different
+   * value than before means that the parameters might have changed
+   */
+  int CatParameterCache::getVersion(int catId) const
+  {
+    // both counters only ever increase, so their sum
+    // changes with each invalidation of this category
+    auto it = catId2Version.find(catId);
+    return globalVersion + ((it == catId2Version.end()) ? 0 : it->second);
+  }
+
+  //----------------------------------------------------------------------------
+
+  spCatParameterSnapshot CatParameterCache::loadSnapshot(int catId)
+  {
+    QString sql = "SELECT %1, %2, %3, %4, %5, %6, %7, COALESCE(%8, '') FROM %9 WHERE id = %10";
+    sql = sql.arg(CAT_SYS).arg(CAT_MATCH_TYPE).arg(CAT_SEX);
+    sql = sql.arg(CAT_ACCEPT_DRAW).arg(CAT_WIN_SCORE).arg(CAT_DRAW_SCORE);
+    sql = sql.arg(CAT_ROUND_ROBIN_ITERATIONS).arg(CAT_GROUP_CONFIG);
+    sql = sql.arg(TAB_CATEGORY).arg(catId);
+
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if ((stmt == nullptr) || !(stmt->hasData())) return nullptr;
+
+    int sys;
+    int matchType;
+    int sex;
+    int allowDraw;
+    int winScore;
+    int drawScore;
+    int iterations;
+    string grpCfg;
+    stmt->getInt(0, &sys);
+    stmt->getInt(1, &matchType);
+    stmt->getInt(2, &sex);
+    stmt->getInt(3, &allowDraw);
+    stmt->getInt(4, &winScore);
+    stmt->getInt(5, &drawScore);
+    stmt->getInt(6, &iterations);
+    stmt->getString(7, &grpCfg);
+
+    QString grpCfgString = QString::fromUtf8(grpCfg.c_str());
+
+    // parse the group config only once; the string could be
+    // invalid if the category has never been configured properly
+    KO_Config ko{QUARTER, false};
+    bool isValidKo = true;
+    try
+    {
+      ko = KO_Config(grpCfgString);
+    }
+    catch (std::invalid_argument&)
+    {
+      isValidKo = false;
+    }
+
+    return make_shared<const CatParameterSnapshot>(CatParameterSnapshot{
+                                                     static_cast<MATCH_SYSTEM>(sys),
+                                                     static_cast<MATCH_TYPE>(matchType),
+                                                     static_cast<SEX>(sex),
+                                                     (allowDraw != 0),
+                                                     winScore,
+                                                     drawScore,
+                                                     iterations,
+                                                     grpCfgString,
+                                                     ko,
+                                                     isValidKo
+                                                   });
+  }
+
+}
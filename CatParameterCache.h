@@ -0,0 +1,100 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CATPARAMETERCACHE_H
+#define CATPARAMETERCACHE_H
+
+#include <memory>
+#include <unordered_map>
+
+#include <QString>
+
+#include "TournamentDataDefs.h"
+#include "KO_Config.h"
+
+using namespace std;
+
+namespace QTournament
+{
+  // forward
+  class TournamentDB;
+
+  /**
+   * An immutable copy of all configuration parameters of a
+   * category, including the already parsed group configuration.
+   */
+  struct CatParameterSnapshot
+  {
+    MATCH_SYSTEM matchSystem;
+    MATCH_TYPE matchType;
+    SEX sex;
+    bool allowDraw;
+    int winScore;
+    int drawScore;
+    int roundRobinIterations;
+    QString groupConfigString;
+    KO_Config groupConfig;   // only meaningful if hasValidGroupConfig; use Category::getGroupConfig()
+    bool hasValidGroupConfig;
+  };
+
+  using spCatParameterSnapshot = shared_ptr<const CatParameterSnapshot>;
+
+  /**
+   * Caches the parameter snapshots of all categories.
+   *
+   * A snapshot is read with a single query upon first access. The
+   * category parameters can only be modified through the CatMngr and the
+   * CatMngr explicitly invalidates the snapshot after each modification.
+   * A transaction rollback invalidates all snapshots.
+   *
+   * The snapshots are handed out as shared pointers, so a caller
+   * can safely keep a snapshot even if it is invalidated in the meantime.
+   *
+   * Each invalidation increases the version number of the affected
+   * categories; other caches (e.g., the ReportCache) can use it for
+   * detecting parameter changes.
+   *
+   * There is one instance per tournament database and it is owned by the
+   * TournamentDB object.
+   */
+  class CatParameterCache
+  {
+  public:
+    CatParameterCache(TournamentDB* _db);
+
+    spCatParameterSnapshot getSnapshot(int catId);
+
+    void invalidate(int catId);
+    void invalidateAll();
+
+    // increases with each modification of the category's parameters
+    int getVersion(int catId) const;
+
+  protected:
+    spCatParameterSnapshot loadSnapshot(int catId);
+
+  private:
+    TournamentDB* db;
+    unordered_map<int, spCatParameterSnapshot> catId2Snapshot;
+    unordered_map<int, int> catId2Version;
+    int globalVersion;
+  };
+
+}
+
+#endif // CATPARAMETERCACHE_H
@@ -19,7 +19,7 @@
 #include <exception>
 
 #include "CatRoundStatus.h"
-#include "MatchMngr.h"
+#include "CatRoundStatusCache.h"
 
 namespace QTournament
 {
@@ -49,30 +49,22 @@ QList<int> CatRoundStatus::getCurrentlyRunningRoundNumbers() const
   QList<int> result;
 
   int lastFinishedRound = getFinishedRoundsCount();
-  int minRoundRunning = -1;
-  int maxRoundRunning = -1;
 
   // the initial round that could be in state RUNNING
-  int roundToCheck = (lastFinishedRound < 0) ? 1 : lastFinishedRound+1;
-
-  // the last round that can possibly in state RUNNING
-  MatchMngr mm{db};
-  int lastRoundToCheck = mm.getHighestUsedRoundNumberInCategory(cat);
+  int firstRoundToCheck = (lastFinishedRound < 0) ? 1 : lastFinishedRound+1;
 
   // loop through all applicable rounds and check their status
-  while (roundToCheck <= lastRoundToCheck)
+  //
+  // the counters only contain rounds with match groups, so
+  // we implicitly stop at the highest used round number
+  CatRoundCounters crc = db->getRoundStatusCache()->getCounters(cat);
+  for (auto it = crc.lower_bound(firstRoundToCheck); it != crc.end(); ++it)
   {
-    bool hasFinishedMatches = cat.hasMatchesInState(STAT_MA_FINISHED, roundToCheck);
-    bool hasRunningMatches = cat.hasMatchesInState(STAT_MA_RUNNING, roundToCheck);
-
-    if (hasFinishedMatches || hasRunningMatches)
+    const RoundCounters& rc = it->second;
+    if ((rc.nFinishedMatches > 0) || (rc.nRunningMatches > 0))
     {
-      if (minRoundRunning < 0) minRoundRunning = roundToCheck;
-      if (maxRoundRunning < roundToCheck) maxRoundRunning = roundToCheck;
-      result.append(roundToCheck);
+      result.append(it->first);
     }
-
-    ++roundToCheck;
   }
 
   return result;
@@ -82,8 +74,10 @@ QList<int> CatRoundStatus::getCurrentlyRunningRoundNumbers() const
 
 int CatRoundStatus::getHighestGeneratedMatchRound() const
 {
-  MatchMngr mm{db};
-  return mm.getHighestUsedRoundNumberInCategory(cat);
+  CatRoundCounters crc = db->getRoundStatusCache()->getCounters(cat);
+  if (crc.empty()) return 0;
+
+  return crc.rbegin()->first;
 }
 
 //----------------------------------------------------------------------------
@@ -103,7 +97,7 @@ int CatRoundStatus::getCurrentlyRunningRoundNumber() const
 
 int CatRoundStatus::getFinishedRoundsCount() const
 {
-  MatchMngr mm{db};
+  CatRoundCounters crc = db->getRoundStatusCache()->getCounters(cat);
 
   int roundNum = 1;
   int lastFinishedRound = NO_ROUNDS_FINISHED_YET;
@@ -111,22 +105,13 @@ int CatRoundStatus::getFinishedRoundsCount() const
   // go through rounds one by one
   while (true)
   {
-    MatchGroupList matchGroupsInThisRound = mm.getMatchGroupsForCat(cat, roundNum);
     // finish searching for rounds when no more groups show up
-    // in the search
-    if (matchGroupsInThisRound.size() == 0) break;
+    auto it = crc.find(roundNum);
+    if ((it == crc.end()) || (it->second.nGroups == 0)) break;
 
-    bool allGroupsFinished = true;
-    for (MatchGroup mg : matchGroupsInThisRound)
-    {
-      if (mg.getState() != STAT_MG_FINISHED)
-      {
-        allGroupsFinished = false;
-        break;
-      }
-    }
-
-    if (!allGroupsFinished) break;
+    // stop if not all groups in this round are finished
+    const RoundCounters& rc = it->second;
+    if (rc.nFinishedGroups != rc.nGroups) break;
 
     // we only make it to this point if all match groups
     // in this round are finished.
@@ -156,19 +141,13 @@ tuple<int, int, int> CatRoundStatus::getMatchCountForCurrentRound() const
   int runningMatchCount = 0;
   int totalMatchCount = 0;
 
-  MatchMngr mm{db};
+  CatRoundCounters crc = db->getRoundStatusCache()->getCounters(cat);
   for (int curRound : runningRounds)
   {
-    MatchGroupList matchGroupsInThisRound = mm.getMatchGroupsForCat(cat, curRound);
-    for (MatchGroup mg : matchGroupsInThisRound)
-    {
-      for (Match ma : mg.getMatches())
-      {
-        if (ma.getState() != STAT_MA_FINISHED) ++unfinishedMatchCount;
-        if (ma.getState() == STAT_MA_RUNNING) ++runningMatchCount;
-        ++totalMatchCount;
-      }
-    }
+    const RoundCounters& rc = crc.at(curRound);
+    unfinishedMatchCount += rc.nMatches - rc.nFinishedMatches;
+    runningMatchCount += rc.nRunningMatches;
+    totalMatchCount += rc.nMatches;
   }
 
   // total, unfinished, running
@@ -0,0 +1,329 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+
+#include <QString>
+
+#include "CatRoundStatusCache.h"
+#include "TournamentDB.h"
+#include "Category.h"
+#include "MatchMngr.h"
+#include "CentralSignalEmitter.h"
+
+namespace QTournament
+{
+
+  bool RoundCounters::operator==(const RoundCounters& other) const
+  {
+    return ((nGroups == other.nGroups) &&
+            (nFinishedGroups == other.nFinishedGroups) &&
+            (nMatches == other.nMatches) &&
+            (nRunningMatches == other.nRunningMatches) &&
+            (nFinishedMatches == other.nFinishedMatches));
+  }
+
+  //----------------------------------------------------------------------------
+
+  CatRoundStatusCache::CatRoundStatusCache(TournamentDB* _db)
+    :QObject(), db(_db), isBypassed{false}
+  {
+    if (!(db->needsChangeNotifications())) return;
+
+    CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+
+    // incremental updates
+    connect(cse, SIGNAL(matchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onMatchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+    connect(cse, SIGNAL(matchGroupStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onMatchGroupStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+
+    // events that we can't map to a single category
+    connect(cse, SIGNAL(endCreateMatch(int)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endCreateMatchGroup(int)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(categoryRemovedFromTournament(int,int)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Returns the round counters of a category and loads them
+   * from the database if they are not yet cached.
+   *
+   * The counters are returned by value because any signal that is
+   * emitted while the caller still works with them may invalidate
+   * and thus erase the cache entry.
+   *
+   * @param cat the category to get the counters for
+   *
+   * @return a copy of the round counters of the category
+   */
+  CatRoundCounters CatRoundStatusCache::getCounters(const Category& cat)
+  {
+    int catId = cat.getId();
+
+    // in bypass mode, we're called from a worker thread while the
+    // GUI thread may still look at the cache. So we must not touch any
+    // of the cached data and query the counters directly instead
+    if (isBypassed)
+    {
+      unordered_map<int, tuple<int, int>> dummyMatchMap;
+      unordered_map<int, tuple<int, int>> dummyGroupMap;
+      return queryCounters(catId, dummyMatchMap, dummyGroupMap);
+    }
+
+    auto it = catId2Counters.find(catId);
+    if (it == catId2Counters.end())
+    {
+      loadCountersForCategory(catId);
+      return catId2Counters[catId];
+    }
+
+#if defined(QT_DEBUG) && !defined(NDEBUG)
+    // in debug builds, make sure that the incremental
+    // updates did not drift away from the database contents
+    assert(it->second == recalcCountersFromScratch(cat));
+#endif
+
+    return it->second;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Determines the round counters of a category the "old-fashioned", slow
+   * way by walking through all match groups and matches of the category.
+   *
+   * This is used by the consistency checks (in debug builds and
+   * in the unit tests) and does not modify the cache.
+   *
+   * @param cat the category to calculate the counters for
+   *
+   * @return the freshly calculated counters
+   */
+  CatRoundCounters CatRoundStatusCache::recalcCountersFromScratch(const Category& cat) const
+  {
+    CatRoundCounters result;
+
+    MatchMngr mm{db};
+    for (const MatchGroup& mg : mm.getMatchGroupsForCat(cat))
+    {
+      RoundCounters& rc = result[mg.getRound()];
+      ++rc.nGroups;
+      if (mg.getState() == STAT_MG_FINISHED) ++rc.nFinishedGroups;
+
+      for (const Match& ma : mg.getMatches())
+      {
+        ++rc.nMatches;
+        OBJ_STATE stat = ma.getState();
+        if (stat == STAT_MA_RUNNING) ++rc.nRunningMatches;
+        if (stat == STAT_MA_FINISHED) ++rc.nFinishedMatches;
+      }
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  bool CatRoundStatusCache::isConsistent(const Category& cat)
+  {
+    auto it = catId2Counters.find(cat.getId());
+    if (it == catId2Counters.end()) return true;  // nothing cached, nothing inconsistent
+
+    return (it->second == recalcCountersFromScratch(cat));
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatRoundStatusCache::invalidateCategory(int catId)
+  {
+    catId2Counters.erase(catId);
+
+    for (auto it = matchId2CatRound.begin(); it != matchId2CatRound.end(); )
+    {
+      if (get<0>(it->second) == catId)
+      {
+        it = matchId2CatRound.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    for (auto it = groupId2CatRound.begin(); it != groupId2CatRound.end(); )
+    {
+      if (get<0>(it->second) == catId)
+      {
+        it = groupId2CatRound.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatRoundStatusCache::invalidateAll()
+  {
+    catId2Counters.clear();
+    matchId2CatRound.clear();
+    groupId2CatRound.clear();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Enables or disables the bypass mode. In bypass mode, the counters
+   * are freshly loaded from the database upon each access and the
+   * cached data is left untouched.
+   *
+   * Must only be called from the GUI thread.
+   *
+   * @param _isBypassed true for bypassing the cache, false for normal operation
+   */
+  void CatRoundStatusCache::setBypass(bool _isBypassed)
+  {
+    isBypassed = _isBypassed;
+    invalidateAll();
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatRoundStatusCache::onMatchStatusChanged(int matchId, int, OBJ_STATE fromState, OBJ_STATE toState)
+  {
+    // faked state changes are only used to trigger UI updates
+    if (fromState == toState) return;
+
+    // ignore matches in categories that are not cached (yet)
+    auto it = matchId2CatRound.find(matchId);
+    if (it == matchId2CatRound.end()) return;
+
+    int catId;
+    int round;
+    tie(catId, round) = it->second;
+    RoundCounters& rc = catId2Counters[catId][round];
+
+    if (fromState == STAT_MA_RUNNING) --rc.nRunningMatches;
+    if (fromState == STAT_MA_FINISHED) --rc.nFinishedMatches;
+    if (toState == STAT_MA_RUNNING) ++rc.nRunningMatches;
+    if (toState == STAT_MA_FINISHED) ++rc.nFinishedMatches;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatRoundStatusCache::onMatchGroupStatusChanged(int matchGroupId, int, OBJ_STATE fromState, OBJ_STATE toState)
+  {
+    if (fromState == toState) return;
+
+    auto it = groupId2CatRound.find(matchGroupId);
+    if (it == groupId2CatRound.end()) return;
+
+    int catId;
+    int round;
+    tie(catId, round) = it->second;
+    RoundCounters& rc = catId2Counters[catId][round];
+
+    if (fromState == STAT_MG_FINISHED) --rc.nFinishedGroups;
+    if (toState == STAT_MG_FINISHED) ++rc.nFinishedGroups;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatRoundStatusCache::onObjectsCreatedOrDeleted()
+  {
+    invalidateAll();
+  }
+
+  //----------------------------------------------------------------------------
+
+  void CatRoundStatusCache::loadCountersForCategory(int catId)
+  {
+    invalidateCategory(catId);
+    catId2Counters[catId] = queryCounters(catId, matchId2CatRound, groupId2CatRound);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Reads the round counters of a category from the database.
+   *
+   * @param catId the ID of the category to read the counters for
+   * @param matchMap receives the (catId, round) entries for all matches of the category
+   * @param groupMap receives the (catId, round) entries for all match groups of the category
+   *
+   * @return the counters of the category
+   */
+  CatRoundCounters CatRoundStatusCache::queryCounters(int catId, unordered_map<int, tuple<int, int>>& matchMap,
+                                                      unordered_map<int, tuple<int, int>>& groupMap) const
+  {
+    // fetch all groups and their matches with one single query.
+    //
+    // the LEFT JOIN makes sure that we also see empty match groups;
+    // for those, the match ID will be -1
+    QString sql = "SELECT mg.id, mg.%1, mg.%2, COALESCE(ma.id, -1), COALESCE(ma.%2, -1) "
+                  "FROM %3 mg LEFT JOIN %4 ma ON ma.%5 = mg.id WHERE mg.%6 = %7";
+    sql = sql.arg(MG_ROUND).arg(GENERIC_STATE_FIELD_NAME);
+    sql = sql.arg(TAB_MATCH_GROUP).arg(TAB_MATCH);
+    sql = sql.arg(MA_GRP_REF).arg(MG_CAT_REF).arg(catId);
+
+    CatRoundCounters crc;
+
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if (stmt == nullptr) return crc;  // shouldn't happen; we'll end up with empty counters
+
+    while (stmt->hasData())
+    {
+      int mgId;
+      int round;
+      int mgStateId;
+      int maId;
+      int maStateId;
+      stmt->getInt(0, &mgId);
+      stmt->getInt(1, &round);
+      stmt->getInt(2, &mgStateId);
+      stmt->getInt(3, &maId);
+      stmt->getInt(4, &maStateId);
+
+      RoundCounters& rc = crc[round];
+
+      // count each group only once, even if it
+      // shows up with multiple matches
+      if (groupMap.find(mgId) == groupMap.end())
+      {
+        groupMap[mgId] = make_tuple(catId, round);
+        ++rc.nGroups;
+        if (static_cast<OBJ_STATE>(mgStateId) == STAT_MG_FINISHED) ++rc.nFinishedGroups;
+      }
+
+      if (maId > 0)
+      {
+        matchMap[maId] = make_tuple(catId, round);
+        ++rc.nMatches;
+        OBJ_STATE maStat = static_cast<OBJ_STATE>(maStateId);
+        if (maStat == STAT_MA_RUNNING) ++rc.nRunningMatches;
+        if (maStat == STAT_MA_FINISHED) ++rc.nFinishedMatches;
+      }
+
+      stmt->step();
+    }
+
+    return crc;
+  }
+
+}
@@ -0,0 +1,123 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CATROUNDSTATUSCACHE_H
+#define CATROUNDSTATUSCACHE_H
+
+#include <map>
+#include <unordered_map>
+#include <tuple>
+
+#include <QObject>
+
+#include "TournamentDataDefs.h"
+
+using namespace std;
+
+namespace QTournament
+{
+  // forward
+  class TournamentDB;
+  class Category;
+
+  //----------------------------------------------------------------------------
+
+  // match and match group counters for a single round of a category
+  struct RoundCounters
+  {
+    int nGroups;
+    int nFinishedGroups;
+    int nMatches;
+    int nRunningMatches;
+    int nFinishedMatches;
+
+    RoundCounters()
+      :nGroups{0}, nFinishedGroups{0}, nMatches{0}, nRunningMatches{0}, nFinishedMatches{0} {}
+
+    bool operator== (const RoundCounters& other) const;
+    bool operator!= (const RoundCounters& other) const { return !(*this == other); }
+  };
+
+  // all round counters of a category, indexed by round number
+  using CatRoundCounters = map<int, RoundCounters>;
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Maintains per-category, per-round counters for matches and match groups
+   * so that CatRoundStatus doesn't have to walk through all rounds, groups
+   * and matches of a category for each query.
+   *
+   * The counters of a category are loaded with a single query on first
+   * access and are then kept up to date by listening to the status change
+   * signals of the CentralSignalEmitter. Events that we can't map to a
+   * category (e.g., the creation or bulk deletion of matches) or a transaction
+   * rollback simply invalidate the cache and trigger a fresh load
+   * upon the next access.
+   *
+   * While the signals of the CentralSignalEmitter are blocked (e.g., for
+   * bulk operations in a worker thread), the cache has to be bypassed
+   * because it doesn't see any status changes.
+   *
+   * There is one instance per tournament database and it is owned by the
+   * TournamentDB object.
+   */
+  class CatRoundStatusCache : public QObject
+  {
+    Q_OBJECT
+
+  public:
+    CatRoundStatusCache(TournamentDB* _db);
+
+    // access to the counters
+    CatRoundCounters getCounters(const Category& cat);
+
+    // consistency check against the database contents
+    CatRoundCounters recalcCountersFromScratch(const Category& cat) const;
+    bool isConsistent(const Category& cat);
+
+    // invalidation
+    void invalidateCategory(int catId);
+    void invalidateAll();
+    void setBypass(bool _isBypassed);
+
+  public slots:
+    void onMatchStatusChanged(int matchId, int matchSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onMatchGroupStatusChanged(int matchGroupId, int matchGroupSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onObjectsCreatedOrDeleted();
+
+  protected:
+    void loadCountersForCategory(int catId);
+    CatRoundCounters queryCounters(int catId, unordered_map<int, tuple<int, int>>& matchMap,
+                                   unordered_map<int, tuple<int, int>>& groupMap) const;
+
+  private:
+    TournamentDB* db;
+    bool isBypassed;
+
+    unordered_map<int, CatRoundCounters> catId2Counters;
+
+    // reverse lookups from match / match group IDs to (catId, round) for
+    // all matches and groups in categories that are currently cached
+    unordered_map<int, tuple<int, int>> matchId2CatRound;
+    unordered_map<int, tuple<int, int>> groupId2CatRound;
+  };
+
+}
+
+#endif // CATROUNDSTATUSCACHE_H
@@ -69,27 +69,21 @@ namespace QTournament
 
   MATCH_SYSTEM Category::getMatchSystem() const
   {
-    int sysInt = row.getInt(CAT_SYS);
-
-    return static_cast<MATCH_SYSTEM>(sysInt);
+    return getParameterSnapshot()->matchSystem;
   }
 
   //----------------------------------------------------------------------------
 
   MATCH_TYPE Category::getMatchType() const
   {
-    int typeInt = row.getInt(CAT_MATCH_TYPE);
-
-    return static_cast<MATCH_TYPE>(typeInt);
+    return getParameterSnapshot()->matchType;
   }
 
   //----------------------------------------------------------------------------
 
   SEX Category::getSex() const
   {
-    int sexInt = row.getInt(CAT_SEX);
-
-    return static_cast<SEX>(sexInt);
+    return getParameterSnapshot()->sex;
   }
 
   //----------------------------------------------------------------------------
@@ -228,22 +222,24 @@ namespace QTournament
 
   QVariant Category::getParameter(CAT_PARAMETER p) const
   {
+    spCatParameterSnapshot snap = getParameterSnapshot();
+
     switch (p) {
 
     case ALLOW_DRAW:
-      return row.getInt(CAT_ACCEPT_DRAW);
+      return static_cast<int>(snap->allowDraw);
 
     case WIN_SCORE:
-      return row.getInt(CAT_WIN_SCORE);
+      return snap->winScore;
 
     case DRAW_SCORE:
-      return row.getInt(CAT_DRAW_SCORE);
+      return snap->drawScore;
 
     case GROUP_CONFIG:
-      return QString::fromUtf8(row[CAT_GROUP_CONFIG].data());
+      return snap->groupConfigString;
 
     case ROUND_ROBIN_ITERATIONS:
-      return row.getInt(CAT_ROUND_ROBIN_ITERATIONS);
+      return snap->roundRobinIterations;
       /*
       case :
 	return row[];
@@ -290,6 +286,43 @@ namespace QTournament
 
   //----------------------------------------------------------------------------
 
+  /**
+   * Provides all configuration parameters of the category at once.
+   *
+   * The snapshot is cached and shared among all Category objects for
+   * the same category, so reading the snapshot's fields doesn't
+   * cause any database access and the group configuration is parsed
+   * only once.
+   *
+   * @return an immutable snapshot of the category's current parameters
+   */
+  spCatParameterSnapshot Category::getParameterSnapshot() const
+  {
+    return db->getCatParameterCache()->getSnapshot(getId());
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Provides the parsed group configuration of the category without
+   * parsing the config string again.
+   *
+   * Like the KO_Config constructor, this method throws std::invalid_argument
+   * if the stored config string can't be parsed.
+   *
+   * @return the group configuration of the category
+   */
+  KO_Config Category::getGroupConfig() const
+  {
+    spCatParameterSnapshot snap = getParameterSnapshot();
+    if (snap->hasValidGroupConfig) return snap->groupConfig;
+
+    // parse the invalid config string and let the parser report the error
+    return KO_Config(snap->groupConfigString);
+  }
+
+  //----------------------------------------------------------------------------
+
   /**
     Retrieves a list of PlayerPairs in this category. This method checks for
     both, PlayerPairs already created in the database and unpaired players
@@ -601,7 +634,7 @@ namespace QTournament
       return CATEGORY_NEEDS_NO_GROUP_ASSIGNMENTS;
     }
 
-    KO_Config cfg = KO_Config(getParameter(GROUP_CONFIG).toString());
+    KO_Config cfg = getGroupConfig();
     if (!(cfg.isValid())) return INVALID_KO_CONFIG;
 
     // check if the grpCfg matches the KO_Config
@@ -843,9 +876,10 @@ namespace QTournament
     // new set of matches. This is not very elegant (since it should
     // be solved in the BracketGenerator) but efficient...
     //
-    if (getMatchSystem() == GROUPS_WITH_KO)
+    spCatParameterSnapshot snap = getParameterSnapshot();
+    if (snap->matchSystem == GROUPS_WITH_KO)
     {
-      KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+      KO_Config cfg = getGroupConfig();
       if ((cfg.getStartLevel() == FINAL) && (cfg.getSecondSurvives()))
       {
         // we start with finals, which is simply "first vs. second"
@@ -1140,7 +1174,8 @@ namespace QTournament
 
     // in elimination categories, everything before "L16" is "Iteration"
     // and the rest follows the normal KO-logic
-    MATCH_SYSTEM mSys = getMatchSystem();
+    spCatParameterSnapshot snap = getParameterSnapshot();
+    MATCH_SYSTEM mSys = snap->matchSystem;
     if (mSys == SINGLE_ELIM)
     {
       switch(grpNum)
@@ -1158,8 +1193,7 @@ namespace QTournament
     // if we made it to this point, we are in KO rounds.
     // so we need the KO-config to decide if there is a previous
     // KO round or if we fall back to round robins
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
-    KO_START startLvl = cfg.getStartLevel();
+    KO_START startLvl = getGroupConfig().getStartLevel();
 
     if (startLvl == FINAL) return ANY_PLAYERS_GROUP_NUMBER;
 
@@ -1275,8 +1309,8 @@ namespace QTournament
   bool Category::isDrawAllowedInRound(int round) const
   {
     // is a draw basically allowed?
-    bool isDrawAllowed = getParameter_bool(ALLOW_DRAW);
-    if (!isDrawAllowed)
+    spCatParameterSnapshot snap = getParameterSnapshot();
+    if (!(snap->allowDraw))
     {
       return false;
     }
@@ -1290,7 +1324,7 @@ namespace QTournament
 
     // in any kind of "bracket match", draws are not possible.
     // So we need to have a "decision game", if necessary
-    MATCH_SYSTEM ms = getMatchSystem();
+    MATCH_SYSTEM ms = snap->matchSystem;
     if ((ms == RANKING) || (ms == SINGLE_ELIM))
     {
       return false;
@@ -1309,8 +1343,7 @@ namespace QTournament
       // invalid parameter
       if (round < 1) return false;
 
-      KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
-      if (round <= cfg.getNumRounds())
+      if (round <= getGroupConfig().getNumRounds())
       {
         // if draw is allowed and we're still in the round-robin phase,
         // a draw is possible
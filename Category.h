@@ -33,6 +33,7 @@
 #include "PlayerPair.h"
 #include "TournamentErrorCodes.h"
 #include "KO_Config.h"
+#include "CatParameterCache.h"
 #include "ThreadSafeQueue.h"
 
 namespace QTournament
@@ -73,6 +74,8 @@ namespace QTournament
     int getParameter_int(CAT_PARAMETER) const;
     bool getParameter_bool(CAT_PARAMETER) const;
     QString getParameter_string(CAT_PARAMETER) const;
+    spCatParameterSnapshot getParameterSnapshot() const;
+    KO_Config getGroupConfig() const;
     PlayerPairList getPlayerPairs(int grp = GRP_NUM__NOT_ASSIGNED) const;
     int getDatabasePlayerPairCount(int grp = GRP_NUM__NOT_ASSIGNED) const;
     PlayerList getAllPlayersInCategory() const;
@@ -16,20 +16,36 @@
  *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QThread>
+
 #include "CentralSignalEmitter.h"
 
 namespace QTournament
 {
 
   CentralSignalEmitter* CentralSignalEmitter::inst = nullptr;
+  CentralSignalEmitter* CentralSignalEmitter::workerInst = nullptr;
 
   //----------------------------------------------------------------------------
 
+  /**
+   * Returns the emitter for the calling thread.
+   *
+   * All listeners live in the main thread and are connected with direct
+   * connections. Thus, signals from a worker thread that modifies the
+   * database must not reach them; worker threads get a separate instance
+   * without any connections instead. The listeners are informed by
+   * a reset of all models after the worker has finished.
+   */
   CentralSignalEmitter*CentralSignalEmitter::getInstance()
   {
-    if (inst == nullptr) inst = new CentralSignalEmitter();
+    if (inst == nullptr)
+    {
+      inst = new CentralSignalEmitter();
+      workerInst = new CentralSignalEmitter();
+    }
 
-    return inst;
+    return (QThread::currentThread() == inst->thread()) ? inst : workerInst;
   }
 
   //----------------------------------------------------------------------------
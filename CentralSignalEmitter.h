@@ -49,6 +49,7 @@ namespace QTournament
     void beginResetAllModels() const;
     void endResetAllModels() const;
     void categoryRemovedFromTournament(int invalidCatId, int invalidCatSeqNum);
+    void categoryRenamed(const Category& c);
 
     // Signals emitted by the CourtMngr
     void beginCreateCourt ();
@@ -66,6 +67,7 @@ namespace QTournament
     void matchStatusChanged(int matchId, int matchSeqNum, OBJ_STATE fromState, OBJ_STATE toState) const;
     void matchGroupStatusChanged(int matchGroupId, int matchGroupSeqNum, OBJ_STATE fromState, OBJ_STATE toState) const;
     void matchResultUpdated(int matchId, int matchSeqNum) const;
+    void matchPlayersChanged(int matchId, int matchSeqNum) const;
     void roundCompleted(int catId, int round) const;
 
     // Signals emitted by the PlayerMngr
@@ -73,6 +75,7 @@ namespace QTournament
     void endCreatePlayer (int newPlayerSeqNum);
     void playerRenamed (const Player& p);
     void playerStatusChanged(int playerId, int playerSeqNum, OBJ_STATE fromState, OBJ_STATE toState) const;
+    void playerRefereeCountChanged(int playerId, int playerSeqNum) const;
     void beginDeletePlayer(int playerSeqNum) const;
     void endDeletePlayer() const;
     void externalPlayerDatabaseChanged();
@@ -86,11 +89,17 @@ namespace QTournament
     // Signals emitted by the MatchTimePredictor
     void matchTimePredictionChanged(int newAvgMatchDuration, time_t finishOfLastScheduledMatch__UTC);
 
+    // Signals emitted around database modifications in a worker thread;
+    // timers that access the database have to be stopped in between
+    void beginBackgroundDbOperation() const;
+    void endBackgroundDbOperation() const;
+
   public slots:
 
   private:
     explicit CentralSignalEmitter(QObject *parent = 0);
     static CentralSignalEmitter* inst;
+    static CentralSignalEmitter* workerInst;
   };
 
 }
@@ -300,10 +300,11 @@ namespace QTournament
     cse->beginDeleteCourt(oldSeqNum);
     int dbErr;
     tab->deleteRowsByColumnValue("id", co.getId(), &dbErr);
-    fixSeqNumberAfterDelete(tab, oldSeqNum);
+    bool isOkay = (dbErr == SQLITE_DONE);
+    if (isOkay) isOkay = fixSeqNumberAfterDelete(tab, oldSeqNum);
     cse->endDeleteCourt();
 
-    return (dbErr == SQLITE_DONE) ? OK : DATABASE_ERROR;
+    return isOkay ? OK : DATABASE_ERROR;
   }
 
   //----------------------------------------------------------------------------
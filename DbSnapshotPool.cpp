@@ -0,0 +1,172 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mutex>
+
+#include "DbSnapshotPool.h"
+#include "TournamentDB.h"
+
+namespace QTournament
+{
+  // the idle snapshots of a pool; shared with all leases so that
+  // leases may safely outlive their pool
+  struct DbSnapshotPoolState
+  {
+    std::mutex mtx;
+    size_t maxIdle;
+    vector<pair<unique_ptr<TournamentDB>, int>> idleSnapshots;   // snapshot and change count
+  };
+
+  //----------------------------------------------------------------------------
+
+  DbSnapshotLease::DbSnapshotLease(unique_ptr<TournamentDB> _snap, int _changeCount, const shared_ptr<DbSnapshotPoolState>& _pool)
+    :snap{std::move(_snap)}, changeCount{_changeCount}, pool{_pool}
+  {
+  }
+
+  //----------------------------------------------------------------------------
+
+  DbSnapshotLease& DbSnapshotLease::operator=(DbSnapshotLease&& other)
+  {
+    if (this != &other)
+    {
+      release();
+      snap = std::move(other.snap);
+      changeCount = other.changeCount;
+      pool = std::move(other.pool);
+    }
+
+    return *this;
+  }
+
+  //----------------------------------------------------------------------------
+
+  DbSnapshotLease::~DbSnapshotLease()
+  {
+    release();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Hands the snapshot back to its pool; the lease is
+   * invalid afterwards. Can be called from any thread.
+   */
+  void DbSnapshotLease::release()
+  {
+    if (snap == nullptr) return;
+
+    // if the pool is gone or if it has enough idle
+    // snapshots, the snapshot is simply deleted
+    auto st = pool.lock();
+    if (st != nullptr)
+    {
+      std::lock_guard<std::mutex> lock{st->mtx};
+      if (st->idleSnapshots.size() < st->maxIdle)
+      {
+        st->idleSnapshots.push_back(make_pair(std::move(snap), changeCount));
+      }
+    }
+
+    snap.reset();
+    pool.reset();
+  }
+
+  //----------------------------------------------------------------------------
+
+  DbSnapshotPool::DbSnapshotPool(TournamentDB* _db, size_t maxIdleSnapshots)
+    :db{_db}, state{make_shared<DbSnapshotPoolState>()}
+  {
+    state->maxIdle = maxIdleSnapshots;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Provides a snapshot of the current state of the tournament.
+   *
+   * The snapshot is taken immediately, so this function has to be called
+   * from the main thread. There must be no running transaction because
+   * uncommitted changes can't be copied.
+   *
+   * @param err optional pointer to an error code
+   *
+   * @return a lease for the snapshot; the lease is invalid in case of errors
+   */
+  DbSnapshotLease DbSnapshotPool::acquire(ERR* err)
+  {
+    int curChangeCount = db->getTotalChangeCount();
+
+    // prefer an idle snapshot that is still up to date
+    unique_ptr<TournamentDB> snap;
+    int snapChangeCount = -1;
+    {
+      std::lock_guard<std::mutex> lock{state->mtx};
+      auto& idle = state->idleSnapshots;
+      if (!(idle.empty()))
+      {
+        auto it = idle.begin();
+        while ((it != idle.end()) && (it->second != curChangeCount)) ++it;
+        if (it == idle.end()) it = idle.begin();
+
+        snap = std::move(it->first);
+        snapChangeCount = it->second;
+        idle.erase(it);
+      }
+    }
+
+    if ((snap != nullptr) && (snapChangeCount != curChangeCount))
+    {
+      if (!(db->refreshReadSnapshot(snap.get()))) snap.reset();
+    }
+
+    if (snap == nullptr)
+    {
+      ERR e;
+      snap = db->createReadSnapshot(&e);
+      if (snap == nullptr)
+      {
+        if (err != nullptr) *err = e;
+        return DbSnapshotLease{};
+      }
+    }
+
+    if (err != nullptr) *err = OK;
+    return DbSnapshotLease{std::move(snap), curChangeCount, state};
+  }
+
+  //----------------------------------------------------------------------------
+
+  size_t DbSnapshotPool::getIdleCount() const
+  {
+    std::lock_guard<std::mutex> lock{state->mtx};
+    return state->idleSnapshots.size();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Deletes all idle snapshots, e.g. for freeing memory.
+   */
+  void DbSnapshotPool::clear()
+  {
+    std::lock_guard<std::mutex> lock{state->mtx};
+    state->idleSnapshots.clear();
+  }
+
+}
@@ -0,0 +1,101 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBSNAPSHOTPOOL_H
+#define DBSNAPSHOTPOOL_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "TournamentErrorCodes.h"
+
+using namespace std;
+
+namespace QTournament
+{
+  class TournamentDB;
+  struct DbSnapshotPoolState;
+
+  /**
+   * Exclusive access to a read-only snapshot of the tournament database.
+   *
+   * A lease can be moved to a worker thread. When the lease is
+   * destroyed, the snapshot is handed back to its pool for re-use.
+   */
+  class DbSnapshotLease
+  {
+    friend class DbSnapshotPool;
+
+  public:
+    DbSnapshotLease() = default;
+    DbSnapshotLease(DbSnapshotLease&& other) = default;
+    DbSnapshotLease& operator=(DbSnapshotLease&& other);
+    ~DbSnapshotLease();
+
+    TournamentDB* get() const { return snap.get(); }
+    TournamentDB* operator->() const { return snap.get(); }
+    bool isValid() const { return (snap != nullptr); }
+
+    void release();
+
+  protected:
+    DbSnapshotLease(unique_ptr<TournamentDB> _snap, int _changeCount, const shared_ptr<DbSnapshotPoolState>& _pool);
+
+  private:
+    unique_ptr<TournamentDB> snap;
+    int changeCount = -1;   // the change counter of the main database at the time of the snapshot
+    weak_ptr<DbSnapshotPoolState> pool;
+  };
+
+  /**
+   * Provides read-only snapshots of the tournament database for background
+   * tasks like report rendering, match time prediction or sync serialization.
+   *
+   * Each snapshot is a private in-memory copy of the tournament at the time
+   * of the acquire() call. A task can read from its snapshot without any
+   * locking while the main thread continues to modify the tournament and it
+   * always sees a consistent state of the tournament.
+   *
+   * Released snapshots are kept for re-use; if the tournament has changed
+   * in the meantime, they are updated before they are handed out again.
+   *
+   * There is one instance per tournament database and it is owned by the
+   * TournamentDB object.
+   */
+  class DbSnapshotPool
+  {
+  public:
+    static constexpr size_t DefaultMaxIdleSnapshots = 2;
+
+    DbSnapshotPool(TournamentDB* _db, size_t maxIdleSnapshots = DefaultMaxIdleSnapshots);
+
+    // only to be called from the main thread
+    DbSnapshotLease acquire(ERR* err = nullptr);
+
+    size_t getIdleCount() const;
+    void clear();
+
+  private:
+    TournamentDB* db;
+    shared_ptr<DbSnapshotPoolState> state;
+  };
+
+}
+
+#endif // DBSNAPSHOTPOOL_H
@@ -27,12 +27,14 @@
 #include <SqliteOverlay/KeyValueTab.h>
 #include <SqliteOverlay/TableCreator.h>
 #include <SqliteOverlay/ClausesAndQueries.h>
+#include <SqliteOverlay/Transaction.h>
 
 #include "HelperFunc.h"
 #include "TournamentDataDefs.h"
 
 namespace QTournament
 {
+  constexpr int ExternalPlayerDB::BulkImportChunkSize;
 
   upExternalPlayerDatabaseEntry ExternalPlayerDB::row2upEntry(const SqliteOverlay::TabRow& r) const
   {
@@ -65,6 +67,7 @@ namespace QTournament
     cfg->set(CFG_KEY_EPD_DB_VERSION, EXT_PLAYER_DB_VERSION);
 
     result->setLogLevel(Sloppy::Logger::SeverityLevel::error);
+    result->loadNameIndex();
 
     return result;
   }
@@ -86,6 +89,7 @@ namespace QTournament
     }
 
     result->setLogLevel(Sloppy::Logger::SeverityLevel::error);
+    result->loadNameIndex();
 
     return result;
   }
@@ -115,31 +119,14 @@ namespace QTournament
 
   ExternalPlayerDatabaseEntryList ExternalPlayerDB::searchForMatchingPlayers(const QString& substring)
   {
-    // we need at least three characters for searching
-    QString s = substring.trimmed();
-    if (s.length() < 3) return ExternalPlayerDatabaseEntryList();
-
-    // create a WHERE clause that matches any name with the substring in it
-    string _s = QString2StdString(s);
-    string where = EPD_PL_FNAME + " LIKE '%" + _s + "%' or ";
-    where += EPD_PL_LNAME + " LIKE '%" + _s + "%'";
-    where += "ORDER BY " + EPD_PL_LNAME + " ASC, " + EPD_PL_FNAME + " ASC";
-
-    // search for names matching this pattern
-    SqliteOverlay::DbTab* playerTab = getTab(TAB_EPD_PLAYER);
-    auto it = playerTab->getRowsByWhereClause(where);
+    // the name index requires at least three characters for searching
+    // and returns the matches already ranked and sorted
     ExternalPlayerDatabaseEntryList result;
-    while (!(it.isEnd()))
+    for (const ExternalPlayerNameIndex::IndexEntry* e : nameIndex.search(substring))
     {
-      auto tmp = row2upEntry(*it);
-
-      result.push_back(*tmp);   // the QList creates a copy internally
-
-      ++it;
+      result.push_back(ExternalPlayerDatabaseEntry{e->id, e->fName, e->lName, e->sex});
+    }
 
-      // the object behind tmp is automatically deleted
-      // when we leave this scope.
-     }
     return result;
   }
 
@@ -224,7 +211,13 @@ namespace QTournament
     int newId = playerTab->insertRow(cvc);
     assert(newId > 0);
 
-    return getPlayer(newId);
+    auto result = getPlayer(newId);
+    if (result != nullptr)
+    {
+      nameIndex.addPlayer(newId, result->getFirstname(), result->getLastname(), result->getSex());
+    }
+
+    return result;
   }
 
   //----------------------------------------------------------------------------
@@ -253,23 +246,127 @@ namespace QTournament
     // update the player entry
     auto playerTab = getTab(TAB_EPD_PLAYER);
     playerTab->operator [](extPlayerId).update(EPD_PL_SEX, static_cast<int>(newSex));
+    nameIndex.updateSex(extPlayerId, newSex);
 
     return true;
   }
 
   //----------------------------------------------------------------------------
 
-  tuple<QList<int>, QList<int>, QHash<int,QString>, int> ExternalPlayerDB::bulkImportCSV(const QString& csv)
+  /**
+   * Imports a list of players in CSV format into the database.
+   *
+   * Each line has the format "lastName, firstName[, sex[, teamName]]".
+   * Names that already exist in the database (or earlier in the same CSV)
+   * are skipped but their team names are still returned.
+   *
+   * The names of all existing players are loaded once into a hash set
+   * and the new players are inserted in chunks of BulkImportChunkSize
+   * rows per transaction.
+   *
+   * If a chunk can't be committed, all players of this chunk are counted
+   * as errors. If the user cancels the import via the progress queue,
+   * the current chunk is rolled back and all previously committed
+   * chunks are returned as the result.
+   *
+   * \param csv the CSV data
+   * \param progressNotificationQueue is an optional pointer to a FIFO that communicates progress back to the GUI
+   *
+   * \return a tuple of (IDs of new players, IDs of skipped players, map of player ID to team name, number of erroneous lines)
+   */
+  tuple<QList<int>, QList<int>, QHash<int,QString>, int> ExternalPlayerDB::bulkImportCSV(const QString& csv, ProgressQueue* progressNotificationQueue)
   {
     int errorCnt = 0;
     QList<int> newExtPlayerIds;
     QList<int> skippedPlayerIds;
     QHash<int,QString> extPlayerId2TeamName;
 
-    for (QString line : csv.split("\n"))
+    // load all existing names at once
+    auto nameKey = [](const QString& fName, const QString& lName) {
+      return fName + QChar('\t') + lName;
+    };
+    QHash<QString, int> name2Id;
+    for (const ExternalPlayerDatabaseEntry& e : getAllPlayers())
+    {
+      name2Id[nameKey(e.getFirstname(), e.getLastname())] = e.getId();
+    }
+
+    if (progressNotificationQueue != nullptr)
     {
+      progressNotificationQueue->reset(csv.count('\n') + 1);
+    }
+
+    SqliteOverlay::DbTab* playerTab = getTab(TAB_EPD_PLAYER);
+    unique_ptr<SqliteOverlay::Transaction> trans;
+    QList<int> idsInCurrentChunk;
+    QStringList keysInCurrentChunk;
+
+    // a helper that rolls back the current chunk and removes
+    // its players from the results and from the name hash
+    auto discardChunk = [&](bool countAsErrors) {
+      if (trans == nullptr) return;
+
+      trans->rollback();
+      for (int id : idsInCurrentChunk)
+      {
+        newExtPlayerIds.removeAll(id);
+        skippedPlayerIds.removeAll(id);
+        extPlayerId2TeamName.remove(id);
+        if (countAsErrors) ++errorCnt;
+      }
+      for (const QString& key : keysInCurrentChunk)
+      {
+        name2Id.remove(key);
+      }
+
+      // the name index contains players that don't exist anymore
+      loadNameIndex();
+
+      trans.reset();
+      idsInCurrentChunk.clear();
+      keysInCurrentChunk.clear();
+    };
+
+    // a helper that commits the current chunk; if the commit fails, all
+    // players in the chunk are counted as errors and removed from the results
+    auto commitChunk = [&]() {
+      if (trans == nullptr) return;
+
+      if (!(trans->commit()))
+      {
+        discardChunk(true);
+        return;
+      }
+
+      trans.reset();
+      idsInCurrentChunk.clear();
+      keysInCurrentChunk.clear();
+    };
+
+    // parse the CSV line by line without splitting it into a list first
+    bool isCanceled = false;
+    int lineStart = 0;
+    while (lineStart < csv.length())
+    {
+      int lineEnd = csv.indexOf('\n', lineStart);
+      if (lineEnd < 0) lineEnd = csv.length();
+      QString line = csv.mid(lineStart, lineEnd - lineStart).trimmed();
+      lineStart = lineEnd + 1;
+
+      if (progressNotificationQueue != nullptr)
+      {
+        try
+        {
+          progressNotificationQueue->step();
+        }
+        catch (OperationCanceledException&)
+        {
+          isCanceled = true;
+          break;
+        }
+      }
+
       // ignore empty lines
-      line = line.trimmed();
       if (line.isEmpty()) continue;
 
       // ignore lines with less than to fields
@@ -312,23 +409,62 @@ namespace QTournament
       }
 
       // check if the player name already exists
-      auto existingPlayer = getPlayer(fName, lName);
-      if (existingPlayer != nullptr)
+      QString key = nameKey(fName, lName);
+      auto it = name2Id.constFind(key);
+      if (it != name2Id.constEnd())
       {
-        int existingId = existingPlayer->getId();
+        int existingId = it.value();
         skippedPlayerIds.push_back(existingId);
         extPlayerId2TeamName[existingId] = teamName;
         continue;
       }
 
+      // start a new chunk, if necessary
+      if (trans == nullptr)
+      {
+        trans = startTransaction();
+        if (trans == nullptr)
+        {
+          ++errorCnt;
+          continue;
+        }
+      }
+
       // actually create the new entry
-      ExternalPlayerDatabaseEntry entry{fName, lName, sex};
-      auto newPlayer = storeNewPlayer(entry);
-      if (newPlayer == nullptr) ++errorCnt;
+      SqliteOverlay::ColumnValueClause cvc;
+      cvc.addStringCol(EPD_PL_FNAME, QString2StdString(fName));
+      cvc.addStringCol(EPD_PL_LNAME, QString2StdString(lName));
+      if (sex != DONT_CARE)
+      {
+        cvc.addIntCol(EPD_PL_SEX, static_cast<int>(sex));
+      }
+      int newExtPlayerId = playerTab->insertRow(cvc);
+      if (newExtPlayerId < 1)
+      {
+        ++errorCnt;
+        continue;
+      }
 
-      int newExtPlayerId = newPlayer->getId();
+      name2Id[key] = newExtPlayerId;
+      nameIndex.addPlayer(newExtPlayerId, fName, lName, sex);
       newExtPlayerIds.push_back(newExtPlayerId);
       extPlayerId2TeamName[newExtPlayerId] = teamName;
+      idsInCurrentChunk.push_back(newExtPlayerId);
+      keysInCurrentChunk.push_back(key);
+
+      if (idsInCurrentChunk.size() >= BulkImportChunkSize) commitChunk();
+    }
+
+    if (isCanceled)
+    {
+      discardChunk(false);
+    } else {
+      commitChunk();
+    }
+
+    if (progressNotificationQueue != nullptr)
+    {
+      progressNotificationQueue->push(-1);
     }
 
     return make_tuple(newExtPlayerIds, skippedPlayerIds, extPlayerId2TeamName, errorCnt);
@@ -336,6 +472,34 @@ namespace QTournament
 
   //----------------------------------------------------------------------------
 
+  void ExternalPlayerDB::loadNameIndex()
+  {
+    nameIndex.clear();
+
+    string sql = "SELECT id, " + EPD_PL_FNAME + ", " + EPD_PL_LNAME + ", COALESCE(" + EPD_PL_SEX + ", -1) FROM " + TAB_EPD_PLAYER;
+    auto stmt = execContentQuery(sql);
+    if (stmt == nullptr) return;
+
+    while (stmt->hasData())
+    {
+      int id;
+      string fName;
+      string lName;
+      int sexValue;
+      stmt->getInt(0, &id);
+      stmt->getString(1, &fName);
+      stmt->getString(2, &lName);
+      stmt->getInt(3, &sexValue);
+
+      SEX sex = (sexValue < 0) ? DONT_CARE : static_cast<SEX>(sexValue);
+      nameIndex.addPlayer(id, stdString2QString(fName), stdString2QString(lName), sex);
+
+      stmt->step();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
 
   //----------------------------------------------------------------------------
 
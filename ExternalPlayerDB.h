@@ -30,6 +30,8 @@
 #include <SqliteOverlay/TabRow.h>
 
 #include "TournamentDataDefs.h"
+#include "ExternalPlayerNameIndex.h"
+#include "ThreadSafeQueue.h"
 
 namespace QTournament
 {
@@ -84,11 +86,17 @@ namespace QTournament
     upExternalPlayerDatabaseEntry storeNewPlayer(const ExternalPlayerDatabaseEntry& newPlayer);
     bool hasPlayer(const QString& fname, const QString& lname);
     bool updatePlayerSexIfUndefined(int extPlayerId, SEX newSex);
-    tuple<QList<int>, QList<int>, QHash<int, QString>, int> bulkImportCSV(const QString& csv);
+    tuple<QList<int>, QList<int>, QHash<int, QString>, int> bulkImportCSV(const QString& csv, ProgressQueue* progressNotificationQueue=nullptr);
+
+    // number of inserts that are bundled in one transaction during bulk imports
+    static constexpr int BulkImportChunkSize = 1000;
 
   private:
     upExternalPlayerDatabaseEntry row2upEntry(const SqliteOverlay::TabRow& r) const;
     ExternalPlayerDB(const string& fname, bool createNew);
+    void loadNameIndex();
+
+    ExternalPlayerNameIndex nameIndex;
   };
   typedef unique_ptr<ExternalPlayerDB> upExternalPlayerDB;
 }
@@ -0,0 +1,153 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "ExternalPlayerNameIndex.h"
+
+namespace QTournament
+{
+  constexpr int ExternalPlayerNameIndex::MinSearchLength;
+
+  void ExternalPlayerNameIndex::clear()
+  {
+    entries.clear();
+    id2EntryIdx.clear();
+    trigram2EntryIdx.clear();
+  }
+
+  //----------------------------------------------------------------------------
+
+  void ExternalPlayerNameIndex::addPlayer(int id, const QString& fName, const QString& lName, SEX sex)
+  {
+    if (id2EntryIdx.contains(id)) return;
+
+    int entryIdx = static_cast<int>(entries.size());
+    entries.push_back(IndexEntry{id, fName, lName, sex, fName.toLower(), lName.toLower()});
+    id2EntryIdx[id] = entryIdx;
+
+    addTrigrams(entries.back().fNameLower, entryIdx);
+    addTrigrams(entries.back().lNameLower, entryIdx);
+  }
+
+  //----------------------------------------------------------------------------
+
+  void ExternalPlayerNameIndex::updateSex(int id, SEX newSex)
+  {
+    auto it = id2EntryIdx.constFind(id);
+    if (it == id2EntryIdx.constEnd()) return;
+
+    entries[it.value()].sex = newSex;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Searches for all players whose first or last name contains a given substring.
+   *
+   * The search is case insensitive. The results are ranked: exact last name
+   * matches first, then last name prefixes, then first name prefixes, then all
+   * other substring matches. Within each rank, the players are sorted by last
+   * name and first name.
+   *
+   * @param substring the search string; must have at least MinSearchLength characters
+   *
+   * @return a list of pointers to the matching entries; the pointers are valid until the next modification of the index
+   */
+  vector<const ExternalPlayerNameIndex::IndexEntry*> ExternalPlayerNameIndex::search(const QString& substring) const
+  {
+    vector<const IndexEntry*> result;
+
+    QString s = substring.trimmed().toLower();
+    if (s.length() < MinSearchLength) return result;
+
+    // find the trigram with the fewest candidates
+    const vector<int>* candidates = nullptr;
+    for (int i=0; i <= (s.length() - 3); ++i)
+    {
+      auto it = trigram2EntryIdx.constFind(s.mid(i, 3));
+      if (it == trigram2EntryIdx.constEnd()) return result;  // no name contains this trigram
+
+      if ((candidates == nullptr) || (it.value().size() < candidates->size()))
+      {
+        candidates = &(it.value());
+      }
+    }
+    if (candidates == nullptr) return result;
+
+    // verify the candidates and assign a rank to them
+    vector<pair<int, const IndexEntry*>> ranked;
+    for (int entryIdx : *candidates)
+    {
+      const IndexEntry& e = entries[entryIdx];
+
+      int rank;
+      if (e.lNameLower == s) rank = 0;
+      else if (e.lNameLower.startsWith(s)) rank = 1;
+      else if (e.fNameLower.startsWith(s)) rank = 2;
+      else if (e.lNameLower.contains(s) || e.fNameLower.contains(s)) rank = 3;
+      else continue;
+
+      ranked.push_back(make_pair(rank, &e));
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [](const pair<int, const IndexEntry*>& r1, const pair<int, const IndexEntry*>& r2)
+    {
+      if (r1.first != r2.first) return (r1.first < r2.first);
+
+      int cmp = QString::compare(r1.second->lName, r2.second->lName);
+      if (cmp != 0) return (cmp < 0);
+      cmp = QString::compare(r1.second->fName, r2.second->fName);
+      if (cmp != 0) return (cmp < 0);
+
+      return (r1.second->id < r2.second->id);
+    });
+
+    result.reserve(ranked.size());
+    for (const auto& r : ranked)
+    {
+      result.push_back(r.second);
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void ExternalPlayerNameIndex::addTrigrams(const QString& lowerName, int entryIdx)
+  {
+    for (int i=0; i <= (lowerName.length() - 3); ++i)
+    {
+      vector<int>& lst = trigram2EntryIdx[lowerName.mid(i, 3)];
+
+      // a name may contain the same trigram more than once and
+      // first and last name may share trigrams; since entries
+      // are only appended, checking the last element is sufficient
+      if (lst.empty() || (lst.back() != entryIdx))
+      {
+        lst.push_back(entryIdx);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+
+  //----------------------------------------------------------------------------
+
+}
@@ -0,0 +1,75 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXTERNALPLAYERNAMEINDEX_H
+#define EXTERNALPLAYERNAMEINDEX_H
+
+#include <vector>
+
+#include <QHash>
+#include <QString>
+
+#include "TournamentDataDefs.h"
+
+using namespace std;
+
+namespace QTournament
+{
+
+  /**
+   * An in-memory trigram index over the names in the external player database.
+   *
+   * Every lower-case, three-character substring of a first or last name points
+   * to the list of players containing that substring. A search picks the shortest
+   * list for any trigram of the search string and only checks the players on that
+   * list. This avoids the full table scan of a "LIKE '%x%'" query.
+   */
+  class ExternalPlayerNameIndex
+  {
+  public:
+    struct IndexEntry
+    {
+      int id;
+      QString fName;
+      QString lName;
+      SEX sex;
+      QString fNameLower;
+      QString lNameLower;
+    };
+
+    static constexpr int MinSearchLength = 3;
+
+    void clear();
+    void addPlayer(int id, const QString& fName, const QString& lName, SEX sex);
+    void updateSex(int id, SEX newSex);
+
+    vector<const IndexEntry*> search(const QString& substring) const;
+
+    int size() const { return static_cast<int>(entries.size()); }
+
+  private:
+    vector<IndexEntry> entries;
+    QHash<int, int> id2EntryIdx;
+    QHash<QString, vector<int>> trigram2EntryIdx;
+
+    void addTrigrams(const QString& lowerName, int entryIdx);
+  };
+
+}
+
+#endif // EXTERNALPLAYERNAMEINDEX_H
@@ -0,0 +1,145 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QFile>
+
+#include "HotPathTracer.h"
+
+namespace QTournament
+{
+  constexpr size_t TraceRecorder::MaxEventCount;
+
+  //----------------------------------------------------------------------------
+
+  TraceRecorder* TraceRecorder::getInstance()
+  {
+    // the initialization of function-local statics is thread-safe,
+    // so the first TRACE_SCOPE may run in any thread
+    static TraceRecorder instance;
+
+    return &instance;
+  }
+
+  //----------------------------------------------------------------------------
+
+  TraceRecorder::TraceRecorder()
+    :isRecording{false}, droppedEvents{0}
+  {
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Starts a new tracing session; all events of a previous,
+   * unfinished session are discarded.
+   *
+   * @param _traceFileName the name of the trace file that is written by stop()
+   */
+  void TraceRecorder::start(const QString& _traceFileName)
+  {
+    std::lock_guard<std::mutex> lock{eventMutex};
+
+    traceFileName = _traceFileName;
+    events.clear();
+    threadNumbers.clear();
+    droppedEvents = 0;
+    sessionStart = Clock::now();
+    isRecording = true;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Ends the current tracing session and writes all events
+   * to the trace file.
+   *
+   * @return true if the trace file has been written successfully
+   */
+  bool TraceRecorder::stop()
+  {
+    std::lock_guard<std::mutex> lock{eventMutex};
+
+    // no more events after this point; concurrent calls
+    // to addEvent() are blocked by the mutex until we're done
+    if (!(isRecording.exchange(false))) return false;
+
+    QFile f{traceFileName};
+    if (!(f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)))
+    {
+      return false;
+    }
+
+    string json{"{\"traceEvents\":[\n"};
+    bool isFirst = true;
+    for (const TraceEvent& e : events)
+    {
+      if (!isFirst) json += ",\n";
+      isFirst = false;
+
+      // the event names are literals from our own code,
+      // so there is no need for escaping
+      json += "{\"name\":\"";
+      json += e.name;
+      json += "\",\"cat\":\"QTournament\",\"ph\":\"X\",\"pid\":1,\"tid\":" + to_string(e.threadNumber);
+      json += ",\"ts\":" + to_string(e.startUsecs);
+      json += ",\"dur\":" + to_string(e.durationUsecs) + "}";
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" + to_string(droppedEvents) + "}}\n";
+
+    bool isOkay = (f.write(json.c_str(), json.size()) == static_cast<qint64>(json.size()));
+    f.close();
+
+    events.clear();
+    events.shrink_to_fit();
+
+    return isOkay;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void TraceRecorder::addEvent(const char* name, Clock::time_point startTime, Clock::time_point endTime)
+  {
+    std::lock_guard<std::mutex> lock{eventMutex};
+    if (!isRecording) return;
+
+    if (events.size() >= MaxEventCount)
+    {
+      ++droppedEvents;
+      return;
+    }
+
+    long long startUsecs = std::chrono::duration_cast<std::chrono::microseconds>(startTime - sessionStart).count();
+    long long durationUsecs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+    events.push_back(TraceEvent{name, startUsecs, durationUsecs, getThreadNumber(std::this_thread::get_id())});
+  }
+
+  //----------------------------------------------------------------------------
+
+  // maps thread IDs to small numbers for a better readability
+  // of the trace; the caller must hold the event mutex
+  int TraceRecorder::getThreadNumber(std::thread::id tid)
+  {
+    auto it = threadNumbers.find(tid);
+    if (it != threadNumbers.end()) return it->second;
+
+    int n = static_cast<int>(threadNumbers.size()) + 1;
+    threadNumbers[tid] = n;
+    return n;
+  }
+
+}
@@ -0,0 +1,129 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HOTPATHTRACER_H
+#define HOTPATHTRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <QString>
+
+using namespace std;
+
+//
+// Scoped timers for the hot paths of the application.
+//
+// The timers are only compiled in if QTOURNAMENT_ENABLE_TRACING
+// is defined (qmake: "CONFIG+=tracing", cmake: "-DENABLE_TRACING=ON").
+// Otherwise TRACE_SCOPE expands to an empty statement
+// ("do {} while (false)") that the compiler optimizes away.
+//
+// Usage: put TRACE_SCOPE("SomeClass::someMethod"); at the beginning
+// of a function or block; the name must be a string literal.
+//
+#define QTOURNAMENT_TRACE_CONCAT2(a, b) a##b
+#define QTOURNAMENT_TRACE_CONCAT(a, b) QTOURNAMENT_TRACE_CONCAT2(a, b)
+
+#ifdef QTOURNAMENT_ENABLE_TRACING
+  #define TRACE_SCOPE(name) QTournament::ScopedTrace QTOURNAMENT_TRACE_CONCAT(scopedTrace_, __LINE__){name}
+#else
+  #define TRACE_SCOPE(name) do {} while (false)
+#endif
+
+namespace QTournament
+{
+  /**
+   * Collects the events of all scoped timers during a tracing
+   * session and writes them as a Chrome / Perfetto trace file
+   * (JSON, "complete" events) at the end of the session.
+   *
+   * Nested timers show up as nested slices in the trace viewer.
+   *
+   * The recorder can be used from any thread; all accesses to the
+   * event buffer are serialized by a mutex.
+   */
+  class TraceRecorder
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static TraceRecorder* getInstance();
+
+    void start(const QString& _traceFileName);
+    bool stop();
+    bool isActive() const { return isRecording; }
+
+    void addEvent(const char* name, Clock::time_point startTime, Clock::time_point endTime);
+
+    // upper limit for the number of events in a session
+    static constexpr size_t MaxEventCount = 2000000;
+
+  protected:
+    TraceRecorder();
+    int getThreadNumber(std::thread::id tid);
+
+  private:
+    struct TraceEvent
+    {
+      const char* name;
+      long long startUsecs;   // relative to the session start
+      long long durationUsecs;
+      int threadNumber;
+    };
+
+    std::atomic<bool> isRecording;
+    QString traceFileName;
+    Clock::time_point sessionStart;
+    std::mutex eventMutex;
+    vector<TraceEvent> events;
+    unordered_map<std::thread::id, int> threadNumbers;
+    size_t droppedEvents;
+  };
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Records the time between construction and destruction
+   * as a trace event; use TRACE_SCOPE() instead of using
+   * this class directly.
+   */
+  class ScopedTrace
+  {
+  public:
+    ScopedTrace(const char* _name)
+      :name{_name}, startTime{TraceRecorder::Clock::now()} {}
+
+    ~ScopedTrace()
+    {
+      TraceRecorder* tr = TraceRecorder::getInstance();
+      if (tr->isActive()) tr->addEvent(name, startTime, TraceRecorder::Clock::now());
+    }
+
+  private:
+    const char* name;
+    TraceRecorder::Clock::time_point startTime;
+  };
+
+}
+
+#endif // HOTPATHTRACER_H
@@ -0,0 +1,287 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCKFREEQUEUE_H
+#define LOCKFREEQUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The default wait strategy for blocking queue operations: spin for
+ * a few rounds, then yield the CPU for a few rounds and finally
+ * sleep for a short time between retries.
+ *
+ * Spinning keeps the latency low if the other side is just about to
+ * push or pop; sleeping keeps the CPU load low if the other side is
+ * idle for a longer time (e.g., a progress dialog waiting for a
+ * long running database operation).
+ */
+struct SpinYieldSleepWait
+{
+  int spinRounds = 64;
+  int yieldRounds = 64;
+  chrono::microseconds sleepTime{200};
+
+  /**
+   * Waits before the next retry.
+   *
+   * @param round the number of previous, unsuccessful retries
+   */
+  void operator()(int round) const
+  {
+    if (round < spinRounds) return;
+    if (round < (spinRounds + yieldRounds))
+    {
+      this_thread::yield();
+      return;
+    }
+    this_thread::sleep_for(sleepTime);
+  }
+};
+
+/**
+ * A bounded, lock-free multi-producer / multi-consumer queue
+ * based on a ring buffer with per-slot sequence numbers
+ * (D. Vyukov's bounded MPMC queue).
+ *
+ * All memory is allocated in the constructor; pushing and popping
+ * elements doesn't allocate and never takes a lock. Elements are moved
+ * in and out of the queue, so T has to be default constructible
+ * and move assignable.
+ *
+ * The "try"-functions return immediately; push() and blockingPop()
+ * retry until they succeed and use the WaitStrategy between retries.
+ */
+template <typename T, typename WaitStrategy = SpinYieldSleepWait>
+class BoundedLockFreeQueue
+{
+public:
+  /**
+   * @param minCapacity the minimum number of elements in the queue; the
+   * actual capacity is the next power of two
+   */
+  explicit BoundedLockFreeQueue(size_t minCapacity = 1024, WaitStrategy _waitStrategy = WaitStrategy{})
+    :waitStrategy{_waitStrategy}
+  {
+    size_t cap = 2;
+    while (cap < minCapacity) cap *= 2;
+    mask = cap - 1;
+
+    slots.reset(new Slot[cap]);
+    for (size_t i = 0; i < cap; ++i)
+    {
+      slots[i].seq.store(i, memory_order_relaxed);
+    }
+
+    enqueuePos.store(0, memory_order_relaxed);
+    dequeuePos.store(0, memory_order_relaxed);
+  }
+
+  BoundedLockFreeQueue(const BoundedLockFreeQueue&) = delete;
+  BoundedLockFreeQueue& operator=(const BoundedLockFreeQueue&) = delete;
+
+  /**
+   * Stores a value in the queue if the queue is not full
+   *
+   * @return true if the value has been stored, false if the queue is full
+   */
+  template <typename U>
+  bool tryPush(U&& val)
+  {
+    Slot* s;
+    size_t pos = enqueuePos.load(memory_order_relaxed);
+    while (true)
+    {
+      s = &slots[pos & mask];
+      size_t seq = s->seq.load(memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+      if (diff == 0)
+      {
+        // the slot is free; try to claim it
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+      }
+      else if (diff < 0)
+      {
+        // the slot still contains an element from the previous
+        // lap of the ring buffer ==> the queue is full
+        return false;
+      }
+      else
+      {
+        // another producer was faster
+        pos = enqueuePos.load(memory_order_relaxed);
+      }
+    }
+
+    s->val = std::forward<U>(val);
+    s->seq.store(pos + 1, memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Stores a value in the queue and waits for a free slot if the queue is full
+   */
+  template <typename U>
+  void push(U&& val)
+  {
+    int round = 0;
+    while (!(tryPush(std::forward<U>(val))))
+    {
+      waitStrategy(round++);
+    }
+  }
+
+  /**
+   * Takes the oldest element out of the queue if the queue is not empty
+   *
+   * @param out receives the element
+   *
+   * @return true if an element has been moved to "out", false if the queue is empty
+   */
+  bool tryPop(T& out)
+  {
+    Slot* s;
+    size_t pos = dequeuePos.load(memory_order_relaxed);
+    while (true)
+    {
+      s = &slots[pos & mask];
+      size_t seq = s->seq.load(memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+      if (diff == 0)
+      {
+        // the slot contains data; try to claim it
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+      }
+      else if (diff < 0)
+      {
+        // the queue is empty
+        return false;
+      }
+      else
+      {
+        // another consumer was faster
+        pos = dequeuePos.load(memory_order_relaxed);
+      }
+    }
+
+    out = std::move(s->val);
+
+    // release the slot for the next lap of the ring buffer
+    s->seq.store(pos + mask + 1, memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Takes the oldest element out of the queue and waits
+   * for new data if the queue is empty
+   */
+  T blockingPop()
+  {
+    T result;
+    int round = 0;
+    while (!(tryPop(result)))
+    {
+      waitStrategy(round++);
+    }
+
+    return result;
+  }
+
+  /**
+   * Takes up to maxCount elements out of the queue without waiting
+   *
+   * @param out the elements are appended to this vector
+   * @param maxCount the max number of elements to take
+   *
+   * @return the number of elements that have been appended to "out"
+   */
+  size_t popBatch(vector<T>& out, size_t maxCount)
+  {
+    size_t cnt = 0;
+    T val;
+    while ((cnt < maxCount) && tryPop(val))
+    {
+      out.push_back(std::move(val));
+      ++cnt;
+    }
+
+    return cnt;
+  }
+
+  /**
+   * @return true if the queue contained elements at the time of the call;
+   * only a hint if other threads push or pop at the same time
+   */
+  bool hasData() const
+  {
+    return (approxSize() > 0);
+  }
+
+  /**
+   * @return the number of elements in the queue at the time of the call;
+   * only a hint if other threads push or pop at the same time
+   */
+  size_t approxSize() const
+  {
+    size_t deq = dequeuePos.load(memory_order_acquire);
+    size_t enq = enqueuePos.load(memory_order_acquire);
+
+    return (enq > deq) ? (enq - deq) : 0;
+  }
+
+  size_t capacity() const
+  {
+    return mask + 1;
+  }
+
+private:
+  // the size of a cache line; used to keep the
+  // producer and consumer indices apart
+  static constexpr size_t CacheLineSize = 64;
+
+  struct Slot
+  {
+    atomic<size_t> seq;
+    T val;
+  };
+
+  unique_ptr<Slot[]> slots;
+  size_t mask;
+  WaitStrategy waitStrategy;
+
+  char padding0[CacheLineSize];
+  atomic<size_t> enqueuePos;
+  char padding1[CacheLineSize - sizeof(atomic<size_t>)];
+  atomic<size_t> dequeuePos;
+  char padding2[CacheLineSize - sizeof(atomic<size_t>)];
+};
+
+#endif // LOCKFREEQUEUE_H
@@ -196,6 +196,19 @@ namespace QTournament
 
   unique_ptr<MatchScore> Match::getScore(ERR *err) const
   {
+    // try the packed representation first because it
+    // doesn't require any string parsing
+    auto packedEntry = row.getInt2(MA_PACKED_RESULT);
+    if (!(packedEntry->isNull()))
+    {
+      auto result = MatchScore::fromPackedInt(packedEntry->get());
+      if (result != nullptr)
+      {
+        if (err != nullptr) *err = OK;
+        return result;
+      }
+    }
+
     auto scoreEntry = row.getString2(MA_RESULT);
 
     if (scoreEntry->isNull())
@@ -216,7 +229,10 @@ namespace QTournament
       // but if it does, we clear the invalid database entry
       // and return an error
       DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
-      row.updateToNull(MA_RESULT);
+      for (const string& col : {MA_RESULT, MA_PACKED_RESULT, MA_GAME_SUM_PAIR1, MA_GAME_SUM_PAIR2, MA_POINT_SUM_PAIR1, MA_POINT_SUM_PAIR2})
+      {
+        row.updateToNull(col);
+      }
       if (err != nullptr) *err = INCONSISTENT_MATCH_RESULT_STRING;
       return nullptr;
     }
@@ -225,6 +241,51 @@ namespace QTournament
     return result;
   }
 
+//----------------------------------------------------------------------------
+
+  /**
+   * Returns the game and point sums of the match result.
+   *
+   * The sums are read from the aggregate columns of the match table
+   * without parsing the score string. Only if these columns are
+   * empty (which shouldn't happen), the score string is parsed.
+   *
+   * @param err optional pointer to an error code; NO_MATCH_RESULT_SET
+   * if the match has no result yet
+   *
+   * @return the sums of the match result or nullptr if there is no (valid) result
+   */
+  unique_ptr<MatchScoreSums> Match::getScoreSums(ERR* err) const
+  {
+    QString sql = "SELECT COALESCE(%1, -1), COALESCE(%2, -1), COALESCE(%3, -1), COALESCE(%4, -1) FROM %5 WHERE id = %6";
+    sql = sql.arg(MA_GAME_SUM_PAIR1).arg(MA_GAME_SUM_PAIR2).arg(MA_POINT_SUM_PAIR1).arg(MA_POINT_SUM_PAIR2);
+    sql = sql.arg(TAB_MATCH).arg(getId());
+
+    MatchScoreSums result{-1, -1, -1, -1};
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if ((stmt != nullptr) && (stmt->hasData()))
+    {
+      stmt->getInt(0, &(result.gamesPair1));
+      stmt->getInt(1, &(result.gamesPair2));
+      stmt->getInt(2, &(result.pointsPair1));
+      stmt->getInt(3, &(result.pointsPair2));
+    }
+
+    if ((result.gamesPair1 >= 0) && (result.gamesPair2 >= 0) && (result.pointsPair1 >= 0) && (result.pointsPair2 >= 0))
+    {
+      if (err != nullptr) *err = OK;
+      return make_unique<MatchScoreSums>(result);
+    }
+
+    // fallback: parse the score string
+    auto score = getScore(err);
+    if (score == nullptr) return nullptr;
+
+    tie(result.gamesPair1, result.gamesPair2) = score->getGameSum();
+    tie(result.pointsPair1, result.pointsPair2) = score->getScoreSum();
+    return make_unique<MatchScoreSums>(result);
+  }
+
 //----------------------------------------------------------------------------
 
 
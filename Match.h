@@ -47,6 +47,20 @@ namespace QTournament
     SWAP,
   };
 
+  // the aggregated values of a match result as stored
+  // in the database alongside the score string
+  struct MatchScoreSums
+  {
+    int gamesPair1;
+    int gamesPair2;
+    int pointsPair1;
+    int pointsPair2;
+
+    // 1 or 2 for the winning pair, 0 for a draw; same as MatchScore::getWinner()
+    int getWinner() const { return (gamesPair1 > gamesPair2) ? 1 : ((gamesPair2 > gamesPair1) ? 2 : 0); }
+    int getPointsSum() const { return pointsPair1 + pointsPair2; }
+  };
+
   class Match : public TournamentDatabaseObject
   {
     friend class MatchMngr;
@@ -69,6 +83,7 @@ namespace QTournament
     QString getDisplayName(const QString& localWinnerName, const QString& localLoserName) const;
 
     unique_ptr<MatchScore> getScore(ERR *err=nullptr) const;
+    unique_ptr<MatchScoreSums> getScoreSums(ERR *err=nullptr) const;
     unique_ptr<PlayerPair> getWinner() const;
     unique_ptr<PlayerPair> getLoser() const;
 
@@ -19,6 +19,7 @@
 #include <assert.h>
 
 #include <QDateTime>
+#include <QStringList>
 
 #include <Sloppy/DateTime/DateAndTime.h>
 #include <SqliteOverlay/Transaction.h>
@@ -29,6 +30,7 @@
 #include "PlayerMngr.h"
 #include "CourtMngr.h"
 #include "CatMngr.h"
+#include "HotPathTracer.h"
 #include <SqliteOverlay/KeyValueTab.h>
 
 using namespace SqliteOverlay;
@@ -277,7 +279,16 @@ namespace QTournament {
 
   //----------------------------------------------------------------------------
 
-  void MatchMngr::deleteMatchGroupAndMatch(const MatchGroup& mg) const
+  /**
+   * Deletes a list of match groups and all their matches with one
+   * DELETE statement per table, followed by one renumbering of the
+   * sequence numbers per table.
+   *
+   * @param mgList the match groups to delete
+   *
+   * @return OK or DATABASE_ERROR
+   */
+  ERR MatchMngr::deleteMatchGroupsAndMatches(const MatchGroupList& mgList) const
   {
     //
     // USE WITH EXTREME CARE!!
@@ -295,22 +306,51 @@ namespace QTournament {
     // HAVE BEEN DELETED BEFORE!!
     //
 
+    if (mgList.empty()) return OK;
 
-    // lock the database before writing
-    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
+    QStringList mgIds;
+    vector<int> mgSeqNums;
+    for (const MatchGroup& mg : mgList)
+    {
+      mgIds.append(QString::number(mg.getId()));
+      mgSeqNums.push_back(mg.getSeqNum());
+    }
 
-    auto matchesInGroup = mg.getMatches();
-    for (const Match& ma : matchesInGroup)
+    // collect the sequence numbers of all affected matches
+    QString where = "%1 IN (%2)";
+    where = where.arg(MA_GRP_REF).arg(mgIds.join(","));
+    vector<int> maSeqNums;
+    auto stmt = db->execContentQuery(string{"SELECT "} + GENERIC_SEQNUM_FIELD_NAME + " FROM " + TAB_MATCH +
+                                     " WHERE " + where.toUtf8().constData());
+    if (stmt == nullptr) return DATABASE_ERROR;
+    while (stmt->hasData())
     {
-      int deletedSeqNum = ma.getSeqNum();
-      tab->deleteRowsByColumnValue("id", ma.getId());
-      fixSeqNumberAfterDelete(tab, deletedSeqNum);
+      int seqNum;
+      stmt->getInt(0, &seqNum);
+      maSeqNums.push_back(seqNum);
+      stmt->step();
     }
 
-    // delete the group itself.
-    int deletedSeqNum = mg.getSeqNum();
-    groupTab->deleteRowsByColumnValue("id", mg.getId());
-    fixSeqNumberAfterDelete(groupTab, deletedSeqNum);
+    // lock the database before writing
+    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
+
+    bool isDbErr;
+    auto tg = db->acquireTransactionGuard(false, &isDbErr);
+    if (isDbErr) return DATABASE_ERROR;
+
+    // the matches first, because they refer to the match groups
+    QString sql = "DELETE FROM %1 WHERE %2";
+    sql = sql.arg(TAB_MATCH).arg(where);
+    if (!(db->execNonQuery(sql.toUtf8().constData()))) return DATABASE_ERROR;  // implicit rollback through tg's dtor
+    if (!(fixSeqNumberAfterDelete(tab, maSeqNums))) return DATABASE_ERROR;
+
+    sql = "DELETE FROM %1 WHERE id IN (%2)";
+    sql = sql.arg(TAB_MATCH_GROUP).arg(mgIds.join(","));
+    if (!(db->execNonQuery(sql.toUtf8().constData()))) return DATABASE_ERROR;
+    if (!(fixSeqNumberAfterDelete(groupTab, mgSeqNums))) return DATABASE_ERROR;
+
+    bool isOkay = tg ? tg->commit() : true;
+    return isOkay ? OK : DATABASE_ERROR;
   }
 
   //----------------------------------------------------------------------------
@@ -354,6 +394,13 @@ namespace QTournament {
     // to actually promote the match to e.g., WAITING
     updateMatchStatus(ma);
 
+    // if the match has already been scheduled, the new players
+    // have to show up in all player-related views and indices
+    if (ma.getMatchNumber() != MATCH_NUM_NOT_ASSIGNED)
+    {
+      CentralSignalEmitter::getInstance()->matchPlayersChanged(ma.getId(), ma.getSeqNum());
+    }
+
     return OK;
   }
 
@@ -376,6 +423,12 @@ namespace QTournament {
     if (ppPos == 1) matchRow.update(MA_PAIR1_REF, pp.getPairId());
     if (ppPos == 2) matchRow.update(MA_PAIR2_REF, pp.getPairId());
 
+    // see setPlayerPairsForMatch()
+    if (ma.getMatchNumber() != MATCH_NUM_NOT_ASSIGNED)
+    {
+      CentralSignalEmitter::getInstance()->matchPlayersChanged(ma.getId(), ma.getSeqNum());
+    }
+
     return OK;
   }
 
@@ -793,7 +846,13 @@ namespace QTournament {
     updateMatchStatus(ma);
 
     bool isOkay = tg ? tg->commit() : true;
-    return isOkay ? OK : DATABASE_ERROR;
+    if (!isOkay) return DATABASE_ERROR;
+
+    // the status might be unchanged while
+    // the players of the match are different now
+    CentralSignalEmitter::getInstance()->matchPlayersChanged(ma.getId(), ma.getSeqNum());
+
+    return OK;
   }
 
   //----------------------------------------------------------------------------
@@ -857,6 +916,44 @@ namespace QTournament {
 
   //----------------------------------------------------------------------------
 
+  /**
+   * Adds all columns that represent a match score to a ColumnValueClause.
+   *
+   * Besides the score string, these are the packed score and the
+   * game and point sums for both player pairs. The additional columns
+   * allow for aggregating results directly in SQL or for restoring the
+   * score without any string parsing.
+   *
+   * @param score the score to store
+   * @param cvc the clause that receives the column values
+   */
+  void MatchMngr::addScoreColumns(const MatchScore& score, ColumnValueClause& cvc)
+  {
+    cvc.addStringCol(MA_RESULT, score.toString().toUtf8().constData());
+
+    int packed = score.toPackedInt();
+    if (packed > 0)
+    {
+      cvc.addIntCol(MA_PACKED_RESULT, packed);
+    } else {
+      cvc.addNullCol(MA_PACKED_RESULT);
+    }
+
+    int games1;
+    int games2;
+    tie(games1, games2) = score.getGameSum();
+    cvc.addIntCol(MA_GAME_SUM_PAIR1, games1);
+    cvc.addIntCol(MA_GAME_SUM_PAIR2, games2);
+
+    int points1;
+    int points2;
+    tie(points1, points2) = score.getScoreSum();
+    cvc.addIntCol(MA_POINT_SUM_PAIR1, points1);
+    cvc.addIntCol(MA_POINT_SUM_PAIR2, points2);
+  }
+
+  //----------------------------------------------------------------------------
+
   /**
     Checks if any match groups within a category can be promoted to a higher
     state. This can be, for example:
@@ -970,6 +1067,8 @@ namespace QTournament {
     */
   ERR MatchMngr::stageMatchGroup(const MatchGroup &grp)
   {
+    TRACE_SCOPE("MatchMngr::stageMatchGroup");
+
     ERR e = canStageMatchGroup(grp);
     if (e != OK) return e;
 
@@ -1587,6 +1686,8 @@ namespace QTournament {
 
   ERR MatchMngr::assignMatchToCourt(const Match &ma, const Court &court) const
   {
+    TRACE_SCOPE("MatchMngr::assignMatchToCourt");
+
     ERR e = canAssignMatchToCourt(ma, court);
     if (e != OK) return e;
 
@@ -1731,6 +1832,8 @@ namespace QTournament {
 
   ERR MatchMngr::setMatchScoreAndFinalizeMatch(const Match &ma, const MatchScore &score, bool isWalkover) const
   {
+    TRACE_SCOPE("MatchMngr::setMatchScoreAndFinalizeMatch");
+
     // check the match's state
     OBJ_STATE oldState = ma.getState();
     if ((!isWalkover) && (oldState != STAT_MA_RUNNING))
@@ -1782,7 +1885,7 @@ namespace QTournament {
     int maId = ma.getId();
     int maSeqNum = ma.getSeqNum();
     ColumnValueClause cvc;
-    cvc.addStringCol(MA_RESULT, score.toString().toUtf8().constData());
+    addScoreColumns(score, cvc);
     cvc.addIntCol(GENERIC_STATE_FIELD_NAME, static_cast<int>(STAT_MA_FINISHED));
     TabRow matchRow = tab->operator [](maId);
     int dbErr;
@@ -1922,7 +2025,9 @@ namespace QTournament {
     int maId = ma.getId();
     int maSeqNum = ma.getSeqNum();
     TabRow matchRow = tab->operator [](maId);
-    matchRow.update(MA_RESULT, newScore.toString().toUtf8().constData());
+    ColumnValueClause cvc;
+    addScoreColumns(newScore, cvc);
+    matchRow.update(cvc);
     CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
     cse->matchResultUpdated(maId, maSeqNum);
 
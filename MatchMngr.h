@@ -54,7 +54,7 @@ namespace QTournament
     unique_ptr<Match> createMatch(const MatchGroup& grp, ERR* err);
 
     // deletion
-    void deleteMatchGroupAndMatch(const MatchGroup& mg) const;
+    ERR deleteMatchGroupsAndMatches(const MatchGroupList& mgList) const;
 
     // retrievers / enumerators for MATCHES
     MatchList getCurrentlyRunningMatches() const;
@@ -126,6 +126,9 @@ namespace QTournament
     string getSyncString(vector<int> rows) override;
     string getSyncString_MatchGroups(vector<int> rows);
 
+    // column values for storing a match score in the database
+    static void addScoreColumns(const MatchScore& score, ColumnValueClause& cvc);
+
   private:
     DbTab* groupTab;
     void updateAllMatchGroupStates(const Category& cat) const;
@@ -30,6 +30,7 @@
 #include "CentralSignalEmitter.h"
 #include "MatchMngr.h"
 #include "CatMngr.h"
+#include "HotPathTracer.h"
 
 namespace QTournament {
 
@@ -196,6 +197,8 @@ namespace QTournament {
 
   void MatchTimePredictor::updatePrediction()
   {
+    TRACE_SCOPE("MatchTimePredictor::updatePrediction");
+
     // determine the available, not disabled courts
     CourtMngr cm{db};
     CourtList allCourts = cm.getAllCourts();
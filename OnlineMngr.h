@@ -165,8 +165,6 @@ namespace QTournament
 
   protected:
     bool initKeyboxWithFreshKeys(const QString& pw);
-    void compactDatabaseChangeLog(vector<SqliteOverlay::ChangeLogEntry>& log);
-    string log2SyncString(const vector<SqliteOverlay::ChangeLogEntry>& log);
     bool deleteOptionalConfigKey(const string& keyName);
 
   private:
@@ -0,0 +1,347 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include <QStringList>
+
+#include "PairDisplayNameCache.h"
+#include "TournamentDB.h"
+#include "CentralSignalEmitter.h"
+#include "Player.h"
+#include "Category.h"
+
+namespace QTournament
+{
+
+  PairDisplayNameCache::PairDisplayNameCache(TournamentDB* _db)
+    :QObject(), db(_db)
+  {
+    if (!(db->needsChangeNotifications())) return;
+
+    CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+
+    // incremental updates
+    connect(cse, SIGNAL(playerRenamed(Player)), this, SLOT(onPlayerRenamed(Player)), Qt::DirectConnection);
+    connect(cse, SIGNAL(playerStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onPlayerStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+
+    // freezing / unfreezing a category creates or deletes pairs
+    connect(cse, SIGNAL(categoryStatusChanged(Category,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onCategoryStatusChanged(Category,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+
+    // events that change the pairs or their IDs
+    connect(cse, SIGNAL(playersPaired(Category,Player,Player)), this, SLOT(onPairsChanged()), Qt::DirectConnection);
+    connect(cse, SIGNAL(playersSplit(Category,Player,Player)), this, SLOT(onPairsChanged()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endDeletePlayer()), this, SLOT(onPairsChanged()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onPairsChanged()), Qt::DirectConnection);
+    connect(cse, SIGNAL(categoryRemovedFromTournament(int,int)), this, SLOT(onPairsChanged()), Qt::DirectConnection);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Returns the display name of a player pair, e.g. "Last2, First2 / Last1, First1".
+   *
+   * @param pairId the ID of the pair in TAB_PAIRS
+   * @param maxLen the maximum length of the name or 0 for "no restriction"
+   * @param unregisteredPlayersInBrackets if true, players waiting for registration are put in brackets
+   *
+   * @return the display name or an empty string if the pair ID is invalid
+   */
+  QString PairDisplayNameCache::getDisplayName(int pairId, int maxLen, bool unregisteredPlayersInBrackets)
+  {
+    CacheEntry* e = getEntry(pairId);
+    if (e == nullptr) return QString();
+
+    return getName(*e, maxLen, unregisteredPlayersInBrackets);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Returns the display names of a list of player pairs.
+   *
+   * All pairs that are not yet in the cache are read with a single query.
+   *
+   * @param pairIds the IDs of the pairs in TAB_PAIRS
+   * @param maxLen the maximum length of the names or 0 for "no restriction"
+   * @param unregisteredPlayersInBrackets if true, players waiting for registration are put in brackets
+   *
+   * @return a map from pair ID to display name; invalid pair IDs are not contained in the map
+   */
+  unordered_map<int, QString> PairDisplayNameCache::getDisplayNames(const vector<int>& pairIds, int maxLen, bool unregisteredPlayersInBrackets)
+  {
+    vector<int> missingIds;
+    for (int pairId : pairIds)
+    {
+      if ((pairId > 0) && (pairId2Entry.find(pairId) == pairId2Entry.end()))
+      {
+        missingIds.push_back(pairId);
+      }
+    }
+    if (!(missingIds.empty())) loadPairs(missingIds);
+
+    unordered_map<int, QString> result;
+    for (int pairId : pairIds)
+    {
+      auto it = pairId2Entry.find(pairId);
+      if (it == pairId2Entry.end()) continue;
+
+      result[pairId] = getName(it->second, maxLen, unregisteredPlayersInBrackets);
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PairDisplayNameCache::invalidateAll()
+  {
+    pairId2Entry.clear();
+    playerId2PairIds.clear();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Generates the display name of a player pair from already known player data.
+   *
+   * @param pnd the names and states of the players
+   * @param maxLen the maximum length of the name or 0 for "no restriction"; values between 1 and 8 are invalid
+   * @param unregisteredPlayersInBrackets if true, players waiting for registration are put in brackets
+   *
+   * @return the display name
+   */
+  QString PairDisplayNameCache::formatDisplayName(const PairNameData& pnd, int maxLen, bool unregisteredPlayersInBrackets)
+  {
+    if (maxLen < 0)
+    {
+      maxLen = 0;
+    }
+
+    if ((maxLen > 0) && (maxLen < 9))
+    {
+      throw std::invalid_argument("Max len for display name too short!");
+    }
+
+    QString result;
+    if (pnd.player2Id > 0)
+    {
+      // reserve space for " / " if we have two players
+      maxLen = (maxLen == 0) ? 0 : maxLen - 3;
+
+      // and cut the max len in half
+      if ((maxLen % 2) != 0)
+      {
+        maxLen -= 1;
+      }
+      maxLen = maxLen / 2;
+
+      result = "%2 / %1";
+      if (unregisteredPlayersInBrackets)
+      {
+        if ((pnd.p1Stat == STAT_PL_WAIT_FOR_REGISTRATION) && (pnd.p2Stat == STAT_PL_WAIT_FOR_REGISTRATION))
+        {
+          result = "(%2 / %1)";
+        } else if (pnd.p1Stat == STAT_PL_WAIT_FOR_REGISTRATION)
+        {
+          result = "(%2) / %1";
+        } else if (pnd.p2Stat == STAT_PL_WAIT_FOR_REGISTRATION)
+        {
+          result = "%2 / (%1)";
+        }
+      }
+      result = result.arg(Player::formatDisplayName(pnd.p2First, pnd.p2Last, maxLen));
+    } else {
+      result = (unregisteredPlayersInBrackets && (pnd.p1Stat == STAT_PL_WAIT_FOR_REGISTRATION)) ? "(%1)" : "%1";
+    }
+
+    return result.arg(Player::formatDisplayName(pnd.p1First, pnd.p1Last, maxLen));
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PairDisplayNameCache::onPlayerRenamed(const Player& p)
+  {
+    auto it = playerId2PairIds.find(p.getId());
+    if (it == playerId2PairIds.end()) return;
+
+    // the player's pairs will be re-read upon the next access
+    for (int pairId : it->second)
+    {
+      pairId2Entry.erase(pairId);
+    }
+    playerId2PairIds.erase(it);
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PairDisplayNameCache::onPlayerStatusChanged(int playerId, int, OBJ_STATE fromState, OBJ_STATE toState)
+  {
+    // the player state only affects the bracket notation
+    // for players that wait for their registration
+    if ((fromState != STAT_PL_WAIT_FOR_REGISTRATION) && (toState != STAT_PL_WAIT_FOR_REGISTRATION)) return;
+
+    auto it = playerId2PairIds.find(playerId);
+    if (it == playerId2PairIds.end()) return;
+
+    for (int pairId : it->second)
+    {
+      auto entryIt = pairId2Entry.find(pairId);
+      if (entryIt == pairId2Entry.end()) continue;
+
+      CacheEntry& e = entryIt->second;
+      if (e.data.player1Id == playerId) e.data.p1Stat = toState;
+      if (e.data.player2Id == playerId) e.data.p2Stat = toState;
+      e.names.clear();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PairDisplayNameCache::onCategoryStatusChanged(const Category&, const OBJ_STATE fromState, const OBJ_STATE toState)
+  {
+    // "faked" state changes don't touch the pairs
+    if (fromState == toState) return;
+
+    invalidateAll();
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PairDisplayNameCache::onPairsChanged()
+  {
+    invalidateAll();
+  }
+
+  //----------------------------------------------------------------------------
+
+  int PairDisplayNameCache::nameKey(int maxLen, bool unregisteredPlayersInBrackets)
+  {
+    if (maxLen < 0) maxLen = 0;
+    return 2 * maxLen + (unregisteredPlayersInBrackets ? 1 : 0);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Reads the player data of a list of pairs with a single query
+   * and adds them to the cache.
+   */
+  void PairDisplayNameCache::loadPairs(const vector<int>& pairIds)
+  {
+    QStringList ids;
+    for (int id : pairIds) ids.append(QString::number(id));
+
+    QString sql = "SELECT pp.id, p1.id, p1.%1, p1.%2, p1.%3, p1.%4, "
+                  "COALESCE(p2.id, -1), COALESCE(p2.%1, ''), COALESCE(p2.%2, ''), COALESCE(p2.%3, -1), COALESCE(p2.%4, -1) "
+                  "FROM %5 pp JOIN %6 p1 ON p1.id = pp.%7 LEFT JOIN %6 p2 ON p2.id = pp.%8 "
+                  "WHERE pp.id IN (%9)";
+    sql = sql.arg(PL_FNAME).arg(PL_LNAME).arg(PL_SEX).arg(GENERIC_STATE_FIELD_NAME);
+    sql = sql.arg(TAB_PAIRS).arg(TAB_PLAYER);
+    sql = sql.arg(PAIRS_PLAYER1_REF).arg(PAIRS_PLAYER2_REF);
+    sql = sql.arg(ids.join(","));
+
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if (stmt == nullptr) return;   // shouldn't happen; we'll try again upon the next access
+
+    while (stmt->hasData())
+    {
+      int pairId;
+      PairNameData pnd;
+      string fn1;
+      string ln1;
+      string fn2;
+      string ln2;
+      int sex1;
+      int sex2;
+      int stat1;
+      int stat2;
+
+      stmt->getInt(0, &pairId);
+      stmt->getInt(1, &pnd.player1Id);
+      stmt->getString(2, &fn1);
+      stmt->getString(3, &ln1);
+      stmt->getInt(4, &sex1);
+      stmt->getInt(5, &stat1);
+      stmt->getInt(6, &pnd.player2Id);
+      stmt->getString(7, &fn2);
+      stmt->getString(8, &ln2);
+      stmt->getInt(9, &sex2);
+      stmt->getInt(10, &stat2);
+
+      pnd.p1First = QString::fromUtf8(fn1.c_str());
+      pnd.p1Last = QString::fromUtf8(ln1.c_str());
+      pnd.p1Stat = static_cast<OBJ_STATE>(stat1);
+      pnd.p2First = QString::fromUtf8(fn2.c_str());
+      pnd.p2Last = QString::fromUtf8(ln2.c_str());
+      pnd.p2Stat = static_cast<OBJ_STATE>(stat2);
+
+      // same order as in PlayerPair: the man first
+      if ((pnd.player2Id > 0) && (sex2 == M) && (sex1 == F))
+      {
+        std::swap(pnd.player1Id, pnd.player2Id);
+        std::swap(pnd.p1First, pnd.p2First);
+        std::swap(pnd.p1Last, pnd.p2Last);
+        std::swap(pnd.p1Stat, pnd.p2Stat);
+      }
+
+      pairId2Entry[pairId] = CacheEntry{pnd, {}};
+      playerId2PairIds[pnd.player1Id].push_back(pairId);
+      if (pnd.player2Id > 0) playerId2PairIds[pnd.player2Id].push_back(pairId);
+
+      stmt->step();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  PairDisplayNameCache::CacheEntry* PairDisplayNameCache::getEntry(int pairId)
+  {
+    if (pairId < 1) return nullptr;
+
+    auto it = pairId2Entry.find(pairId);
+    if (it == pairId2Entry.end())
+    {
+      loadPairs({pairId});
+      it = pairId2Entry.find(pairId);
+      if (it == pairId2Entry.end()) return nullptr;
+    }
+
+    return &(it->second);
+  }
+
+  //----------------------------------------------------------------------------
+
+  QString PairDisplayNameCache::getName(CacheEntry& e, int maxLen, bool unregisteredPlayersInBrackets)
+  {
+    int key = nameKey(maxLen, unregisteredPlayersInBrackets);
+
+    auto it = e.names.find(key);
+    if (it != e.names.end()) return it->second;
+
+    // may throw for invalid lengths; in this case,
+    // we don't store anything in the cache
+    QString name = formatDisplayName(e.data, maxLen, unregisteredPlayersInBrackets);
+    e.names[key] = name;
+
+    return name;
+  }
+
+}
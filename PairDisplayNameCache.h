@@ -0,0 +1,115 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAIRDISPLAYNAMECACHE_H
+#define PAIRDISPLAYNAMECACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+
+#include "TournamentDataDefs.h"
+
+using namespace std;
+
+namespace QTournament
+{
+  // forward
+  class TournamentDB;
+  class Player;
+  class Category;
+
+  /**
+   * The names and states of the players in a player pair; this is all
+   * we need for generating the pair's display name.
+   *
+   * If the pair has no second player, player2Id is -1.
+   */
+  struct PairNameData
+  {
+    int player1Id;
+    QString p1First;
+    QString p1Last;
+    OBJ_STATE p1Stat;
+    int player2Id;
+    QString p2First;
+    QString p2Last;
+    OBJ_STATE p2Stat;
+  };
+
+  /**
+   * Caches the display names of player pairs, keyed by the pair ID
+   * and the requested maximum name length.
+   *
+   * The player data of a pair is read once and the formatted names are
+   * generated from this data on demand. The batch access reads the data
+   * of all uncached pairs in a list with a single query.
+   *
+   * The cache listens to the CentralSignalEmitter: renamed players drop
+   * the entries of their pairs; status changes from or to
+   * STAT_PL_WAIT_FOR_REGISTRATION update the states used for the
+   * bracket notation. Changes to the pairs themselves or to the set of
+   * players and categories invalidate the complete cache.
+   *
+   * There is one instance per tournament database and it is owned by the
+   * TournamentDB object.
+   */
+  class PairDisplayNameCache : public QObject
+  {
+    Q_OBJECT
+
+  public:
+    PairDisplayNameCache(TournamentDB* _db);
+
+    QString getDisplayName(int pairId, int maxLen = 0, bool unregisteredPlayersInBrackets = false);
+    unordered_map<int, QString> getDisplayNames(const vector<int>& pairIds, int maxLen = 0, bool unregisteredPlayersInBrackets = false);
+
+    void invalidateAll();
+
+    static QString formatDisplayName(const PairNameData& pnd, int maxLen = 0, bool unregisteredPlayersInBrackets = false);
+
+  public slots:
+    void onPlayerRenamed(const Player& p);
+    void onPlayerStatusChanged(int playerId, int playerSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onCategoryStatusChanged(const Category& c, const OBJ_STATE fromState, const OBJ_STATE toState);
+    void onPairsChanged();
+
+  protected:
+    struct CacheEntry
+    {
+      PairNameData data;
+      unordered_map<int, QString> names;   // key: see nameKey()
+    };
+
+    static int nameKey(int maxLen, bool unregisteredPlayersInBrackets);
+
+    void loadPairs(const vector<int>& pairIds);
+    CacheEntry* getEntry(int pairId);
+    QString getName(CacheEntry& e, int maxLen, bool unregisteredPlayersInBrackets);
+
+  private:
+    TournamentDB* db;
+    unordered_map<int, CacheEntry> pairId2Entry;
+    unordered_map<int, vector<int>> playerId2PairIds;
+  };
+
+}
+
+#endif // PAIRDISPLAYNAMECACHE_H
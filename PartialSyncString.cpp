@@ -0,0 +1,257 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <iostream>
+
+#include "PartialSyncString.h"
+#include "TeamMngr.h"
+#include "CourtMngr.h"
+#include "CatMngr.h"
+#include "MatchMngr.h"
+#include "PlayerMngr.h"
+#include "RankingMngr.h"
+
+using namespace SqliteOverlay;
+
+namespace QTournament
+{
+  void compactDatabaseChangeLog(vector<SqliteOverlay::ChangeLogEntry>& log)
+  {
+    size_t oldLen = log.size();
+
+    // step one:
+    // search from the end of the list if there are any prior
+    // updates for the same row. If yes, remove the prior update
+    // because we'll always transmit the whole row
+    size_t outerIdx = log.size();
+    while (outerIdx > 0)
+    {
+      --outerIdx;
+
+      const ChangeLogEntry cle = log[outerIdx];  // do NOT use references here, because content gets shifted in memory when deleted
+      if (cle.action != RowChangeAction::Update) continue;
+
+      size_t innerIdx = outerIdx;
+      while (innerIdx != 0)
+      {
+        --innerIdx;
+        const ChangeLogEntry& inner = log.at(innerIdx);
+        if ((inner.rowId == cle.rowId) &&
+            (inner.action == RowChangeAction::Update) &&
+            (inner.tabName == cle.tabName))
+        {
+          log.erase(log.begin() + innerIdx);
+
+          // now innerIdx points to the element after the deleted
+          // element but since we're doing a "--" in the loop's head
+          // that's fine
+
+          // but we have to adjust the value of the outerIdx!
+          --outerIdx;
+        }
+      }
+    }
+
+    // step two:
+    // if there is an deletion, remove prior insertions or updates of the same row
+    outerIdx = log.size();
+    while (outerIdx > 0)
+    {
+      --outerIdx;
+
+      const ChangeLogEntry cle = log[outerIdx];  // do NOT use references here, because content gets shifted in memory when deleted
+      if (cle.action != RowChangeAction::Delete) continue;
+
+      bool foundInsert = false;
+      size_t innerIdx = outerIdx;
+      while (innerIdx != 0)
+      {
+        --innerIdx;
+        const ChangeLogEntry& inner = log.at(innerIdx);
+        if ((inner.rowId == cle.rowId) && (inner.tabName == cle.tabName))
+        {
+          if (inner.action == RowChangeAction::Insert)
+          {
+            foundInsert = true;
+          }
+
+          log.erase(log.begin() + innerIdx);
+
+          // now innerIdx points to the element after the deleted
+          // element but since we're doing a "--" in the loop's head
+          // that's fine
+
+          // but we have to adjust the value of the outerIdx!
+          --outerIdx;
+
+          // there is no need to go back before the first insert
+          if (foundInsert) break;
+        }
+      }
+
+      // if we found and deleted the insert, we can also delete
+      // the deletion
+      if (foundInsert) log.erase(log.begin() + outerIdx);
+    }
+
+    cerr << "Log compacter could delete " << (oldLen - log.size()) << " entries!" << endl;
+  }
+
+  //----------------------------------------------------------------------------
+
+  string log2SyncString(TournamentDB* db, const vector<ChangeLogEntry>& log)
+  {
+    // copy the log
+    ChangeLogList cll = log;
+
+    // sort copied entries by table name
+    std::sort(cll.begin(), cll.end(), [](const ChangeLogEntry& e1, const ChangeLogEntry& e2)
+    {
+      return (e1.tabName < e2.tabName);
+    });
+
+    // append a dummy entry at the end that triggers
+    // a bogus tablename change in the following algorithm.
+    // the dummy entry never makes it to the result string
+    cll.push_back(ChangeLogEntry{RowChangeAction::Delete, "xxx", "___", 42});
+
+    string result;
+    string curTabName;
+    vector<int> idxList;
+    auto it = cll.begin();
+    while (it != cll.end())
+    {
+      const ChangeLogEntry& cle = *it;
+
+      if (cle.tabName != curTabName)
+      {
+        if (!(idxList.empty()))
+        {
+          if (curTabName == TAB_COURT)
+          {
+            CourtMngr mngr{db};
+            result += mngr.getSyncString(idxList);
+          }
+          if (curTabName == TAB_TEAM)
+          {
+            TeamMngr mngr{db};
+            result += mngr.getSyncString(idxList);
+          }
+          if (curTabName == TAB_PLAYER)
+          {
+            PlayerMngr mngr{db};
+            result += mngr.getSyncString(idxList);
+          }
+          if (curTabName == TAB_P2C)
+          {
+            PlayerMngr mngr{db};
+            result += mngr.getSyncString_P2C(idxList);
+          }
+          if (curTabName == TAB_PAIRS)
+          {
+            PlayerMngr mngr{db};
+            result += mngr.getSyncString_Pairs(idxList);
+          }
+          if (curTabName == TAB_CATEGORY)
+          {
+            CatMngr mngr{db};
+            result += mngr.getSyncString(idxList);
+          }
+          if (curTabName == TAB_MATCH)
+          {
+            MatchMngr mngr{db};
+            result += mngr.getSyncString(idxList);
+          }
+          if (curTabName == TAB_MATCH_GROUP)
+          {
+            MatchMngr mngr{db};
+            result += mngr.getSyncString_MatchGroups(idxList);
+          }
+          if (curTabName == TAB_RANKING)
+          {
+            RankingMngr mngr{db};
+            result += mngr.getSyncString(idxList);
+          }
+        }
+
+        curTabName = cle.tabName;
+        idxList.clear();
+      }
+
+      if (cle.action == RowChangeAction::Delete)
+      {
+        idxList.push_back(- cle.rowId);  // negative ID ==> deletion
+      } else {
+        idxList.push_back(cle.rowId);
+      }
+
+      ++it;
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Converts the recent changes of the database into the payload for
+   * a partial sync with the server.
+   *
+   * The server applies the sections in the order of their appearance,
+   * so the order is:
+   *
+   *   1. deleted rows
+   *   2. SeqNumShift ranges for renumbered rows
+   *   3. inserted and updated rows
+   *
+   * The shifts refer to the rows that existed before the inserts.
+   * Inserted and updated rows already contain their final sequence
+   * numbers; if they came before the shifts, they would be shifted twice.
+   *
+   * @param db the database that the log refers to
+   * @param log the change log of the database
+   * @param shifts the sequence number shifts of the database
+   *
+   * @return the CSV payload for the server
+   */
+  string changeLogToPartialSyncString(TournamentDB* db, vector<ChangeLogEntry> log, const vector<SeqNumShift>& shifts)
+  {
+    // remove unnecessary, redundant entries from the log
+    compactDatabaseChangeLog(log);
+
+    ChangeLogList deletions;
+    ChangeLogList upserts;
+    for (const ChangeLogEntry& cle : log)
+    {
+      if (cle.action == RowChangeAction::Delete)
+      {
+        deletions.push_back(cle);
+      } else {
+        upserts.push_back(cle);
+      }
+    }
+
+    string csv = log2SyncString(db, deletions);
+    csv += db->getSyncStringForSeqNumShifts(shifts);
+    csv += log2SyncString(db, upserts);
+
+    return csv;
+  }
+
+}
@@ -0,0 +1,43 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARTIALSYNCSTRING_H
+#define PARTIALSYNCSTRING_H
+
+#include <string>
+#include <vector>
+
+#include "TournamentDB.h"
+
+using namespace std;
+
+namespace QTournament
+{
+  // removes redundant entries (e.g., repeated updates of the same row)
+  // from a database change log
+  void compactDatabaseChangeLog(vector<SqliteOverlay::ChangeLogEntry>& log);
+
+  // converts change log entries into the sync strings of
+  // the affected tables, one section per table
+  string log2SyncString(TournamentDB* db, const vector<SqliteOverlay::ChangeLogEntry>& log);
+
+  // the complete CSV payload for a partial sync with the server
+  string changeLogToPartialSyncString(TournamentDB* db, vector<SqliteOverlay::ChangeLogEntry> log, const vector<SeqNumShift>& shifts);
+}
+
+#endif // PARTIALSYNCSTRING_H
@@ -50,7 +50,26 @@ namespace QTournament
   {
     QString first = QString::fromUtf8(row[PL_FNAME].data());
     QString last = QString::fromUtf8(row[PL_LNAME].data());
-    
+
+    return formatDisplayName(first, last, maxLen);
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Builds the "Last, First" display name from a player's first and last name.
+   *
+   * Doesn't require a database access and can thus be used for
+   * names that have been read by a custom query.
+   *
+   * @param first the player's first name
+   * @param last the player's last name
+   * @param maxLen the maximum length of the result; values < 1 mean "no restriction"
+   *
+   * @return the (possibly shortened) display name
+   */
+  QString Player::formatDisplayName(QString first, QString last, int maxLen)
+  {
     QString fullName = last + ", " + first;
     
     if (maxLen < 1)   // no length restriction
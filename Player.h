@@ -50,6 +50,7 @@ namespace QTournament
   public:
     QString getDisplayName(int maxLen = 0) const;
     QString getDisplayName_FirstNameFirst() const;
+    static QString formatDisplayName(QString first, QString last, int maxLen = 0);
     QString getFirstName() const;
     QString getLastName() const;
     ERR rename(const QString& newFirst, const QString& newLast);
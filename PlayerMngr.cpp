@@ -21,6 +21,9 @@
 #include <QDebug>
 #include <QList>
 #include <QFile>
+#include <QHash>
+#include <QPair>
+#include <QSet>
 
 #include "PlayerMngr.h"
 #include "Player.h"
@@ -32,6 +35,7 @@
 #include "CentralSignalEmitter.h"
 #include <SqliteOverlay/KeyValueTab.h>
 #include "MatchMngr.h"
+#include "PlayerScheduleIndex.h"
 
 using namespace SqliteOverlay;
 
@@ -113,6 +117,143 @@ namespace QTournament
     return OK;
   }
 
+//----------------------------------------------------------------------------
+
+  /**
+   * Creates a list of players in a single transaction.
+   *
+   * All players are validated with the same rules as in createNewPlayer()
+   * before the first one is written. The existing player and team names
+   * are read only once for the whole list.
+   *
+   * In contrast to createNewPlayer(), no signals are emitted for the
+   * new players. The caller is responsible for resetting all models.
+   *
+   * @param newPlayers the data of the new players
+   * @param newPlayerIds optional pointer to a list that receives the IDs of the new players in the order of newPlayers
+   *
+   * @return OK or an error code; in case of errors, no player has been created
+   */
+  ERR PlayerMngr::createNewPlayers(const vector<NewPlayerData>& newPlayers, vector<int>* newPlayerIds)
+  {
+    if (newPlayerIds != nullptr) newPlayerIds->clear();
+
+    auto cfg = KeyValueTab::getTab(db, TAB_CFG, false);
+    if (cfg == nullptr)
+    {
+      throw std::runtime_error("Config table not found -- this shouldn't happen!");
+    }
+    bool useTeams = (cfg->getInt(CFG_KEY_USE_TEAMS) != 0);
+
+    // read all existing player names at once
+    bool isDbErr;
+    PlayerNameMap knownNames = getAllPlayerNames(&isDbErr);
+    if (isDbErr) return DATABASE_ERROR;
+
+    // read all team IDs at once
+    QHash<QString, int> teamName2Id;
+    if (useTeams)
+    {
+      auto stmt = db->execContentQuery(string{"SELECT id,"} + GENERIC_NAME_FIELD_NAME + " FROM " + TAB_TEAM);
+      if (stmt == nullptr) return DATABASE_ERROR;
+      while (stmt->hasData())
+      {
+        int id;
+        string n;
+        stmt->getInt(0, &id);
+        stmt->getString(1, &n);
+        teamName2Id[QString::fromUtf8(n.c_str())] = id;
+        stmt->step();
+      }
+    }
+
+    // validate all players before we write anything
+    // and prepare the column values
+    vector<ColumnValueClause> allCvc;
+    allCvc.reserve(newPlayers.size());
+    for (const NewPlayerData& npd : newPlayers)
+    {
+      QString first = npd.firstName.trimmed();
+      QString last = npd.lastName.trimmed();
+
+      if (first.isEmpty() || last.isEmpty())
+      {
+        return INVALID_NAME;
+      }
+
+      if ((first.length() > MAX_NAME_LEN) || (last.length() > MAX_NAME_LEN))
+      {
+        return INVALID_NAME;
+      }
+
+      auto name = qMakePair(first, last);
+      if (knownNames.contains(name))
+      {
+        return NAME_EXISTS;
+      }
+      knownNames.insert(name, PlayerIdAndSex{-1, npd.sex});   // no ID yet
+
+      if (npd.sex == DONT_CARE)
+      {
+        return INVALID_SEX;
+      }
+
+      ColumnValueClause cvc;
+      cvc.addStringCol(PL_FNAME, first.toUtf8().constData());
+      cvc.addStringCol(PL_LNAME, last.toUtf8().constData());
+      cvc.addIntCol(PL_SEX, static_cast<int>(npd.sex));
+      cvc.addIntCol(GENERIC_STATE_FIELD_NAME, static_cast<int>(STAT_PL_IDLE));
+
+      if (useTeams)
+      {
+        auto it = teamName2Id.constFind(npd.teamName);
+        if (it == teamName2Id.constEnd())
+        {
+          return INVALID_TEAM;
+        }
+        cvc.addIntCol(PL_TEAM_REF, it.value());
+      }
+
+      allCvc.push_back(cvc);
+    }
+    if (allCvc.empty()) return OK;
+
+    // lock the database before writing
+    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
+
+    // join the caller's transaction, if any (e.g., from importCSV())
+    unique_ptr<TournamentDB::TransactionGuard> tg;
+    if (!(db->isTransactionRunning())) tg = db->acquireTransactionGuard(false, &isDbErr);
+    if (isDbErr) return DATABASE_ERROR;
+
+    // we assign the sequence numbers directly instead
+    // of fixing them after each insert
+    vector<int> newIds;
+    newIds.reserve(allCvc.size());
+    int nextSeqNum = tab->length();
+    for (ColumnValueClause& cvc : allCvc)
+    {
+      cvc.addIntCol(GENERIC_SEQNUM_FIELD_NAME, nextSeqNum);
+
+      int dbErr;
+      int newId = tab->insertRow(cvc, &dbErr);
+      if ((newId < 1) || (dbErr != SQLITE_DONE))
+      {
+        return DATABASE_ERROR;   // implicit rollback through tg's dtor
+      }
+
+      newIds.push_back(newId);
+      ++nextSeqNum;
+    }
+
+    bool isOkay = tg ? tg->commit() : true;
+    if (!isOkay) return DATABASE_ERROR;
+
+    if (newPlayerIds != nullptr) *newPlayerIds = newIds;
+
+    return OK;
+  }
+
 //----------------------------------------------------------------------------
 
   bool PlayerMngr::hasPlayer(const QString& firstName, const QString& lastName)
@@ -163,6 +304,42 @@ namespace QTournament
     return getAllObjects<Player>();
   }
 
+//----------------------------------------------------------------------------
+
+  /**
+   * Reads the names of all players in the database with a single query.
+   *
+   * Used by the bulk operations instead of one query per player.
+   *
+   * @param isDbErr optional pointer to a bool that is set to true if the query failed
+   *
+   * @return a map of (first name, last name) to player ID and sex
+   */
+  PlayerNameMap PlayerMngr::getAllPlayerNames(bool* isDbErr)
+  {
+    PlayerNameMap result;
+
+    auto stmt = db->execContentQuery(string{"SELECT id,"} + PL_FNAME + "," + PL_LNAME + "," + PL_SEX + " FROM " + TAB_PLAYER);
+    if (isDbErr != nullptr) *isDbErr = (stmt == nullptr);
+    if (stmt == nullptr) return result;
+
+    while (stmt->hasData())
+    {
+      int id;
+      string fn;
+      string ln;
+      int sex;
+      stmt->getInt(0, &id);
+      stmt->getString(1, &fn);
+      stmt->getString(2, &ln);
+      stmt->getInt(3, &sex);
+      result[qMakePair(QString::fromUtf8(fn.c_str()), QString::fromUtf8(ln.c_str()))] = PlayerIdAndSex{id, static_cast<SEX>(sex)};
+      stmt->step();
+    }
+
+    return result;
+  }
+
 //----------------------------------------------------------------------------
 
   ERR PlayerMngr::renamePlayer(Player& p, const QString& nf, const QString& nl)
@@ -876,10 +1053,10 @@ namespace QTournament
     CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
     cse->beginDeletePlayer(oldSeqNum);
     tab->deleteRowsByColumnValue("id", p.getId());
-    fixSeqNumberAfterDelete(tab, oldSeqNum);
+    bool isOkay = fixSeqNumberAfterDelete(tab, oldSeqNum);
     cse->endDeletePlayer();
 
-    return OK;
+    return isOkay ? OK : DATABASE_ERROR;
   }
 
   //----------------------------------------------------------------------------
@@ -961,64 +1138,31 @@ namespace QTournament
 
   //----------------------------------------------------------------------------
 
+  /**
+   * Returns all scheduled matches of a player that are not yet running or finished.
+   *
+   * The match IDs are taken from the tournament-wide PlayerScheduleIndex,
+   * so we don't have to walk through all scheduled matches and their players.
+   *
+   * @param p the player to look up
+   * @param findFirstOnly if true, only the match with the lowest match number is returned
+   *
+   * @return a list of matches, ordered by match number
+   */
   vector<Match> PlayerMngr::getAllScheduledMatchesForPlayer(const Player &p, bool findFirstOnly)
   {
     vector<Match> result;
 
-    // get all scheduled matches
-    QString where = "%1 > 0 AND %2 != %3 AND %2 != %4 ORDER BY %5 ASC";
-    where = where.arg(MA_NUM);
-    where = where.arg(GENERIC_STATE_FIELD_NAME);
-    where = where.arg(static_cast<int>(STAT_MA_RUNNING));
-    where = where.arg(static_cast<int>(STAT_MA_FINISHED));
-    where = where.arg(MA_NUM);
-
-    DbTab* matchTab = db->getTab(TAB_MATCH);
     MatchMngr mm{db};
-    for (const Match& ma : getObjectsByWhereClause<Match>(matchTab, where.toUtf8().constData()))
+    for (int maId : db->getPlayerScheduleIndex()->getScheduledMatchIds(p.getId()))
     {
-      if (ma.hasPlayerPair1())
-      {
-        PlayerPair pp = ma.getPlayerPair1();
-        if (pp.getPlayer1() == p)
-        {
-          result.push_back(ma);
-          continue;
-        }
+      auto ma = mm.getMatch(maId);
+      if (ma == nullptr) continue;  // shouldn't happen
 
-        if (pp.hasPlayer2())
-        {
-          if (pp.getPlayer2() == p)
-          {
-            result.push_back(ma);
-            continue;
-          }
-        }
-      }
-
-      if (ma.hasPlayerPair2())
-      {
-        PlayerPair pp = ma.getPlayerPair2();
-        if (pp.getPlayer1() == p)
-        {
-          result.push_back(ma);
-          continue;
-        }
-
-        if (pp.hasPlayer2())
-        {
-          if (pp.getPlayer2() == p)
-          {
-            result.push_back(ma);
-            continue;
-          }
-        }
-      }
+      result.push_back(*ma);
 
       // stop the loop if we only need one match
-      // (okay, since we use "continue" above, we make at least one
-      // extra cycle after the first match before we hit this "if")
-      if (findFirstOnly && (!(result.empty()))) return result;
+      if (findFirstOnly) break;
     }
 
     return result;
@@ -1034,6 +1178,8 @@ namespace QTournament
     DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
 
     p.row.update(PL_REFEREE_COUNT, oldCount + 1);
+
+    CentralSignalEmitter::getInstance()->playerRefereeCountChanged(p.getId(), p.getSeqNum());
   }
 
   //----------------------------------------------------------------------------
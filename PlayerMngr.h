@@ -24,6 +24,8 @@
 
 #include <QList>
 #include <QObject>
+#include <QHash>
+#include <QPair>
 
 #include "TournamentDB.h"
 #include "Team.h"
@@ -41,6 +43,22 @@ using namespace SqliteOverlay;
 
 namespace QTournament
 {
+  // the data for a single new player in a bulk import
+  struct NewPlayerData
+  {
+    QString firstName;
+    QString lastName;
+    SEX sex;
+    QString teamName;
+  };
+
+  // ID and sex of a player, as returned by PlayerMngr::getAllPlayerNames()
+  struct PlayerIdAndSex
+  {
+    int id;
+    SEX sex;
+  };
+  using PlayerNameMap = QHash<QPair<QString, QString>, PlayerIdAndSex>;
 
   class PlayerMngr : public QObject, public TournamentDatabaseObjectManager
   {
@@ -52,11 +70,13 @@ namespace QTournament
 
     // player creation
     ERR createNewPlayer (const QString& firstName, const QString& lastName, SEX sex, const QString& teamName);
+    ERR createNewPlayers (const vector<NewPlayerData>& newPlayers, vector<int>* newPlayerIds = nullptr);
 
     // getters and (boolean) queries
     bool hasPlayer (const QString& firstName, const QString& lastName);
     Player getPlayer(const QString& firstName, const QString& lastName);
     vector<Player> getAllPlayers();
+    PlayerNameMap getAllPlayerNames(bool* isDbErr = nullptr);
     unique_ptr<Player> getPlayerBySeqNum(int seqNum);
     bool hasPlayer(int id);
     Player getPlayer(int id);
@@ -22,6 +22,7 @@
 #include "PlayerPair.h"
 #include "PlayerMngr.h"
 #include "CatMngr.h"
+#include "PairDisplayNameCache.h"
 
 namespace QTournament {
 
@@ -129,61 +130,25 @@ namespace QTournament {
 
   QString PlayerPair::getDisplayName(int maxLen, bool unregisteredPlayersInBrackets) const
   {
-    if (maxLen < 0)
-    {
-      maxLen = 0;
-    }
-    
-    if ((maxLen > 0) && (maxLen < 9))
+    // pairs with a database entry are served from the cache
+    if (pairId > 0)
     {
-      throw std::invalid_argument("Max len for display name too short!");
+      return db->getPairDisplayNameCache()->getDisplayName(pairId, maxLen, unregisteredPlayersInBrackets);
     }
-    
-    // prepare strings for the player names and for the result
-    QString result;
 
+    // "in memory" pairs without a database entry
     Player p1 = getPlayer1();
-    OBJ_STATE p1Stat = p1.getState();
-
-    QString p2Name;
+    PairNameData pnd{p1.getId(), p1.getFirstName(), p1.getLastName(), p1.getState(), -1, QString(), QString(), STAT_PL_IDLE};
     if (hasPlayer2())
     {
-      // reserve space for " / " if we have two players
-      maxLen = (maxLen == 0) ? 0 : maxLen - 3;
-      
-      // and cut the max len in half
-      if ((maxLen % 2) != 0)
-      {
-        maxLen -= 1;
-      }
-      maxLen = maxLen / 2;
-
       Player p2 = getPlayer2();
-      p2Name = p2.getDisplayName(maxLen);
-      OBJ_STATE p2Stat = p2.getState();
-
-      result = "%2 / %1";
-      if (unregisteredPlayersInBrackets)
-      {
-        if ((p1Stat == STAT_PL_WAIT_FOR_REGISTRATION) && (p2Stat == STAT_PL_WAIT_FOR_REGISTRATION))
-        {
-          result = "(%2 / %1)";
-        } else if (p1Stat == STAT_PL_WAIT_FOR_REGISTRATION)
-        {
-          result = "(%2) / %1";
-        } else if (p2Stat == STAT_PL_WAIT_FOR_REGISTRATION)
-        {
-          result = "%2 / (%1)";
-        }
-      }
-      result = result.arg(p2Name);
-    } else {
-      result = (unregisteredPlayersInBrackets && (p1Stat == STAT_PL_WAIT_FOR_REGISTRATION)) ? "(%1)" : "%1";
+      pnd.player2Id = p2.getId();
+      pnd.p2First = p2.getFirstName();
+      pnd.p2Last = p2.getLastName();
+      pnd.p2Stat = p2.getState();
     }
 
-    result = result.arg(p1.getDisplayName(maxLen));
-
-    return result;
+    return PairDisplayNameCache::formatDisplayName(pnd, maxLen, unregisteredPlayersInBrackets);
   }
 
 //----------------------------------------------------------------------------
@@ -87,43 +87,37 @@ namespace QTournament
 
   void PlayerProfile::initMatchIds()
   {
-    MatchMngr mm{db};
-
     // loop over all umpire matches and find the next scheduled match,
     // the currently running match and the last finished match
     QDateTime lastFinishTime;
     int nextMatchNum = -1;
-    for (const Match& ma : matchesAsUmpire)
+    for (const MatchInfo& mi : infosAsUmpire)
     {
-      OBJ_STATE stat = ma.getState();
-
-      if (stat == STAT_MA_FINISHED) ++umpireFinishedCount;
+      if (mi.state == STAT_MA_FINISHED) ++umpireFinishedCount;
 
-      if (ma.getState() == STAT_MA_RUNNING)
+      if (mi.state == STAT_MA_RUNNING)
       {
-        currentUmpireMatchId = ma.getId();
+        currentUmpireMatchId = mi.maId;
         continue;
       }
 
-      if (stat == STAT_MA_FINISHED)
+      if (mi.state == STAT_MA_FINISHED)
       {
-        QDateTime fTime = ma.getFinishTime();
-        if (fTime.isValid())
+        if (mi.finishTime.isValid())
         {
-          if ((!(lastFinishTime.isValid())) || (fTime > lastFinishTime))  // this does not include walkovers
+          if ((!(lastFinishTime.isValid())) || (mi.finishTime > lastFinishTime))  // this does not include walkovers
           {
-            lastFinishTime = fTime;
-            lastUmpireMatchId = ma.getId();
+            lastFinishTime = mi.finishTime;
+            lastUmpireMatchId = mi.maId;
             continue;
           }
         }
       }
 
-      int maNum = ma.getMatchNumber();
-      if ((maNum != MATCH_NUM_NOT_ASSIGNED) && ((maNum < nextMatchNum) || (nextMatchNum < 0)))
+      if ((mi.maNum != MATCH_NUM_NOT_ASSIGNED) && ((mi.maNum < nextMatchNum) || (nextMatchNum < 0)))
       {
-        nextMatchNum = maNum;
-        nextUmpireMatchId = ma.getId();
+        nextMatchNum = mi.maNum;
+        nextUmpireMatchId = mi.maId;
       }
     }
 
@@ -132,30 +126,26 @@ namespace QTournament
     // the currently running match and the last finished match
     lastFinishTime = QDateTime{};   // set to "invalid"
     nextMatchNum = -1;
-    for (const Match& ma : matchesAsPlayer)
+    for (const MatchInfo& mi : infosAsPlayer)
     {
-      OBJ_STATE stat = ma.getState();
-      int maNum = ma.getMatchNumber();
-
       // count all scheduled matches
-      if (maNum != MATCH_NUM_NOT_ASSIGNED) ++scheduledCount;
+      if (mi.maNum != MATCH_NUM_NOT_ASSIGNED) ++scheduledCount;
 
-      if (stat == STAT_MA_RUNNING)
+      if (mi.state == STAT_MA_RUNNING)
       {
-        currentMatchId = ma.getId();
+        currentMatchId = mi.maId;
         continue;
       }
 
-      if (stat == STAT_MA_FINISHED)
+      if (mi.state == STAT_MA_FINISHED)
       {
         ++finishCount;
-        QDateTime fTime = ma.getFinishTime();
-        if (fTime.isValid())
+        if (mi.finishTime.isValid())
         {
-          if ((!(lastFinishTime.isValid())) || (fTime > lastFinishTime))
+          if ((!(lastFinishTime.isValid())) || (mi.finishTime > lastFinishTime))
           {
-            lastFinishTime = fTime;
-            lastPlayedMatchId = ma.getId();
+            lastFinishTime = mi.finishTime;
+            lastPlayedMatchId = mi.maId;
           }
         } else {
           // invalid finish time indicates a walkover
@@ -164,10 +154,10 @@ namespace QTournament
         continue;
       }
 
-      if ((maNum != MATCH_NUM_NOT_ASSIGNED) && ((maNum < nextMatchNum) || (nextMatchNum < 0)))
+      if ((mi.maNum != MATCH_NUM_NOT_ASSIGNED) && ((mi.maNum < nextMatchNum) || (nextMatchNum < 0)))
       {
-        nextMatchNum = maNum;
-        nextMatchId = ma.getId();
+        nextMatchNum = mi.maNum;
+        nextMatchId = mi.maId;
       }
     }
   }
@@ -176,96 +166,88 @@ namespace QTournament
 
   void PlayerProfile::initMatchLists()
   {
+    int playerId = p.getId();
+
     //
-    // find all matches involving the participant as a PLAYER
+    // find all matches involving the participant as a PLAYER,
+    // either via the assigned player pairs or via the actual players
     //
+    QString sql = "FROM %1 ma LEFT JOIN %2 pp1 ON pp1.id = ma.%3 LEFT JOIN %2 pp2 ON pp2.id = ma.%4 "
+                  "WHERE pp1.%5=%6 OR pp1.%7=%6 OR pp2.%5=%6 OR pp2.%7=%6 "
+                  "OR ma.%8=%6 OR ma.%9=%6 OR ma.%10=%6 OR ma.%11=%6";
+    sql = sql.arg(TAB_MATCH).arg(TAB_PAIRS);
+    sql = sql.arg(MA_PAIR1_REF).arg(MA_PAIR2_REF);
+    sql = sql.arg(PAIRS_PLAYER1_REF).arg(playerId).arg(PAIRS_PLAYER2_REF);
+    sql = sql.arg(MA_ACTUAL_PLAYER1A_REF).arg(MA_ACTUAL_PLAYER1B_REF);
+    sql = sql.arg(MA_ACTUAL_PLAYER2A_REF).arg(MA_ACTUAL_PLAYER2B_REF);
+    infosAsPlayer = queryMatchInfos(sql);
 
-    // step 1: search via PlayerPairs
-    QString where = "%1=%2 OR %3=%2";
-    where = where.arg(PAIRS_PLAYER1_REF);
-    where = where.arg(p.getId());
-    where = where.arg(PAIRS_PLAYER2_REF);
-    DbTab* pairsTab = db->getTab(TAB_PAIRS);
-    auto it = pairsTab->getRowsByWhereClause(where.toUtf8().constData());
-    vector<int> matchIdList;
+    //
+    // find all matches involving the participant as an UMPIRE
+    //
+    sql = "FROM %1 ma WHERE ma.%2=%3";
+    sql = sql.arg(TAB_MATCH).arg(MA_REFEREE_REF).arg(playerId);
+    infosAsUmpire = queryMatchInfos(sql);
 
-    DbTab* matchTab = db->getTab(TAB_MATCH);
+    // copy the results to the match lists; they're
+    // already sorted by match number
     MatchMngr mm{db};
-    while (!(it.isEnd()))
+    for (const MatchInfo& mi : infosAsPlayer)
     {
-      TabRow r = *it;
-      int ppId = r.getId();
-
-      // search for all matches involving this player pair
-      where = "%1=%2 OR %3=%2";
-      where = where.arg(MA_PAIR1_REF);
-      where = where.arg(ppId);
-      where = where.arg(MA_PAIR2_REF);
-      auto matchIt = matchTab->getRowsByWhereClause(where.toUtf8().constData());
-      while (!(matchIt.isEnd()))
-      {
-        int maId = (*matchIt).getId();
-
-        if (!(Sloppy::isInVector<int>(matchIdList, maId))) matchIdList.push_back(maId);
-
-        ++matchIt;
-      }
-
-      ++it;
+      auto ma = mm.getMatch(mi.maId);
+      matchesAsPlayer.push_back(*ma);
     }
-
-    // step 2: search via ACTUAL_PLAYER
-    where = "%1=%2 OR %3=%2 OR %4=%2 OR %5=%2";
-    where = where.arg(MA_ACTUAL_PLAYER1A_REF);
-    where = where.arg(p.getId());
-    where = where.arg(MA_ACTUAL_PLAYER1B_REF);
-    where = where.arg(MA_ACTUAL_PLAYER2A_REF);
-    where = where.arg(MA_ACTUAL_PLAYER2B_REF);
-    it = matchTab->getRowsByWhereClause(where.toUtf8().constData());
-    while (!(it.isEnd()))
+    for (const MatchInfo& mi : infosAsUmpire)
     {
-      int maId = (*it).getId();
-
-      if (!(Sloppy::isInVector<int>(matchIdList, maId))) matchIdList.push_back(maId);
-
-      ++it;
+      auto ma = mm.getMatch(mi.maId);
+      matchesAsUmpire.push_back(*ma);
     }
+  }
 
-    // copy the results to the matchesAsPlayer-list
-    for (int maId : matchIdList)
-    {
-      auto ma = mm.getMatch(maId);
-      matchesAsPlayer.push_back(*ma);
-    }
+  //----------------------------------------------------------------------------
 
-    // sort by match number
-    std::sort(matchesAsPlayer.begin(), matchesAsPlayer.end(), [](const Match& ma1, const Match& ma2)
-    {
-      return ma1.getMatchNumber() < ma2.getMatchNumber();
-    });
+  /**
+   * Retrieves ID, number, state and finish time of a set of matches
+   * with a single query.
+   *
+   * @param fromAndWhere the FROM and WHERE part of the query; the match table must be aliased as "ma"
+   *
+   * @return a list of matches, sorted by match number (unassigned numbers first)
+   */
+  vector<PlayerProfile::MatchInfo> PlayerProfile::queryMatchInfos(const QString& fromAndWhere) const
+  {
+    vector<MatchInfo> result;
 
+    QString sql = "SELECT DISTINCT ma.id, COALESCE(ma.%1, %2), ma.%3, COALESCE(ma.%4, -1) ";
+    sql = sql.arg(MA_NUM).arg(MATCH_NUM_NOT_ASSIGNED);
+    sql = sql.arg(GENERIC_STATE_FIELD_NAME).arg(MA_FINISH_TIME);
+    sql += fromAndWhere;
+    sql += QString(" ORDER BY COALESCE(ma.%1, %2) ASC, ma.id ASC").arg(MA_NUM).arg(MATCH_NUM_NOT_ASSIGNED);
 
-    //
-    // find all matches involving the participant as an UMPIRE
-    //
-    matchIdList.clear();
-    it = matchTab->getRowsByColumnValue(MA_REFEREE_REF, p.getId());
-    while (!(it.isEnd()))
-    {
-      int maId = (*it).getId();
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if (stmt == nullptr) return result;
 
-      auto ma = mm.getMatch(maId);
-      matchesAsUmpire.push_back(*ma);
+    while (stmt->hasData())
+    {
+      MatchInfo mi;
+      int stateId;
+      int finishTime;
+      stmt->getInt(0, &mi.maId);
+      stmt->getInt(1, &mi.maNum);
+      stmt->getInt(2, &stateId);
+      stmt->getInt(3, &finishTime);
+
+      mi.state = static_cast<OBJ_STATE>(stateId);
+      if (finishTime >= 0)
+      {
+        mi.finishTime = QDateTime::fromTime_t(static_cast<uint>(finishTime));
+      }
 
-      ++it;
+      result.push_back(mi);
+      stmt->step();
     }
 
-    // sort by match number
-    std::sort(matchesAsUmpire.begin(), matchesAsUmpire.end(), [](const Match& ma1, const Match& ma2)
-    {
-      return ma1.getMatchNumber() < ma2.getMatchNumber();
-    });
-
+    return result;
   }
 
   //----------------------------------------------------------------------------
@@ -20,8 +20,10 @@
 #define PLAYERPROFILE_H
 
 #include <memory>
+#include <vector>
 
 #include <QList>
+#include <QDateTime>
 
 #include "TournamentDB.h"
 #include "Match.h"
@@ -77,8 +79,22 @@ namespace QTournament
     QList<Match> matchesAsPlayer;
     QList<Match> matchesAsUmpire;
 
+    // the match attributes we need for the statistics; they are
+    // retrieved along with the match IDs so that we don't have
+    // to query each Match object individually
+    struct MatchInfo
+    {
+      int maId;
+      int maNum;
+      OBJ_STATE state;
+      QDateTime finishTime;
+    };
+    vector<MatchInfo> infosAsPlayer;
+    vector<MatchInfo> infosAsUmpire;
+
     void initMatchIds();
     void initMatchLists();
+    vector<MatchInfo> queryMatchInfos(const QString& fromAndWhere) const;
 
     unique_ptr<Match> returnMatchOrNullptr(int maId) const;
   };
@@ -0,0 +1,246 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <QString>
+
+#include "PlayerScheduleIndex.h"
+#include "TournamentDB.h"
+#include "CentralSignalEmitter.h"
+
+namespace QTournament
+{
+
+  PlayerScheduleIndex::PlayerScheduleIndex(TournamentDB* _db)
+    :QObject(), db(_db), isLoaded{false}
+  {
+    if (!(db->needsChangeNotifications())) return;
+
+    CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+
+    // incremental updates
+    connect(cse, SIGNAL(matchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onMatchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+    connect(cse, SIGNAL(matchPlayersChanged(int,int)),
+            this, SLOT(onMatchPlayersChanged(int,int)), Qt::DirectConnection);
+
+    // events that we can't map to a single match
+    connect(cse, SIGNAL(endCreateMatch(int)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(categoryRemovedFromTournament(int,int)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(playersPaired(Category,Player,Player)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(playersSplit(Category,Player,Player)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+  }
+
+  //----------------------------------------------------------------------------
+
+  vector<int> PlayerScheduleIndex::getScheduledMatchIds(int playerId)
+  {
+    if (!isLoaded) loadIndex();
+
+    vector<int> result;
+
+    auto it = playerId2Schedule.find(playerId);
+    if (it == playerId2Schedule.end()) return result;
+
+    result.reserve(it->second.size());
+    for (const ScheduleEntry& se : it->second)
+    {
+      result.push_back(se.second);
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  int PlayerScheduleIndex::getNextMatchNumber(int playerId)
+  {
+    if (!isLoaded) loadIndex();
+
+    auto it = playerId2Schedule.find(playerId);
+    if ((it == playerId2Schedule.end()) || (it->second.empty())) return -1;
+
+    return it->second.front().first;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::invalidateAll()
+  {
+    playerId2Schedule.clear();
+    matchId2PlayerIds.clear();
+    isLoaded = false;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::onMatchStatusChanged(int matchId, int, OBJ_STATE, OBJ_STATE toState)
+  {
+    // nothing to maintain if nobody asked for the index yet
+    if (!isLoaded) return;
+
+    // the most frequent case: a match is called or finished
+    if ((toState == STAT_MA_RUNNING) || (toState == STAT_MA_FINISHED))
+    {
+      removeMatch(matchId);
+      return;
+    }
+
+    // in all other cases the match number or the player pairs
+    // might have changed; so we re-read this match's data
+    reloadMatch(matchId);
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::onMatchPlayersChanged(int matchId, int)
+  {
+    if (!isLoaded) return;
+    reloadMatch(matchId);
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::onObjectsCreatedOrDeleted()
+  {
+    invalidateAll();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * @return a query that returns (match ID, match number, player ID) for each player of each scheduled match
+   */
+  QString PlayerScheduleIndex::getBaseQuery() const
+  {
+    // each match is joined with both of its player pairs; the
+    // UNION ALL then yields one row per player and match
+    QString sql = "SELECT ma.id, ma.%1, pp.%2 FROM %3 ma JOIN %4 pp ON pp.id IN (ma.%5, ma.%6) "
+                  "WHERE ma.%1 > 0 AND ma.%7 != %8 AND ma.%7 != %9 AND ##MATCH## "
+                  "UNION ALL "
+                  "SELECT ma.id, ma.%1, pp.%10 FROM %3 ma JOIN %4 pp ON pp.id IN (ma.%5, ma.%6) "
+                  "WHERE ma.%1 > 0 AND ma.%7 != %8 AND ma.%7 != %9 AND pp.%10 IS NOT NULL AND ##MATCH##";
+    sql = sql.arg(MA_NUM).arg(PAIRS_PLAYER1_REF);
+    sql = sql.arg(TAB_MATCH).arg(TAB_PAIRS);
+    sql = sql.arg(MA_PAIR1_REF).arg(MA_PAIR2_REF);
+    sql = sql.arg(GENERIC_STATE_FIELD_NAME);
+    sql = sql.arg(static_cast<int>(STAT_MA_RUNNING)).arg(static_cast<int>(STAT_MA_FINISHED));
+    sql = sql.arg(PAIRS_PLAYER2_REF);
+
+    return sql;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::loadIndex()
+  {
+    invalidateAll();
+
+    QString sql = getBaseQuery();
+    sql.replace("##MATCH##", "1");
+
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if (stmt == nullptr) return;  // shouldn't happen; we'll try again upon the next access
+
+    while (stmt->hasData())
+    {
+      int maId;
+      int maNum;
+      int playerId;
+      stmt->getInt(0, &maId);
+      stmt->getInt(1, &maNum);
+      stmt->getInt(2, &playerId);
+
+      playerId2Schedule[playerId].push_back(make_pair(maNum, maId));
+      matchId2PlayerIds[maId].push_back(playerId);
+
+      stmt->step();
+    }
+
+    // sort all schedules by match number
+    for (auto& p : playerId2Schedule)
+    {
+      std::sort(p.second.begin(), p.second.end());
+    }
+
+    isLoaded = true;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::reloadMatch(int matchId)
+  {
+    removeMatch(matchId);
+
+    QString sql = getBaseQuery();
+    sql.replace("##MATCH##", "ma.id = " + QString::number(matchId));
+
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if (stmt == nullptr)
+    {
+      invalidateAll();
+      return;
+    }
+
+    while (stmt->hasData())
+    {
+      int maId;
+      int maNum;
+      int playerId;
+      stmt->getInt(0, &maId);
+      stmt->getInt(1, &maNum);
+      stmt->getInt(2, &playerId);
+
+      addMatch(maId, maNum, playerId);
+
+      stmt->step();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::removeMatch(int matchId)
+  {
+    auto it = matchId2PlayerIds.find(matchId);
+    if (it == matchId2PlayerIds.end()) return;
+
+    for (int playerId : it->second)
+    {
+      vector<ScheduleEntry>& schedule = playerId2Schedule[playerId];
+      schedule.erase(std::remove_if(schedule.begin(), schedule.end(), [matchId](const ScheduleEntry& se) {
+        return (se.second == matchId);
+      }), schedule.end());
+    }
+
+    matchId2PlayerIds.erase(it);
+  }
+
+  //----------------------------------------------------------------------------
+
+  void PlayerScheduleIndex::addMatch(int matchId, int matchNum, int playerId)
+  {
+    vector<ScheduleEntry>& schedule = playerId2Schedule[playerId];
+    ScheduleEntry se = make_pair(matchNum, matchId);
+    schedule.insert(std::upper_bound(schedule.begin(), schedule.end(), se), se);
+
+    matchId2PlayerIds[matchId].push_back(playerId);
+  }
+
+}
@@ -0,0 +1,93 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PLAYERSCHEDULEINDEX_H
+#define PLAYERSCHEDULEINDEX_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <QObject>
+
+#include "TournamentDataDefs.h"
+
+using namespace std;
+
+namespace QTournament
+{
+  // forward
+  class TournamentDB;
+
+  /**
+   * Maintains a lookup table from player IDs to all scheduled but not
+   * yet running or finished matches of that player, ordered by match number.
+   *
+   * The complete table is built with a single query on first access. Afterwards,
+   * it is kept up to date by listening to the match signals of the
+   * CentralSignalEmitter: each (real or faked) status change of a match and
+   * each change of its player pairs only re-reads the entry of that particular
+   * match. This covers the assignment of match numbers, the resolution of
+   * symbolic player pair references and the swapping of player pairs in
+   * scheduled matches. Events that we can't map to a single
+   * match or a transaction rollback invalidate the whole table.
+   *
+   * There is one instance per tournament database and it is owned by the
+   * TournamentDB object.
+   */
+  class PlayerScheduleIndex : public QObject
+  {
+    Q_OBJECT
+
+  public:
+    PlayerScheduleIndex(TournamentDB* _db);
+
+    // the IDs of all scheduled matches of a player, ordered by match number
+    vector<int> getScheduledMatchIds(int playerId);
+
+    // the lowest match number of all scheduled matches of a player or -1 if there is none
+    int getNextMatchNumber(int playerId);
+
+    void invalidateAll();
+
+  public slots:
+    void onMatchStatusChanged(int matchId, int matchSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onMatchPlayersChanged(int matchId, int matchSeqNum);
+    void onObjectsCreatedOrDeleted();
+
+  protected:
+    // (match number, match ID)
+    using ScheduleEntry = pair<int, int>;
+
+    void loadIndex();
+    void reloadMatch(int matchId);
+    void removeMatch(int matchId);
+    void addMatch(int matchId, int matchNum, int playerId);
+    QString getBaseQuery() const;
+
+  private:
+    TournamentDB* db;
+    bool isLoaded;
+
+    unordered_map<int, vector<ScheduleEntry>> playerId2Schedule;
+    unordered_map<int, vector<int>> matchId2PlayerIds;
+  };
+
+}
+
+#endif // PLAYERSCHEDULEINDEX_H
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += widgets network
+QT       += widgets network concurrent
 
 TARGET = QTournament
 TEMPLATE = app
@@ -25,6 +25,12 @@ CONFIG(release, debug|release) {
 # linking against BOOST fails if this is not set
 DEFINES += "BOOST_LOG_DYN_LINK=1"
 
+# scoped timers for the hot paths; enable with "qmake CONFIG+=tracing"
+# and set QTOURNAMENT_TRACE_FILE for writing a Chrome trace file
+tracing {
+  DEFINES += "QTOURNAMENT_ENABLE_TRACING"
+}
+
 HEADERS += \
     Category.h \
     CatMngr.h \
@@ -60,6 +66,7 @@ HEADERS += \
     ui/delegates/CatItemDelegate.h \
     ui/delegates/DelegateItemLED.h \
     ThreadSafeQueue.h \
+    LockFreeQueue.h \
     ui/ScheduleTabWidget.h \
     models/MatchGroupTabModel.h \
     ui/MatchGroupTableView.h \
@@ -74,6 +81,14 @@ HEADERS += \
     Score.h \
     ui/delegates/CourtItemDelegate.h \
     CatRoundStatus.h \
+    CatRoundStatusCache.h \
+    PlayerScheduleIndex.h \
+    RefereeCandidateService.h \
+    PairDisplayNameCache.h \
+    CatParameterCache.h \
+    SqlProfiler.h \
+    DbSnapshotPool.h \
+    HotPathTracer.h \
     RankingMngr.h \
     RankingEntry.h \
     BracketGenerator.h \
@@ -81,6 +96,8 @@ HEADERS += \
     reports/ParticipantsList.h \
     ui/ReportsTabWidget.h \
     reports/ReportFactory.h \
+    reports/ReportCache.h \
+    reports/ReportBatchExporter.h \
     reports/MatchResultList.h \
     reports/MatchResultList_byGroup.h \
     reports/Standings.h \
@@ -115,6 +132,7 @@ HEADERS += \
     reports/MatrixAndStandings.h \
     reports/commonReportElements/MatchMatrix.h \
     ExternalPlayerDB.h \
+    ExternalPlayerNameIndex.h \
     ui/commonCommands/cmdImportSinglePlayerFromExternalDatabase.h \
     ui/DlgImportPlayer.h \
     ui/commonCommands/cmdExportPlayerToExternalDatabase.h \
@@ -147,9 +165,11 @@ HEADERS += \
     ui/DlgImportCSV_Step1.h \
     ui/DlgImportCSV_Step2.h \
     ui/DlgPickTeam.h \
+    ui/DlgSqlProfiler.h \
     ui/DlgPickCategory.h \
     ui/DlgRoundFinished.h \
     OnlineMngr.h \
+    PartialSyncString.h \
     ui/DlgPassword.h \
     HttpClient.h \
     ui/DlgRegisterTournament.h \
@@ -160,7 +180,9 @@ HEADERS += \
     ui/commonCommands/cmdFullSync.h \
     ui/commonCommands/cmdDeleteFromServer.h \
     ui/DlgConnectionSettings.h \
-    ui/commonCommands/cmdConnectionSettings.h
+    ui/commonCommands/cmdConnectionSettings.h \
+    ui/commonCommands/cmdRunCategoryOperation.h \
+    ui/commonCommands/cmdBulkImportToExternalDatabase.h
 
 SOURCES += \
     Category.cpp \
@@ -210,6 +232,14 @@ SOURCES += \
     Score.cpp \
     ui/delegates/CourtItemDelegate.cpp \
     CatRoundStatus.cpp \
+    CatRoundStatusCache.cpp \
+    PlayerScheduleIndex.cpp \
+    RefereeCandidateService.cpp \
+    PairDisplayNameCache.cpp \
+    CatParameterCache.cpp \
+    SqlProfiler.cpp \
+    DbSnapshotPool.cpp \
+    HotPathTracer.cpp \
     RankingMngr.cpp \
     RankingEntry.cpp \
     BracketGenerator.cpp \
@@ -217,6 +247,8 @@ SOURCES += \
     reports/ParticipantsList.cpp \
     ui/ReportsTabWidget.cpp \
     reports/ReportFactory.cpp \
+    reports/ReportCache.cpp \
+    reports/ReportBatchExporter.cpp \
     reports/MatchResultList.cpp \
     reports/MatchResultList_byGroup.cpp \
     reports/Standings.cpp \
@@ -251,6 +283,7 @@ SOURCES += \
     reports/MatrixAndStandings.cpp \
     reports/commonReportElements/MatchMatrix.cpp \
     ExternalPlayerDB.cpp \
+    ExternalPlayerNameIndex.cpp \
     ui/commonCommands/cmdImportSinglePlayerFromExternalDatabase.cpp \
     ui/DlgImportPlayer.cpp \
     ui/commonCommands/cmdExportPlayerToExternalDatabase.cpp \
@@ -283,9 +316,11 @@ SOURCES += \
     ui/DlgImportCSV_Step1.cpp \
     ui/DlgImportCSV_Step2.cpp \
     ui/DlgPickTeam.cpp \
+    ui/DlgSqlProfiler.cpp \
     ui/DlgPickCategory.cpp \
     ui/DlgRoundFinished.cpp \
     OnlineMngr.cpp \
+    PartialSyncString.cpp \
     ui/DlgPassword.cpp \
     HttpClient.cpp \
     ui/DlgRegisterTournament.cpp \
@@ -296,7 +331,9 @@ SOURCES += \
     ui/commonCommands/cmdFullSync.cpp \
     ui/commonCommands/cmdDeleteFromServer.cpp \
     ui/DlgConnectionSettings.cpp \
-    ui/commonCommands/cmdConnectionSettings.cpp
+    ui/commonCommands/cmdConnectionSettings.cpp \
+    ui/commonCommands/cmdRunCategoryOperation.cpp \
+    ui/commonCommands/cmdBulkImportToExternalDatabase.cpp
 
 RESOURCES += \
     tournament.qrc
@@ -328,6 +365,7 @@ FORMS += \
     ui/DlgImportCSV_Step1.ui \
     ui/DlgImportCSV_Step2.ui \
     ui/DlgPickTeam.ui \
+    ui/DlgSqlProfiler.ui \
     ui/DlgPickCategory.ui \
     ui/DlgRoundFinished.ui \
     ui/DlgPassword.ui \
@@ -351,4 +389,4 @@ unix {
   CONFIG(release, debug|release): LIBS += -lSimpleReportGenerator
 }
 
-LIBS += -lSqliteOverlay -lSloppy  
+LIBS += -lSqliteOverlay -lSloppy -lsqlite3
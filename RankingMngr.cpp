@@ -28,6 +28,7 @@
 #include "Match.h"
 #include "Score.h"
 #include "MatchMngr.h"
+#include "HotPathTracer.h"
 
 using namespace SqliteOverlay;
 
@@ -74,13 +75,13 @@ namespace QTournament
       if (ma != nullptr)
       {
         ERR e;
-        unique_ptr<MatchScore> score = ma->getScore(&e);
+        auto sums = ma->getScoreSums(&e);
         if (e != OK)
         {
           if (err != nullptr) *err = e;
           return RankingEntryList();
         }
-        if (score == nullptr)
+        if (sums == nullptr)
         {
           if (err != nullptr) *err = NO_MATCH_RESULT_SET;
           return RankingEntryList();
@@ -119,25 +120,25 @@ namespace QTournament
         int pp1Id = ma->getPlayerPair1().getPairId();
         int playerNum = (pp1Id == pp.getPairId()) ? 1 : 2;
 
-        // create column values for match data
+        // create column values for match data; the sums are
+        // read from the database without parsing the score string
         ERR e;
-        unique_ptr<MatchScore> score = ma->getScore(&e);
-        if (score == nullptr) qDebug() << "!!! NULL !!!";
+        auto sums = ma->getScoreSums(&e);
+        if (sums == nullptr) qDebug() << "!!! NULL !!!";
         if (e != OK) qDebug() << e;
-        wonMatches = (score->getWinner() == playerNum) ? 1 : 0;
-        lostMatches = (score->getLoser() == playerNum) ? 1 : 0;
-        drawMatches = (score->getWinner() == 0) ? 1 : 0;
+        int winner = sums->getWinner();
+        wonMatches = (winner == playerNum) ? 1 : 0;
+        lostMatches = ((winner != 0) && (winner != playerNum)) ? 1 : 0;
+        drawMatches = (winner == 0) ? 1 : 0;
 
         // create column values for game data
-        tuple<int, int> gameSum = score->getGameSum();
-        int gamesTotal = get<0>(gameSum) + get<1>(gameSum);
-        wonGames = (playerNum == 1) ? get<0>(gameSum) : get<1>(gameSum);
+        int gamesTotal = sums->gamesPair1 + sums->gamesPair2;
+        wonGames = (playerNum == 1) ? sums->gamesPair1 : sums->gamesPair2;
         lostGames = gamesTotal - wonGames;
 
         // create column values for point data
-        tuple<int, int> scoreSum = score->getScoreSum();
-        wonPoints = (playerNum == 1) ? get<0>(scoreSum) : get<1>(scoreSum);
-        lostPoints = score->getPointsSum() - wonPoints;
+        wonPoints = (playerNum == 1) ? sums->pointsPair1 : sums->pointsPair2;
+        lostPoints = sums->getPointsSum() - wonPoints;
       }
 
       // add values from previous round, if required
@@ -312,7 +313,7 @@ namespace QTournament
     int firstRoundToModify = ma.getMatchGroup().getRound();
 
     // determine the score differences (delta) for each affected player pair
-    MatchScore newScore = *(ma.getScore());  // is guaranteed to be != nullptr
+    MatchScoreSums newScore = *(ma.getScoreSums());  // is guaranteed to be != nullptr
     tuple<int, int, int> deltaMatches_P1{0,0,0};  // to be added to PlayerPair1
     tuple<int, int, int> deltaMatches_P2{0,0,0};  // to be added to PlayerPair2
 
@@ -350,7 +351,7 @@ namespace QTournament
     }
 
     tuple<int, int> gameSumOld = oldScore.getGameSum();
-    tuple<int, int> gameSumNew = newScore.getGameSum();
+    tuple<int, int> gameSumNew{newScore.gamesPair1, newScore.gamesPair2};
     int gamesTotalOld = get<0>(gameSumOld) + get<1>(gameSumOld);
     int gamesTotalNew = get<0>(gameSumNew) + get<1>(gameSumNew);
 
@@ -362,7 +363,7 @@ namespace QTournament
     tuple<int, int> deltaGames_P2{deltaWonGamesP2, deltaLostGamesP2};  // to be added to PlayerPair2
 
     tuple<int, int> scoreSumOld = oldScore.getScoreSum();
-    tuple<int, int> scoreSumNew = newScore.getScoreSum();
+    tuple<int, int> scoreSumNew{newScore.pointsPair1, newScore.pointsPair2};
     int oldWonPoints_P1 = get<0>(scoreSumOld);
     int newWonPoints_P1 = get<0>(scoreSumNew);
     int deltaWonPoints_P1 = newWonPoints_P1 - oldWonPoints_P1;
@@ -518,6 +519,8 @@ namespace QTournament
 
   RankingEntryListList RankingMngr::sortRankingEntriesForLastRound(const Category& cat, ERR* err) const
   {
+    TRACE_SCOPE("RankingMngr::sortRankingEntriesForLastRound");
+
     // determine the round we should create the entries for
     CatRoundStatus crs = cat.getRoundStatus();
     int lastRound = crs.getFinishedRoundsCount();
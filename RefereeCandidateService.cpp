@@ -0,0 +1,323 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <QStringList>
+
+#include "RefereeCandidateService.h"
+#include "TournamentDB.h"
+#include "PlayerScheduleIndex.h"
+#include "CentralSignalEmitter.h"
+#include "Player.h"
+#include "Team.h"
+
+namespace QTournament
+{
+
+  RefereeCandidateService::RefereeCandidateService(TournamentDB* _db)
+    :QObject(), db(_db), isLoaded{false}, isSorted{false}
+  {
+    if (!(db->needsChangeNotifications())) return;
+
+    CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+
+    // incremental updates
+    connect(cse, SIGNAL(playerRenamed(Player)), this, SLOT(onPlayerChanged(Player)), Qt::DirectConnection);
+    connect(cse, SIGNAL(playerStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onPlayerStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+    connect(cse, SIGNAL(playerRefereeCountChanged(int,int)),
+            this, SLOT(onPlayerRefereeCountChanged(int,int)), Qt::DirectConnection);
+    connect(cse, SIGNAL(teamAssignmentChanged(Player,Team,Team)),
+            this, SLOT(onTeamAssignmentChanged(Player,Team,Team)), Qt::DirectConnection);
+    connect(cse, SIGNAL(matchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onMatchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+
+    // events that affect all players
+    connect(cse, SIGNAL(endCreatePlayer(int)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endDeletePlayer()), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(teamRenamed(int)), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onObjectsCreatedOrDeleted()), Qt::DirectConnection);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Returns the data of all potential referees.
+   *
+   * @param teamId if positive, only members of this team are returned
+   * @param idlePlayersOnly if true, only players in state IDLE are returned
+   *
+   * @return a list of candidates, sorted by display name
+   */
+  vector<RefereeCandidate> RefereeCandidateService::getCandidates(int teamId, bool idlePlayersOnly)
+  {
+    if (!isLoaded) loadCandidates();
+    if (!isSorted) sortCandidates();
+
+    PlayerScheduleIndex* psi = db->getPlayerScheduleIndex();
+
+    vector<RefereeCandidate> result;
+    result.reserve(sortedPlayerIds.size());
+    for (int playerId : sortedPlayerIds)
+    {
+      const RefereeCandidate& rc = playerId2Candidate.at(playerId);
+
+      if ((teamId > 0) && (rc.teamId != teamId)) continue;
+      if (idlePlayersOnly && (rc.state != STAT_PL_IDLE)) continue;
+
+      result.push_back(rc);
+      result.back().nextMatchNumber = psi->getNextMatchNumber(playerId);
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  bool RefereeCandidateService::getCandidate(int playerId, RefereeCandidate& out)
+  {
+    if (!isLoaded) loadCandidates();
+
+    auto it = playerId2Candidate.find(playerId);
+    if (it == playerId2Candidate.end()) return false;
+
+    out = it->second;
+    out.nextMatchNumber = db->getPlayerScheduleIndex()->getNextMatchNumber(playerId);
+
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::invalidateAll()
+  {
+    playerId2Candidate.clear();
+    sortedPlayerIds.clear();
+    isLoaded = false;
+    isSorted = false;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::onPlayerChanged(const Player& p)
+  {
+    if (!isLoaded) return;
+    loadCandidates({p.getId()});
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::onPlayerStatusChanged(int playerId, int, OBJ_STATE, OBJ_STATE toState)
+  {
+    if (!isLoaded) return;
+
+    auto it = playerId2Candidate.find(playerId);
+    if (it == playerId2Candidate.end()) return;
+
+    it->second.state = toState;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::onPlayerRefereeCountChanged(int playerId, int)
+  {
+    if (!isLoaded) return;
+    loadCandidates({playerId});
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::onTeamAssignmentChanged(const Player& p, const Team&, const Team&)
+  {
+    if (!isLoaded) return;
+    loadCandidates({p.getId()});
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::onMatchStatusChanged(int matchId, int, OBJ_STATE fromState, OBJ_STATE toState)
+  {
+    if (!isLoaded) return;
+
+    // faked state changes don't modify the finish time or the referee count
+    if (fromState == toState) return;
+
+    // only calling, finishing or undoing a match call affects the referee
+    // count or the last finish time of the involved players
+    bool isRelevant = false;
+    for (OBJ_STATE stat : {fromState, toState})
+    {
+      if ((stat == STAT_MA_RUNNING) || (stat == STAT_MA_FINISHED)) isRelevant = true;
+    }
+    if (!isRelevant) return;
+
+    QString sql = "SELECT COALESCE(%1, -1), COALESCE(%2, -1), COALESCE(%3, -1), COALESCE(%4, -1), COALESCE(%5, -1) "
+                  "FROM %6 WHERE id = %7";
+    sql = sql.arg(MA_ACTUAL_PLAYER1A_REF).arg(MA_ACTUAL_PLAYER1B_REF);
+    sql = sql.arg(MA_ACTUAL_PLAYER2A_REF).arg(MA_ACTUAL_PLAYER2B_REF);
+    sql = sql.arg(MA_REFEREE_REF).arg(TAB_MATCH).arg(matchId);
+
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if ((stmt == nullptr) || !(stmt->hasData()))
+    {
+      invalidateAll();
+      return;
+    }
+
+    vector<int> affectedPlayers;
+    for (int col = 0; col < 5; ++col)
+    {
+      int playerId;
+      stmt->getInt(col, &playerId);
+      if (playerId > 0) affectedPlayers.push_back(playerId);
+    }
+    if (affectedPlayers.empty()) return;
+
+    loadCandidates(affectedPlayers);
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::onObjectsCreatedOrDeleted()
+  {
+    invalidateAll();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Reads the attributes of a list of players or of all players.
+   *
+   * @param playerIds the players to (re-)load; an empty list means "all players"
+   */
+  void RefereeCandidateService::loadCandidates(const vector<int>& playerIds)
+  {
+    bool loadAll = playerIds.empty();
+    if (loadAll) invalidateAll();
+
+    QString playerFilter;
+    if (!loadAll)
+    {
+      QStringList ids;
+      for (int id : playerIds) ids.append(QString::number(id));
+      playerFilter = ids.join(",");
+    }
+
+    // step 1: names, teams, states and referee counts
+    QString sql = "SELECT pl.id, pl.%1, pl.%2, COALESCE(pl.%3, -1), COALESCE(t.%4, ''), pl.%5, pl.%6 "
+                  "FROM %7 pl LEFT JOIN %8 t ON t.id = pl.%3";
+    sql = sql.arg(PL_FNAME).arg(PL_LNAME).arg(PL_TEAM_REF).arg(GENERIC_NAME_FIELD_NAME);
+    sql = sql.arg(GENERIC_STATE_FIELD_NAME).arg(PL_REFEREE_COUNT);
+    sql = sql.arg(TAB_PLAYER).arg(TAB_TEAM);
+    if (!loadAll) sql += " WHERE pl.id IN (" + playerFilter + ")";
+
+    auto stmt = db->execContentQuery(sql.toUtf8().constData());
+    if (stmt == nullptr)
+    {
+      invalidateAll();   // try again upon the next access
+      return;
+    }
+    while (stmt->hasData())
+    {
+      RefereeCandidate rc;
+      string fn;
+      string ln;
+      string tn;
+      int stateId;
+
+      stmt->getInt(0, &rc.playerId);
+      stmt->getString(1, &fn);
+      stmt->getString(2, &ln);
+      stmt->getInt(3, &rc.teamId);
+      stmt->getString(4, &tn);
+      stmt->getInt(5, &stateId);
+      stmt->getInt(6, &rc.refereeCount);
+
+      rc.displayName = QString::fromUtf8(ln.c_str()) + ", " + QString::fromUtf8(fn.c_str());
+      rc.teamName = QString::fromUtf8(tn.c_str());
+      rc.state = static_cast<OBJ_STATE>(stateId);
+      rc.nextMatchNumber = -1;
+
+      playerId2Candidate[rc.playerId] = rc;
+
+      stmt->step();
+    }
+
+    // step 2: the latest finish time of all matches
+    // in which the players actually played
+    sql = "SELECT pid, MAX(ft) FROM ("
+          "SELECT %1 AS pid, %5 AS ft FROM %6 WHERE %5 IS NOT NULL UNION ALL "
+          "SELECT %2 AS pid, %5 AS ft FROM %6 WHERE %5 IS NOT NULL UNION ALL "
+          "SELECT %3 AS pid, %5 AS ft FROM %6 WHERE %5 IS NOT NULL UNION ALL "
+          "SELECT %4 AS pid, %5 AS ft FROM %6 WHERE %5 IS NOT NULL"
+          ") WHERE pid IS NOT NULL";
+    sql = sql.arg(MA_ACTUAL_PLAYER1A_REF).arg(MA_ACTUAL_PLAYER1B_REF);
+    sql = sql.arg(MA_ACTUAL_PLAYER2A_REF).arg(MA_ACTUAL_PLAYER2B_REF);
+    sql = sql.arg(MA_FINISH_TIME).arg(TAB_MATCH);
+    if (!loadAll) sql += " AND pid IN (" + playerFilter + ")";
+    sql += " GROUP BY pid";
+
+    stmt = db->execContentQuery(sql.toUtf8().constData());
+    if (stmt == nullptr)
+    {
+      invalidateAll();
+      return;
+    }
+    while (stmt->hasData())
+    {
+      int playerId;
+      int epochSecs;
+      stmt->getInt(0, &playerId);
+      stmt->getInt(1, &epochSecs);
+
+      auto it = playerId2Candidate.find(playerId);
+      if (it != playerId2Candidate.end())
+      {
+        it->second.lastFinishTime = QDateTime::fromTime_t(static_cast<uint>(epochSecs));
+      }
+
+      stmt->step();
+    }
+
+    isLoaded = true;
+    isSorted = false;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void RefereeCandidateService::sortCandidates()
+  {
+    sortedPlayerIds.clear();
+    sortedPlayerIds.reserve(playerId2Candidate.size());
+    for (const auto& p : playerId2Candidate)
+    {
+      sortedPlayerIds.push_back(p.first);
+    }
+
+    std::sort(sortedPlayerIds.begin(), sortedPlayerIds.end(), [this](int id1, int id2) {
+      const QString& n1 = playerId2Candidate.at(id1).displayName;
+      const QString& n2 = playerId2Candidate.at(id2).displayName;
+      if (n1 != n2) return (n1 < n2);
+      return (id1 < id2);
+    });
+
+    isSorted = true;
+  }
+
+}
@@ -0,0 +1,105 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REFEREECANDIDATESERVICE_H
+#define REFEREECANDIDATESERVICE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+#include <QDateTime>
+
+#include "TournamentDataDefs.h"
+
+using namespace std;
+
+namespace QTournament
+{
+  // forward
+  class TournamentDB;
+  class Player;
+  class Team;
+
+  // everything the referee selection needs to know about a player
+  struct RefereeCandidate
+  {
+    int playerId;
+    QString displayName;
+    int teamId;   // -1 if the player has no team
+    QString teamName;
+    OBJ_STATE state;
+    int refereeCount;
+    QDateTime lastFinishTime;   // invalid if the player hasn't finished a match yet
+    int nextMatchNumber;   // -1 if the player has no scheduled match
+  };
+
+  /**
+   * Provides the attributes of all potential referees without
+   * issuing any queries per player.
+   *
+   * On first access, the attributes of all players are read with a few
+   * set-based queries. Afterwards, they are kept up to date by listening
+   * to the player, team and match signals of the CentralSignalEmitter:
+   * a changed player or a called or finished match only re-reads the
+   * affected players. The distance to the next match is taken from
+   * the PlayerScheduleIndex.
+   *
+   * There is one instance per tournament database and it is owned by the
+   * TournamentDB object.
+   */
+  class RefereeCandidateService : public QObject
+  {
+    Q_OBJECT
+
+  public:
+    RefereeCandidateService(TournamentDB* _db);
+
+    // all candidates, sorted by display name
+    vector<RefereeCandidate> getCandidates(int teamId = -1, bool idlePlayersOnly = false);
+
+    // a single candidate
+    bool getCandidate(int playerId, RefereeCandidate& out);
+
+    void invalidateAll();
+
+  public slots:
+    void onPlayerChanged(const Player& p);
+    void onPlayerStatusChanged(int playerId, int playerSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onPlayerRefereeCountChanged(int playerId, int playerSeqNum);
+    void onTeamAssignmentChanged(const Player& p, const Team& oldTeam, const Team& newTeam);
+    void onMatchStatusChanged(int matchId, int matchSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onObjectsCreatedOrDeleted();
+
+  protected:
+    void loadCandidates(const vector<int>& playerIds = vector<int>{});
+    void sortCandidates();
+
+  private:
+    TournamentDB* db;
+    bool isLoaded;
+    bool isSorted;
+
+    unordered_map<int, RefereeCandidate> playerId2Candidate;
+    vector<int> sortedPlayerIds;
+  };
+
+}
+
+#endif // REFEREECANDIDATESERVICE_H
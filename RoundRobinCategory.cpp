@@ -69,7 +69,7 @@ namespace QTournament
     }
 
     // make sure we have a valid group configuration
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = getGroupConfig();
     if (!(cfg.isValid(pp.size())))
     {
       return INVALID_KO_CONFIG;
@@ -110,7 +110,7 @@ namespace QTournament
 
     // alright, this is a virgin category. Generate group matches
     // for each group
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = getGroupConfig();
     if (progressNotificationQueue != nullptr)
     {
       progressNotificationQueue->reset(cfg.getNumGroupMatches());
@@ -137,7 +137,7 @@ namespace QTournament
 
     // the following call must succeed, since we made it past the
     // configuration point
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = getGroupConfig();
 
     // the number of rounds is
     // (number of group rounds) + (number of KO rounds)
@@ -198,7 +198,7 @@ namespace QTournament
     //
     // The following call must succeed, since we made it past the
     // configuration point
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = getGroupConfig();
     int groupRounds = cfg.getNumRounds();
 
     RankingMngr rm{db};
@@ -286,7 +286,7 @@ namespace QTournament
     }
 
     // the following call must succeed since we finished at least one round
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = getGroupConfig();
     int numGroupRounds = cfg.getNumRounds();
 
     // three cases for the list of remaining players:
@@ -391,7 +391,7 @@ namespace QTournament
 
     // okay, the list is valid. Now lets generate single-KO matches
     // for the second phase of the tournament
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = getGroupConfig();
     int numGroupRounds = cfg.getNumRounds();
     return generateBracketMatches(BracketGenerator::BRACKET_SINGLE_ELIM, seed, numGroupRounds+1, progressNotificationQueue);
   }
@@ -402,7 +402,7 @@ namespace QTournament
   {
     // have we finished the round robin phase?
     CatRoundStatus crs = getRoundStatus();
-    KO_Config cfg = KO_Config(getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = getGroupConfig();
     int numGroupRounds = cfg.getNumRounds();
     if (crs.getFinishedRoundsCount() < numGroupRounds)
     {
@@ -216,6 +216,11 @@ unique_ptr<GameScore> GameScore::genRandomGame(int winner)
 //----------------MatchScore class--------------------------------------------
 //----------------------------------------------------------------------------
 
+constexpr int MatchScore::PackedScoreBits;
+constexpr int MatchScore::MaxPackedGames;
+
+//----------------------------------------------------------------------------
+
 GameScoreList MatchScore::string2GameScoreList(QString s)
 {
   GameScoreList result;
@@ -334,6 +339,37 @@ unique_ptr<MatchScore> MatchScore::fromGameScoreListWithoutValidation(const Game
 
 //----------------------------------------------------------------------------
 
+/**
+ * Restores a match score from its packed integer representation.
+ *
+ * @param packedScore the packed score as returned by toPackedInt()
+ *
+ * @return the match score or nullptr if the packed value is invalid
+ */
+unique_ptr<MatchScore> MatchScore::fromPackedInt(int packedScore)
+{
+  if (packedScore <= 0) return nullptr;
+
+  constexpr int mask = (1 << PackedScoreBits) - 1;
+
+  GameScoreList gsl;
+  while (packedScore != 0)
+  {
+    int sc1 = packedScore & mask;
+    packedScore >>= PackedScoreBits;
+    int sc2 = packedScore & mask;
+    packedScore >>= PackedScoreBits;
+
+    auto game = GameScore::fromScore(sc1, sc2);
+    if (game == nullptr) return nullptr;
+    gsl.append(*game);
+  }
+
+  return fromGameScoreListWithoutValidation(gsl);
+}
+
+//----------------------------------------------------------------------------
+
 bool MatchScore::addGame(const GameScore& sc)
 {
   games.append(sc);
@@ -368,6 +404,40 @@ QString MatchScore::toString() const
 
 //----------------------------------------------------------------------------
 
+/**
+ * Packs the match score into a single integer without any string
+ * conversion.
+ *
+ * The "end of list" is marked by a 0:0 game which is never a
+ * valid game score.
+ *
+ * @return the packed score or -1 if the score doesn't fit
+ * into the packed representation
+ */
+int MatchScore::toPackedInt() const
+{
+  if (games.isEmpty() || (games.size() > MaxPackedGames)) return -1;
+
+  int result = 0;
+  int shift = 0;
+  for (const GameScore& g : games)
+  {
+    int sc1;
+    int sc2;
+    tie(sc1, sc2) = g.getScore();
+    if ((sc1 >= (1 << PackedScoreBits)) || (sc2 >= (1 << PackedScoreBits))) return -1;
+
+    result |= (sc1 << shift);
+    shift += PackedScoreBits;
+    result |= (sc2 << shift);
+    shift += PackedScoreBits;
+  }
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+
 int MatchScore::getWinner() const
 {
   auto gamesSum = getGameSum();
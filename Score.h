@@ -63,11 +63,13 @@ public:
   static unique_ptr<MatchScore> fromStringWithoutValidation(const QString& s);
   static unique_ptr<MatchScore> fromGameScoreList(const GameScoreList& gsl, int numWinGames=2, bool drawAllowed=false);
   static unique_ptr<MatchScore> fromGameScoreListWithoutValidation(const GameScoreList& gsl);
+  static unique_ptr<MatchScore> fromPackedInt(int packedScore);
   static bool isValidScore(const QString& s, int numWinGames=2, bool drawAllowed=false);
   static bool isValidScore(const GameScoreList& gsl, int numWinGames=2, bool drawAllowed=false);
   bool isValidScore(int numWinGames=2, bool drawAllowed=false) const;
 
   QString toString() const;
+  int toPackedInt() const;
 
   int getWinner() const;
   int getLoser() const;
@@ -86,6 +88,12 @@ public:
 
   static unique_ptr<MatchScore> genRandomScore(int numWinGames=2, bool drawAllowed=false);
 
+  // parameters of the packed integer representation:
+  // each game occupies two fields (player 1, player 2) of
+  // PackedScoreBits bits, starting with the first game at bit 0
+  static constexpr int PackedScoreBits = 5;
+  static constexpr int MaxPackedGames = 3;
+
 private:
   MatchScore() {};
   bool addGame(const GameScore& sc);
@@ -0,0 +1,283 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include <sqlite3.h>
+
+#include <QFile>
+
+#include "SqlProfiler.h"
+
+namespace QTournament
+{
+
+  SqlProfiler::SqlProfiler(sqlite3* _dbHandle)
+    :dbHandle{_dbHandle}, isProfiling{false}, totalStatementCount{0}
+  {
+  }
+
+  //----------------------------------------------------------------------------
+
+  SqlProfiler::~SqlProfiler()
+  {
+    stop();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Starts collecting statistics; already collected statistics are kept.
+   *
+   * @return true if the profiler is active; false if we don't have access to the database connection
+   */
+  bool SqlProfiler::start()
+  {
+    if (dbHandle == nullptr) return false;
+    if (isProfiling) return true;
+
+    int err = sqlite3_trace_v2(dbHandle, SQLITE_TRACE_PROFILE, onTrace, this);
+    isProfiling = (err == SQLITE_OK);
+
+    return isProfiling;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void SqlProfiler::stop()
+  {
+    if (!isProfiling) return;
+
+    sqlite3_trace_v2(dbHandle, 0, nullptr, nullptr);
+    isProfiling = false;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void SqlProfiler::reset()
+  {
+    std::lock_guard<std::mutex> lock{entryMutex};
+    sql2Entry.clear();
+    totalStatementCount = 0;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * @return the number of statements that have been executed since the last reset
+   */
+  long SqlProfiler::getTotalStatementCount() const
+  {
+    std::lock_guard<std::mutex> lock{entryMutex};
+    return totalStatementCount;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * @return all collected statistics, sorted by the total execution time in descending order
+   */
+  vector<SqlProfileEntry> SqlProfiler::getEntries() const
+  {
+    vector<SqlProfileEntry> result;
+
+    {
+      std::lock_guard<std::mutex> lock{entryMutex};
+      result.reserve(sql2Entry.size());
+      for (const auto& e : sql2Entry)
+      {
+        result.push_back(e.second);
+      }
+    }
+
+    std::sort(result.begin(), result.end(), [](const SqlProfileEntry& e1, const SqlProfileEntry& e2)
+    {
+      return (e1.totalNanosecs > e2.totalNanosecs);
+    });
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Writes all collected statistics to a CSV file. Existing files are overwritten.
+   *
+   * @param fName the name of the CSV file
+   *
+   * @return true if the file could be written, false otherwise
+   */
+  bool SqlProfiler::writeCSV(const QString& fName) const
+  {
+    QFile f{fName};
+    if (!(f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)))
+    {
+      return false;
+    }
+
+    string csv{"SQL,Count,Total [ms],Max [ms],Mean [us],Rows scanned\n"};
+    for (const SqlProfileEntry& e : getEntries())
+    {
+      // quote the SQL text and escape any quotes inside it
+      string sql = e.normalizedSql;
+      size_t pos = sql.find('"');
+      while (pos != string::npos)
+      {
+        sql.insert(pos, 1, '"');
+        pos = sql.find('"', pos + 2);
+      }
+
+      csv += "\"" + sql + "\",";
+      csv += to_string(e.count) + ",";
+      csv += to_string(e.totalNanosecs / 1000000.0) + ",";
+      csv += to_string(e.maxNanosecs / 1000000.0) + ",";
+      csv += to_string((e.totalNanosecs / 1000.0) / e.count) + ",";
+      csv += to_string(e.rowsScanned) + "\n";
+    }
+
+    bool isOkay = (f.write(csv.c_str(), csv.size()) == static_cast<qint64>(csv.size()));
+    f.close();
+
+    return isOkay;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Replaces all literals in an SQL statement with "?" and collapses
+   * whitespace. Lists of literals, e.g. in "IN (1, 2, 3)", are
+   * collapsed into a single "?".
+   *
+   * @param sql the SQL text to normalize
+   *
+   * @return the normalized SQL text
+   */
+  string SqlProfiler::normalizeSql(const char* sql)
+  {
+    string result;
+    if (sql == nullptr) return result;
+
+    size_t len = strlen(sql);
+    result.reserve(len);
+
+    size_t i = 0;
+    while (i < len)
+    {
+      char c = sql[i];
+
+      // string literals, including escaped quotes ('')
+      if (c == '\'')
+      {
+        ++i;
+        while (i < len)
+        {
+          if (sql[i] == '\'')
+          {
+            if (((i + 1) < len) && (sql[i + 1] == '\''))
+            {
+              i += 2;
+              continue;
+            }
+            break;
+          }
+          ++i;
+        }
+        ++i;  // skip the closing quote
+        result += '?';
+        continue;
+      }
+
+      // numeric literals that are not part of an identifier
+      bool isIdentChar = (i > 0) && (isalnum(static_cast<unsigned char>(sql[i - 1])) || (sql[i - 1] == '_'));
+      if (isdigit(static_cast<unsigned char>(c)) && !isIdentChar)
+      {
+        while ((i < len) && (isalnum(static_cast<unsigned char>(sql[i])) || (sql[i] == '.'))) ++i;
+        result += '?';
+        continue;
+      }
+
+      if (isspace(static_cast<unsigned char>(c)))
+      {
+        if (!(result.empty()) && (result.back() != ' ')) result += ' ';
+        ++i;
+        continue;
+      }
+
+      result += c;
+      ++i;
+    }
+
+    if (!(result.empty()) && (result.back() == ' ')) result.pop_back();
+
+    // collapse lists of literals
+    for (const string& lst : vector<string>{"?, ?", "?,?"})
+    {
+      size_t pos = result.find(lst);
+      while (pos != string::npos)
+      {
+        result.replace(pos, lst.size(), "?");
+        pos = result.find(lst, pos);
+      }
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  int SqlProfiler::onTrace(unsigned int traceType, void* ctx, void* p, void* x)
+  {
+    if (traceType != SQLITE_TRACE_PROFILE) return 0;
+
+    SqlProfiler* self = static_cast<SqlProfiler*>(ctx);
+    sqlite3_stmt* stmt = static_cast<sqlite3_stmt*>(p);
+    sqlite3_int64 nanosecs = *(static_cast<sqlite3_int64*>(x));
+    self->addSample(stmt, nanosecs);
+
+    return 0;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void SqlProfiler::addSample(sqlite3_stmt* stmt, int64_t nanosecs)
+  {
+    string sql = normalizeSql(sqlite3_sql(stmt));
+
+    // the counter is reset so that re-used statements
+    // don't report the same rows again
+    long rowsScanned = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1);
+
+    std::lock_guard<std::mutex> lock{entryMutex};
+    ++totalStatementCount;
+    auto it = sql2Entry.find(sql);
+    if (it == sql2Entry.end())
+    {
+      sql2Entry[sql] = SqlProfileEntry{sql, 1, nanosecs, nanosecs, rowsScanned};
+      return;
+    }
+
+    SqlProfileEntry& e = it->second;
+    ++e.count;
+    e.totalNanosecs += nanosecs;
+    e.maxNanosecs = std::max(e.maxNanosecs, nanosecs);
+    e.rowsScanned += rowsScanned;
+  }
+
+}
@@ -0,0 +1,94 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SQLPROFILER_H
+#define SQLPROFILER_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QString>
+
+// forward, from sqlite3.h
+struct sqlite3;
+struct sqlite3_stmt;
+
+using namespace std;
+
+namespace QTournament
+{
+  /**
+   * Aggregated execution statistics of all SQL statements
+   * with the same normalized SQL text
+   */
+  struct SqlProfileEntry
+  {
+    string normalizedSql;
+    long count;
+    int64_t totalNanosecs;
+    int64_t maxNanosecs;
+    long rowsScanned;   // steps in full table scans
+  };
+
+  /**
+   * Collects execution statistics for all SQL statements of
+   * a database connection.
+   *
+   * The profiler uses SQLite's statement trace and is inactive
+   * by default; while active, it replaces any other trace
+   * callback on the connection.
+   *
+   * Statements are aggregated by their normalized SQL text, that is
+   * the SQL text with all literals replaced by "?" and collapsed
+   * whitespace.
+   */
+  class SqlProfiler
+  {
+  public:
+    SqlProfiler(sqlite3* _dbHandle);
+    ~SqlProfiler();
+
+    bool start();
+    void stop();
+    bool isActive() const { return isProfiling; }
+
+    void reset();
+    vector<SqlProfileEntry> getEntries() const;
+    long getTotalStatementCount() const;
+    bool writeCSV(const QString& fName) const;
+
+    static string normalizeSql(const char* sql);
+
+  protected:
+    static int onTrace(unsigned int traceType, void* ctx, void* p, void* x);
+    void addSample(sqlite3_stmt* stmt, int64_t nanosecs);
+
+  private:
+    sqlite3* dbHandle;
+    bool isProfiling;
+    mutable std::mutex entryMutex;
+    unordered_map<string, SqlProfileEntry> sql2Entry;
+    long totalStatementCount;
+  };
+
+}
+
+#endif // SQLPROFILER_H
@@ -200,13 +200,17 @@ namespace QTournament
 
     // deletion 3a: matches of future match groups (rounds > last finished round; equivalent to: groups that are not yet FINISHED)
     // deletion 3b: match groups for these future matches
+    //
+    // both are deleted with one statement per table instead of row by row
+    MatchGroupList futureGroups;
     for (const MatchGroup& mg : mm.getMatchGroupsForCat(*this))
     {
       if (mg.getState() != STAT_MG_FINISHED)
       {
-        mm.deleteMatchGroupAndMatch(mg);
+        futureGroups.push_back(mg);
       }
     }
+    ERR e = mm.deleteMatchGroupsAndMatches(futureGroups);
 
     //
     // deletion completed
@@ -215,6 +219,8 @@ namespace QTournament
     // refresh all models and the reports tab
     cse->endResetAllModels();
 
+    if (e != OK) return e;
+
     // update the category status to FINISHED
     CatMngr cm{db};
     cm.updateCatStatusFromMatchStatus(*this);
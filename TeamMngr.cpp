@@ -18,6 +18,8 @@
 
 #include <stdexcept>
 
+#include <QSet>
+
 #include <SqliteOverlay/KeyValueTab.h>
 
 #include "TeamMngr.h"
@@ -81,6 +83,92 @@ namespace QTournament
     return OK;
   }
 
+//----------------------------------------------------------------------------
+
+  /**
+   * Creates a list of teams in a single transaction.
+   *
+   * Names that already exist or that appear more than once in the list
+   * are silently skipped.
+   *
+   * In contrast to createNewTeam(), no signals are emitted for the
+   * new teams. The caller is responsible for resetting all models.
+   *
+   * @param teamNames the names of the teams to create
+   *
+   * @return OK or an error code; in case of errors, no team has been created
+   */
+  ERR TeamMngr::createNewTeams(const QStringList& teamNames)
+  {
+    auto cfg = KeyValueTab::getTab(db, TAB_CFG);
+
+    if (!(cfg->getBool(CFG_KEY_USE_TEAMS)))
+    {
+      return NOT_USING_TEAMS;
+    }
+
+    // read all existing team names at once
+    QSet<QString> knownNames;
+    auto stmt = db->execContentQuery(string{"SELECT "} + GENERIC_NAME_FIELD_NAME + " FROM " + TAB_TEAM);
+    if (stmt == nullptr) return DATABASE_ERROR;
+    while (stmt->hasData())
+    {
+      string n;
+      stmt->getString(0, &n);
+      knownNames.insert(QString::fromUtf8(n.c_str()));
+      stmt->step();
+    }
+
+    // validate all names before we write anything
+    QStringList newNames;
+    for (const QString& tn : teamNames)
+    {
+      QString teamName = tn.trimmed();
+
+      if ((teamName.isEmpty()) || (teamName.length() > MAX_NAME_LEN))
+      {
+        return INVALID_NAME;
+      }
+
+      if (knownNames.contains(teamName)) continue;
+
+      knownNames.insert(teamName);
+      newNames.append(teamName);
+    }
+    if (newNames.isEmpty()) return OK;
+
+    // lock the database before writing
+    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
+
+    // join the caller's transaction, if any (e.g., from importCSV())
+    bool isDbErr = false;
+    unique_ptr<TournamentDB::TransactionGuard> tg;
+    if (!(db->isTransactionRunning())) tg = db->acquireTransactionGuard(false, &isDbErr);
+    if (isDbErr) return DATABASE_ERROR;
+
+    // we assign the sequence numbers directly instead
+    // of fixing them after each insert
+    int nextSeqNum = tab->length();
+    for (const QString& teamName : newNames)
+    {
+      ColumnValueClause cvc;
+      cvc.addStringCol(GENERIC_NAME_FIELD_NAME, teamName.toUtf8().constData());
+      cvc.addIntCol(GENERIC_SEQNUM_FIELD_NAME, nextSeqNum);
+
+      int dbErr;
+      int newId = tab->insertRow(cvc, &dbErr);
+      if ((newId < 1) || (dbErr != SQLITE_DONE))
+      {
+        return DATABASE_ERROR;   // implicit rollback through tg's dtor
+      }
+
+      ++nextSeqNum;
+    }
+
+    bool isOkay = tg ? tg->commit() : true;
+    return isOkay ? OK : DATABASE_ERROR;
+  }
+
 //----------------------------------------------------------------------------
 
   bool TeamMngr::hasTeam(const QString& teamName)
@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QStringList>
 
 #include "TournamentDB.h"
 #include "Team.h"
@@ -42,6 +43,7 @@ namespace QTournament
   public:
     TeamMngr (TournamentDB* _db);
     ERR createNewTeam (const QString& teamName);
+    ERR createNewTeams (const QStringList& teamNames);
     bool hasTeam (const QString& teamName);
     Team getTeam (const QString& name);
     vector<Team> getAllTeams();
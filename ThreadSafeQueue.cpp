@@ -18,6 +18,8 @@
 
 #include "ThreadSafeQueue.h"
 
+constexpr size_t ProgressQueue::Capacity;
+
 
 ProgressQueue::ProgressQueue(int _maxVal)
 {
@@ -27,30 +29,32 @@ ProgressQueue::ProgressQueue(int _maxVal)
   }
 
   maxVal = _maxVal;
-
-  scaleFac = 100.0 / maxVal;
 }
 
 void ProgressQueue::step(int numSteps)
 {
+  if (isCanceled) throw OperationCanceledException{};
   if (numSteps <= 0) return;
 
-  // acquire a lock on the mutex
-  lock_guard<mutex> lk{queueMutex};
-
   // calculate the new value
-  counter += numSteps;
-  if (counter > maxVal) counter = maxVal;
+  int mv = maxVal.load();
+  int cnt = counter.fetch_add(numSteps) + numSteps;
+  if (cnt > mv) cnt = mv;
 
   // map the new value to a 0...100 range and store the it
-  q.push((int)(counter * scaleFac));
-
-  // notify potentially waiting threads that
-  // the queue is not empty anymore
-  emptyCondition.notify_one();
+  push(static_cast<int>(cnt * (100.0 / mv)));
+}
 
-  // lk is automatically unlocked by the
-  // destructor of the lock_guard
+void ProgressQueue::push(int val)
+{
+  // if the queue is full, drop the oldest value and try
+  // again; the consumer is only interested in the latest
+  // values anyway
+  while (!(q.tryPush(val)))
+  {
+    int dummy;
+    q.tryPop(dummy);
+  }
 }
 
 void ProgressQueue::reset(int _maxVal)
@@ -60,14 +64,10 @@ void ProgressQueue::reset(int _maxVal)
     throw std::invalid_argument("Reset: Can't have a max progress value less or equal to zero");
   }
 
-  // acquire a lock on the mutex
-  lock_guard<mutex> lk{queueMutex};
-
   // clear all old items from the list and
   // reinitialize members
-  queue<int> empty;
-  q.swap(empty);
+  int dummy;
+  while (q.tryPop(dummy)) {}
   maxVal = _maxVal;
-  scaleFac = 100.0 / maxVal;
   counter = 0;
 }
@@ -25,6 +25,10 @@
 #include <condition_variable>
 #include <memory>
 #include <cassert>
+#include <atomic>
+#include <stdexcept>
+
+#include "LockFreeQueue.h"
 
 using namespace std;
 
@@ -105,17 +109,54 @@ protected:
 
 using ThreadSafeIntQueue = ThreadSafeQueue<int>;
 
-class ProgressQueue : public ThreadSafeIntQueue
+/**
+ * Thrown by ProgressQueue::step() if the consumer
+ * requested to cancel the running operation
+ */
+class OperationCanceledException : public std::runtime_error
+{
+public:
+  OperationCanceledException()
+    :std::runtime_error("Operation canceled by the user") {}
+};
+
+/**
+ * A queue for progress notifications from a worker to a UI thread.
+ *
+ * Every call to step() pushes the new progress value, mapped to
+ * a 0...100 range. Since only the latest value is of interest for
+ * the consumer, the oldest value is dropped if the queue is full;
+ * thus, neither the producer nor the consumer ever blocks on the
+ * other side and pushing values doesn't allocate any memory.
+ *
+ * The consumer can request to cancel the operation. The next call
+ * to step() then throws an OperationCanceledException that unwinds
+ * the producer's call stack; the producer is responsible for
+ * rolling back any changes it has made so far.
+ */
+class ProgressQueue
 {
 public:
   ProgressQueue(int _maxVal = 100);
   void step(int numSteps = 1);
   void reset(int _maxVal = 100);
 
+  void push(int val);
+  bool hasData() const { return q.hasData(); }
+  bool tryPop(int& out) { return q.tryPop(out); }
+  int blockingPop() { return q.blockingPop(); }
+  size_t popBatch(vector<int>& out, size_t maxCount) { return q.popBatch(out, maxCount); }
+
+  void requestCancel() { isCanceled = true; }
+  bool isCancelRequested() const { return isCanceled; }
+
+  static constexpr size_t Capacity = 256;
+
 private:
-  int maxVal = 100;
-  int counter = 0;
-  double scaleFac = 1.0;
+  BoundedLockFreeQueue<int> q{Capacity};
+  atomic<int> maxVal{100};
+  atomic<int> counter{0};
+  atomic<bool> isCanceled{false};
 };
 
 #endif // THREADSAFEQUEUE_H
@@ -16,11 +16,16 @@
  *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <tuple>
 
+#include <sqlite3.h>
+
 #include <QString>
 #include <QStringList>
 #include <QFile>
+#include <QCoreApplication>
+#include <QThread>
 
 #include <SqliteOverlay/TableCreator.h>
 #include <SqliteOverlay/KeyValueTab.h>
@@ -32,17 +37,113 @@
 #include "HelperFunc.h"
 #include "TournamentErrorCodes.h"
 #include "OnlineMngr.h"
+#include "CatRoundStatusCache.h"
+#include "PlayerScheduleIndex.h"
+#include "RefereeCandidateService.h"
+#include "PairDisplayNameCache.h"
+#include "CatParameterCache.h"
+#include "SqlProfiler.h"
+#include "DbSnapshotPool.h"
+#include "MatchMngr.h"
+#include "Score.h"
 
 namespace QTournament
 {
+  namespace
+  {
+    // copies the complete main database of one connection
+    // into the main database of another connection
+    bool copyDatabase(sqlite3* src, sqlite3* dst, int* dbErr)
+    {
+      if ((src == nullptr) || (dst == nullptr))
+      {
+        if (dbErr != nullptr) *dbErr = SQLITE_MISUSE;
+        return false;
+      }
+
+      sqlite3_backup* bak = sqlite3_backup_init(dst, "main", src, "main");
+      if (bak == nullptr)
+      {
+        if (dbErr != nullptr) *dbErr = sqlite3_errcode(dst);
+        return false;
+      }
+
+      // copy all pages in one step; this can't be interrupted
+      // by other threads because they would have to use the
+      // same connection.
+      //
+      // the source must not have an open transaction, otherwise
+      // this step fails with SQLITE_BUSY
+      sqlite3_backup_step(bak, -1);
+      int err = sqlite3_backup_finish(bak);
+      if (dbErr != nullptr) *dbErr = err;
+
+      return (err == SQLITE_OK);
+    }
+  }
+
+  //----------------------------------------------------------------------------
 
   TournamentDB::TournamentDB(string fName, bool createNew)
-    : SqliteOverlay::SqliteDatabase(fName, createNew), curTrans{nullptr}
+    : TournamentDB(fName, createNew, false)
+  {
+  }
+
+  //----------------------------------------------------------------------------
+
+  TournamentDB::TournamentDB(string fName, bool createNew, bool isSnapshot)
+    : SqliteOverlay::SqliteDatabase(fName, createNew),
+      conn{dbPtr}, isSnapshotConnection{isSnapshot}, isLoggingChanges{false}, isBgOpRunning{false}, curTrans{nullptr}
   {    
-    // initialize the internal instance of the online manager
+    // the SQL profiler for the connection that has just been
+    // opened by the base class; inactive until explicitly started
+    sqlProf = make_unique<SqlProfiler>(conn);
+
+    // initialize the internal instance of the online manager;
+    // snapshots are never synchronized with the server
     //
     // FIX ME: server name and API url hard coded
-    om = make_unique<OnlineMngr>(this);
+    if (!isSnapshotConnection) om = make_unique<OnlineMngr>(this);
+
+    // initialize the cache for the round status counters
+    rsc = make_unique<CatRoundStatusCache>(this);
+
+    // initialize the index of scheduled matches per player
+    psi = make_unique<PlayerScheduleIndex>(this);
+
+    // initialize the data of all potential referees
+    rcs = make_unique<RefereeCandidateService>(this);
+
+    // initialize the cache for the display names of player pairs
+    pdnc = make_unique<PairDisplayNameCache>(this);
+
+    // initialize the cache for the category parameters
+    cpc = make_unique<CatParameterCache>(this);
+
+    // initialize the pool of read-only snapshots; snapshots
+    // of snapshots are not supported
+    if (!isSnapshotConnection) snapPool = make_unique<DbSnapshotPool>(this);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Opens an empty in-memory connection that is used as the target
+   * for a snapshot.
+   *
+   * We don't use SqliteDatabase::get<>() here because the tables don't
+   * have to be created; they are overwritten with the contents of the
+   * source database anyway.
+   *
+   * @return the new connection or nullptr in case of errors
+   */
+  unique_ptr<TournamentDB> TournamentDB::openSnapshotConnection()
+  {
+    unique_ptr<TournamentDB> snap{new TournamentDB(":memory:", true, true)};
+    if (snap->conn == nullptr) return nullptr;
+
+    snap->setLogLevel(Sloppy::Logger::SeverityLevel::error);
+    return snap;
   }
 
   //----------------------------------------------------------------------------
@@ -121,6 +222,49 @@ namespace QTournament
 
   //----------------------------------------------------------------------------
 
+  /**
+   * Creates a private in-memory copy of a tournament database file.
+   *
+   * This is intended for worker threads that need read access to
+   * a consistent state of the tournament (e.g., a file that has been
+   * written with backupToFile()) without touching the main
+   * database connection. Changes to the copy are never written back.
+   *
+   * @param snapshotFileName the file to load
+   * @param err optional pointer to an error code
+   *
+   * @return the database handle or nullptr in case of errors
+   */
+  unique_ptr<TournamentDB> TournamentDB::openSnapshot(const QString& snapshotFileName, ERR* err)
+  {
+    QFile f(snapshotFileName);
+    if (!(f.exists()))
+    {
+      if (err != nullptr) *err = FILE_NOT_EXISTING;
+      return nullptr;
+    }
+
+    auto newDb = openSnapshotConnection();
+    if (newDb == nullptr)
+    {
+      if (err != nullptr) *err = DATABASE_ERROR;
+      return nullptr;
+    }
+
+    int dbErr;
+    newDb->restoreFromFile(snapshotFileName.toUtf8().constData(), &dbErr);
+    if (dbErr != SQLITE_OK)
+    {
+      if (err != nullptr) *err = DATABASE_ERROR;
+      return nullptr;
+    }
+
+    if (err != nullptr) *err = OK;
+    return newDb;
+  }
+
+  //----------------------------------------------------------------------------
+
   void TournamentDB::populateTables()
   {
     SqliteOverlay::TableCreator tc{this};
@@ -211,6 +355,11 @@ namespace QTournament
     tc.addInt(MA_LOSER_RANK);
     tc.addInt(MA_REFEREE_MODE, false, SqliteOverlay::CONFLICT_CLAUSE::__NOT_SET, true, SqliteOverlay::CONFLICT_CLAUSE::ROLLBACK, true, "-1");
     tc.addForeignKey(MA_REFEREE_REF, TAB_PLAYER, SqliteOverlay::CONSISTENCY_ACTION::RESTRICT);
+    tc.addInt(MA_PACKED_RESULT);
+    tc.addInt(MA_GAME_SUM_PAIR1);
+    tc.addInt(MA_GAME_SUM_PAIR2);
+    tc.addInt(MA_POINT_SUM_PAIR1);
+    tc.addInt(MA_POINT_SUM_PAIR2);
     tc.createTableAndResetCreator(TAB_MATCH);
 
     // Generate a table with ranking information
@@ -283,7 +432,6 @@ namespace QTournament
     indexCreationHelper(TAB_P2C, P2C_CAT_REF);
     indexCreationHelper(TAB_P2C, P2C_PLAYER_REF);
 
-    indexCreationHelper(TAB_PAIRS, PAIRS_PLAYER1_REF);
     indexCreationHelper(TAB_PAIRS, PAIRS_PLAYER1_REF);
     indexCreationHelper(TAB_PAIRS, PAIRS_CAT_REF);
 
@@ -308,6 +456,52 @@ namespace QTournament
     indexCreationHelper(TAB_BRACKET_VIS, BV_PAIR2_REF);
 
     //indexCreationHelper(TAB_, );
+
+    createCompositeIndices();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Creates the multi-column indices for the most frequent queries.
+   *
+   * All indices are created with "IF NOT EXISTS", so this function
+   * can safely be called for new databases as well as for the
+   * conversion of existing databases.
+   *
+   * @return true if all indices exist after the call
+   */
+  bool TournamentDB::createCompositeIndices()
+  {
+    // index name, table name, columns
+    vector<tuple<QString, QString, QString>> indices{
+      // the index on PAIRS_PLAYER2_REF has erroneously been
+      // missing in all database versions before 2.5
+      {"PlayerPair_Player2", TAB_PAIRS, PAIRS_PLAYER2_REF},
+      {"PlayerPair_CatGroup", TAB_PAIRS, QString("%1,%2").arg(PAIRS_CAT_REF).arg(PAIRS_GRP_NUM)},
+      {"P2C_CatPlayer", TAB_P2C, QString("%1,%2").arg(P2C_CAT_REF).arg(P2C_PLAYER_REF)},
+
+      // next callable matches: "WHERE State = x AND Number > 0 ORDER BY Number"
+      {"Match_StateNumber", TAB_MATCH, QString("%1,%2").arg(GENERIC_STATE_FIELD_NAME).arg(MA_NUM)},
+      {"Match_Pairs", TAB_MATCH, QString("%1,%2").arg(MA_PAIR1_REF).arg(MA_PAIR2_REF)},
+      {"Match_GroupState", TAB_MATCH, QString("%1,%2").arg(MA_GRP_REF).arg(GENERIC_STATE_FIELD_NAME)},
+
+      {"MatchGroup_CatRoundGroup", TAB_MATCH_GROUP, QString("%1,%2,%3").arg(MG_CAT_REF).arg(MG_ROUND).arg(MG_GRP_NUM)},
+
+      {"Ranking_CatRoundGroup", TAB_RANKING, QString("%1,%2,%3").arg(RA_CAT_REF).arg(RA_ROUND).arg(RA_GRP_NUM)},
+    };
+
+    for (const auto& idx : indices)
+    {
+      QString sql = "CREATE INDEX IF NOT EXISTS %1 ON %2(%3)";
+      sql = sql.arg(get<0>(idx)).arg(get<1>(idx)).arg(get<2>(idx));
+
+      int dbErr;
+      bool isOkay = execNonQuery(sql.toUtf8().constData(), &dbErr);
+      if (!isOkay) return false;
+    }
+
+    return true;
   }
 
   //----------------------------------------------------------------------------
@@ -473,6 +667,55 @@ namespace QTournament
       minor = 3;
     }
 
+    // convert from 2.3 to 2.4
+    if (minor == 3)
+    {
+      // add the columns for the packed score and the score aggregates
+      QString sql_base = "ALTER TABLE %1 ADD COLUMN %2 INTEGER DEFAULT NULL";
+      sql_base = sql_base.arg(TAB_MATCH);
+      for (const QString& col : {MA_PACKED_RESULT, MA_GAME_SUM_PAIR1, MA_GAME_SUM_PAIR2, MA_POINT_SUM_PAIR1, MA_POINT_SUM_PAIR2})
+      {
+        QString sql = sql_base.arg(col);
+        int dbErr;
+        bool isOkay = execNonQuery(sql.toUtf8().constData(), &dbErr);
+        if (!isOkay) return false;
+      }
+
+      // fill the new columns for all existing match results
+      QString sql = "SELECT id, %1 FROM %2 WHERE %1 IS NOT NULL";
+      sql = sql.arg(MA_RESULT).arg(TAB_MATCH);
+      auto stmt = execContentQuery(sql.toUtf8().constData());
+      if (stmt == nullptr) return false;
+      SqliteOverlay::DbTab* matchTab = getTab(TAB_MATCH);
+      while (stmt->hasData())
+      {
+        int maId;
+        string scoreString;
+        stmt->getInt(0, &maId);
+        stmt->getString(1, &scoreString);
+
+        auto score = MatchScore::fromStringWithoutValidation(stdString2QString(scoreString));
+        if (score != nullptr)
+        {
+          SqliteOverlay::ColumnValueClause cvc;
+          MatchMngr::addScoreColumns(*score, cvc);
+          matchTab->operator [](maId).update(cvc);
+        }
+
+        stmt->step();
+      }
+
+      minor = 4;
+    }
+
+    // convert from 2.4 to 2.5
+    if (minor == 4)
+    {
+      if (!(createCompositeIndices())) return false;
+
+      minor = 5;
+    }
+
     // store the new database version
     QString dbVersion = "%1.%2";
     dbVersion = dbVersion.arg(DB_VERSION_MAJOR);
@@ -509,7 +752,15 @@ namespace QTournament
 
     bool isOkay = curTrans->commit(dbErr);
 
-    if (isOkay) curTrans.reset();
+    if (isOkay)
+    {
+      curTrans.reset();
+
+      // the sequence number shifts of this transaction
+      // are now part of the database
+      seqNumShifts.insert(seqNumShifts.end(), pendingSeqNumShifts.begin(), pendingSeqNumShifts.end());
+      pendingSeqNumShifts.clear();
+    }
 
     return isOkay;
   }
@@ -522,7 +773,21 @@ namespace QTournament
 
     bool isOkay = curTrans->rollback(dbErr);
 
-    if (isOkay) curTrans.reset();
+    if (isOkay)
+    {
+      curTrans.reset();
+
+      // the sequence number shifts of this transaction
+      // must never be sent to the server
+      pendingSeqNumShifts.clear();
+
+      // the cached round status counters might contain
+      // changes that have just been rolled back.
+      //
+      // a rollback in a worker thread is handled by the GUI
+      // thread once the worker has finished
+      if (needsChangeNotifications()) invalidateCaches();
+    }
 
     return isOkay;
   }
@@ -536,6 +801,205 @@ namespace QTournament
 
   //----------------------------------------------------------------------------
 
+  CatRoundStatusCache* TournamentDB::getRoundStatusCache()
+  {
+    return rsc.get();
+  }
+
+  //----------------------------------------------------------------------------
+
+  PlayerScheduleIndex* TournamentDB::getPlayerScheduleIndex()
+  {
+    return psi.get();
+  }
+
+  //----------------------------------------------------------------------------
+
+  RefereeCandidateService* TournamentDB::getRefereeCandidateService()
+  {
+    return rcs.get();
+  }
+
+  //----------------------------------------------------------------------------
+
+  PairDisplayNameCache* TournamentDB::getPairDisplayNameCache()
+  {
+    return pdnc.get();
+  }
+
+  //----------------------------------------------------------------------------
+
+  CatParameterCache* TournamentDB::getCatParameterCache()
+  {
+    return cpc.get();
+  }
+
+  //----------------------------------------------------------------------------
+
+  SqlProfiler* TournamentDB::getSqlProfiler()
+  {
+    return sqlProf.get();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Creates a read-only, private in-memory copy of the current state
+   * of this database.
+   *
+   * The copy can be handed over to a worker thread and used there
+   * without any locking, while the main thread continues to
+   * modify this database. Uncommitted changes can't be copied, so there
+   * must be no running transaction.
+   *
+   * Usually, snapshots should be obtained from the snapshot pool
+   * which recycles snapshots that are no longer used.
+   *
+   * @param err optional pointer to an error code
+   *
+   * @return the database handle of the snapshot or nullptr in case of errors
+   */
+  unique_ptr<TournamentDB> TournamentDB::createReadSnapshot(ERR* err)
+  {
+    if (isTransactionRunning())
+    {
+      if (err != nullptr) *err = DATABASE_ERROR;
+      return nullptr;
+    }
+
+    auto snap = openSnapshotConnection();
+    if (snap == nullptr)
+    {
+      if (err != nullptr) *err = DATABASE_ERROR;
+      return nullptr;
+    }
+
+    if (!(refreshReadSnapshot(snap.get())))
+    {
+      if (err != nullptr) *err = DATABASE_ERROR;
+      return nullptr;
+    }
+
+    // refuse all write attempts
+    snap->execNonQuery("PRAGMA query_only = 1");
+
+    if (err != nullptr) *err = OK;
+    return snap;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Overwrites the contents of an existing snapshot with the
+   * current state of this database.
+   *
+   * @param snap a snapshot that has been created with createReadSnapshot()
+   *
+   * @return true if the snapshot has been updated, false otherwise
+   */
+  bool TournamentDB::refreshReadSnapshot(TournamentDB* snap)
+  {
+    if ((snap == nullptr) || (snap == this) || !(snap->isSnapshot())) return false;
+    if (isTransactionRunning()) return false;
+
+    int dbErr;
+    if (!(copyDatabase(conn, snap->conn, &dbErr))) return false;
+
+    // anything that the snapshot has cached so far is outdated
+    snap->invalidateCaches();
+
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+
+  DbSnapshotPool* TournamentDB::getSnapshotPool()
+  {
+    return snapPool.get();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Tells the caches of this connection (round status, referee candidates,
+   * player schedule, pair names, ...) whether they have to connect to the
+   * signals of the CentralSignalEmitter.
+   *
+   * The CentralSignalEmitter only reports changes of the main database
+   * connection that are made by the main thread. Snapshot connections never
+   * change and connections that are created in a worker thread can't receive
+   * the signals anyway, so their caches don't connect to any signals and are
+   * only valid for the lifetime of the connection.
+   *
+   * @return true if this database is modified by the main thread and thus
+   * its caches need to listen to the signals of the CentralSignalEmitter
+   */
+  bool TournamentDB::needsChangeNotifications() const
+  {
+    if (isSnapshotConnection) return false;
+
+    // the CentralSignalEmitter only reports changes that
+    // are made by the main thread
+    QCoreApplication* app = QCoreApplication::instance();
+    return ((app == nullptr) || (app->thread() == QThread::currentThread()));
+  }
+
+  //----------------------------------------------------------------------------
+
+  int TournamentDB::getTotalChangeCount() const
+  {
+    return (conn == nullptr) ? 0 : sqlite3_total_changes(conn);
+  }
+
+  //----------------------------------------------------------------------------
+
+  void TournamentDB::setBackgroundOperationRunning(bool isRunning)
+  {
+    // the id has to be valid before the flag is set
+    if (isRunning) bgOpGuiThreadId = std::this_thread::get_id();
+    isBgOpRunning = isRunning;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Determines the role for a lock on the database.
+   *
+   * While a background operation is running, requests for the MainThread
+   * role from any thread other than the GUI thread come from the worker
+   * and are thus mapped to the BackgroundThread role.
+   *
+   * @param requestedRole the role as requested by the caller
+   *
+   * @return the role that should actually be used for the lock
+   */
+  DatabaseAccessRoles TournamentDB::getEffectiveAccessRole(DatabaseAccessRoles requestedRole) const
+  {
+    if ((requestedRole != DatabaseAccessRoles::MainThread) || !isBgOpRunning) return requestedRole;
+
+    return (std::this_thread::get_id() == bgOpGuiThreadId) ? requestedRole : DatabaseAccessRoles::BackgroundThread;
+  }
+
+  //----------------------------------------------------------------------------
+
+  DbLockHolder::DbLockHolder(TournamentDB* db, DatabaseAccessRoles role, bool waitForLock)
+    :SqliteOverlay::DatabaseLockHolder<DatabaseAccessRoles>(db, db->getEffectiveAccessRole(role), waitForLock)
+  {
+  }
+
+  //----------------------------------------------------------------------------
+
+  void TournamentDB::invalidateCaches()
+  {
+    rsc->invalidateAll();
+    psi->invalidateAll();
+    rcs->invalidateAll();
+    pdnc->invalidateAll();
+    cpc->invalidateAll();
+  }
+
+  //----------------------------------------------------------------------------
+
   unique_ptr<TournamentDB::TransactionGuard> TournamentDB::acquireTransactionGuard(bool commitOnDestruction, bool* isDbErr, bool* transRunning)
   {
     if (curTrans != nullptr)
@@ -652,6 +1116,221 @@ namespace QTournament
 
   //----------------------------------------------------------------------------
 
+  void TournamentDB::enableChangeLog(bool clearLog)
+  {
+    SqliteOverlay::SqliteDatabase::enableChangeLog(clearLog);
+    isLoggingChanges = true;
+    if (clearLog)
+    {
+      seqNumShifts.clear();
+      pendingSeqNumShifts.clear();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  void TournamentDB::disableChangeLog(bool clearLog)
+  {
+    SqliteOverlay::SqliteDatabase::disableChangeLog(clearLog);
+    isLoggingChanges = false;
+    if (clearLog)
+    {
+      seqNumShifts.clear();
+      pendingSeqNumShifts.clear();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Decrements the sequence numbers of all rows behind a deleted row
+   * using set-based UPDATEs instead of one UPDATE per row.
+   *
+   * The renumbering is not recorded in the change log row by row;
+   * instead, a single SeqNumShift is recorded if the change log is enabled.
+   *
+   * @param tabName the name of the table that contained the deleted row
+   * @param deletedSeqNum the sequence number of the deleted row
+   * @param dbErr optional pointer to the SQLite error code
+   *
+   * @return true on success, false otherwise (including an empty table name)
+   */
+  bool TournamentDB::closeSeqNumGap(const string& tabName, int deletedSeqNum, int* dbErr)
+  {
+    if (tabName.empty())
+    {
+      if (dbErr != nullptr) *dbErr = SQLITE_MISUSE;
+      return false;
+    }
+
+    bool isDbErr;
+    auto tg = acquireTransactionGuard(false, &isDbErr);
+    if (isDbErr) return false;
+
+    // the sequence numbers are protected by a UNIQUE index that is
+    // checked row by row and SQLite doesn't guarantee that the rows
+    // are updated in ascending order. So we first move all affected
+    // rows to the otherwise unused negative range and then we
+    // move them back, shifted by one.
+    QString sql1 = "UPDATE %1 SET %2 = -%2 WHERE %2 > %3";
+    sql1 = sql1.arg(QString::fromUtf8(tabName.c_str())).arg(GENERIC_SEQNUM_FIELD_NAME).arg(deletedSeqNum);
+    QString sql2 = "UPDATE %1 SET %2 = -%2 - 1 WHERE %2 < 0";
+    sql2 = sql2.arg(QString::fromUtf8(tabName.c_str())).arg(GENERIC_SEQNUM_FIELD_NAME);
+
+    // the shifted rows don't contain any other changes, so
+    // we suspend the row-wise change log
+    bool wasLogging = isLoggingChanges;
+    if (wasLogging) SqliteOverlay::SqliteDatabase::disableChangeLog(false);
+
+    bool isOkay = execNonQuery(sql1.toUtf8().constData(), dbErr);
+    if (isOkay) isOkay = execNonQuery(sql2.toUtf8().constData(), dbErr);
+    int nShifted = isOkay ? sqlite3_changes(conn) : 0;
+
+    if (wasLogging) SqliteOverlay::SqliteDatabase::enableChangeLog(false);
+
+    if (!isOkay) return false;  // implicit rollback through tg's dtor
+
+    // the shift is only queued for the server when the
+    // transaction is committed (see commitRunningTransaction())
+    if (wasLogging && (nShifted > 0))
+    {
+      pendingSeqNumShifts.push_back(SeqNumShift{tabName, deletedSeqNum + 1, -1});
+    }
+
+    return (tg == nullptr) || tg->commit(dbErr);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Renumbers the sequence numbers after several rows have been deleted
+   * from a table, e.g. by a single set-based DELETE statement.
+   *
+   * The new sequence numbers are determined by one ordered INSERT into a
+   * temporary table and are then applied with set-based UPDATEs, so the
+   * effort doesn't depend on the number of deleted rows.
+   *
+   * The renumbering is recorded in the change log as one SeqNumShift
+   * per deleted row instead of one update per shifted row.
+   *
+   * @param tabName the name of the table that contained the deleted rows
+   * @param deletedSeqNums the sequence numbers of all deleted rows
+   * @param dbErr optional pointer to the SQLite error code
+   *
+   * @return true on success, false otherwise (including an empty table name)
+   */
+  bool TournamentDB::closeSeqNumGaps(const string& tabName, vector<int> deletedSeqNums, int* dbErr)
+  {
+    if (tabName.empty())
+    {
+      if (dbErr != nullptr) *dbErr = SQLITE_MISUSE;
+      return false;
+    }
+    if (deletedSeqNums.empty()) return true;
+    if (deletedSeqNums.size() == 1) return closeSeqNumGap(tabName, deletedSeqNums[0], dbErr);
+
+    bool isDbErr;
+    auto tg = acquireTransactionGuard(false, &isDbErr);
+    if (isDbErr) return false;
+
+    std::sort(deletedSeqNums.begin(), deletedSeqNums.end());
+    QString tn = QString::fromUtf8(tabName.c_str());
+
+    // step 1: the new sequence number of each row is its rowid in
+    // a temporary table that is filled in the order of the old
+    // sequence numbers
+    QStringList sqlList;
+    sqlList << "CREATE TEMP TABLE IF NOT EXISTS SeqNumMap (NewSeqNum INTEGER PRIMARY KEY, RowId INTEGER UNIQUE)";
+    sqlList << "DELETE FROM temp.SeqNumMap";
+    sqlList << QString{"INSERT INTO temp.SeqNumMap (RowId) SELECT id FROM %1 ORDER BY %2"}.arg(tn).arg(GENERIC_SEQNUM_FIELD_NAME);
+
+    // step 2: move all rows behind the first gap to the negative
+    // range to avoid conflicts with the UNIQUE index (see closeSeqNumGap())
+    // and then assign the new numbers
+    QString sql = "UPDATE %1 SET %2 = -1 - %2 WHERE %2 > %3";
+    sqlList << sql.arg(tn).arg(GENERIC_SEQNUM_FIELD_NAME).arg(deletedSeqNums[0]);
+    sql = "UPDATE %1 SET %2 = (SELECT NewSeqNum - 1 FROM temp.SeqNumMap WHERE RowId = %1.id) WHERE %2 < 0";
+    sqlList << sql.arg(tn).arg(GENERIC_SEQNUM_FIELD_NAME);
+    sqlList << "DELETE FROM temp.SeqNumMap";
+
+    // the shifted rows don't contain any other changes, so
+    // we suspend the row-wise change log
+    bool wasLogging = isLoggingChanges;
+    if (wasLogging) SqliteOverlay::SqliteDatabase::disableChangeLog(false);
+
+    bool isOkay = true;
+    for (const QString& s : sqlList)
+    {
+      isOkay = execNonQuery(s.toUtf8().constData(), dbErr);
+      if (!isOkay) break;
+    }
+
+    if (wasLogging) SqliteOverlay::SqliteDatabase::enableChangeLog(false);
+
+    if (!isOkay) return false;  // implicit rollback through tg's dtor
+
+    // closing the gaps one by one from the end of the table
+    // yields the same result as the renumbering above
+    if (wasLogging)
+    {
+      for (auto it = deletedSeqNums.rbegin(); it != deletedSeqNums.rend(); ++it)
+      {
+        pendingSeqNumShifts.push_back(SeqNumShift{tabName, *it + 1, -1});
+      }
+    }
+
+    return (tg == nullptr) || tg->commit(dbErr);
+  }
+
+  //----------------------------------------------------------------------------
+
+  vector<SeqNumShift> TournamentDB::getSeqNumShiftsAndClearQueue()
+  {
+    vector<SeqNumShift> result;
+    std::swap(result, seqNumShifts);
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Converts a list of sequence number shifts into a sync string
+   * with the same layout as the sync strings for regular tables
+   * ("name:count", column names, one CSV line per entry)
+   *
+   * Each entry means "add `delta` to the sequence number of all rows
+   * in `tabName` with a sequence number >= `firstSeqNum`". The entries
+   * have to be applied in the given order, after the deletions and
+   * before the inserted or updated rows of the same sync. This is
+   * because the shifts refer to the rows as they were at the time
+   * of each deletion, while inserted and updated rows already carry
+   * their final sequence numbers.
+   *
+   * A partial sync is thus always composed of:
+   *   1. the row deletions (negative row IDs) of all tables
+   *   2. the SeqNumShift section (if any)
+   *   3. the inserted and updated rows of all tables
+   *
+   * @return the sync string or an empty string if the list is empty
+   */
+  string TournamentDB::getSyncStringForSeqNumShifts(const vector<SeqNumShift>& shifts)
+  {
+    if (shifts.empty()) return "";
+
+    string result = "SeqNumShift:%1\ntabName,firstSeqNum,delta\n";
+    Sloppy::strArg(result, static_cast<int>(shifts.size()));
+
+    for (const SeqNumShift& s : shifts)
+    {
+      result += s.tabName + "," + to_string(s.firstSeqNum) + "," + to_string(s.delta) + "\n";
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
   TournamentDB::TransactionGuard::TransactionGuard(TournamentDB* _db, bool _commitOnDestruction)
     :db{_db}, commitOnDestruction{_commitOnDestruction}
   {
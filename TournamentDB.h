@@ -20,10 +20,15 @@
 #define	TOURNAMENTDB_H
 
 #include <tuple>
+#include <atomic>
+#include <thread>
 
 #include <SqliteOverlay/SqliteDatabase.h>
 #include <SqliteOverlay/Transaction.h>
 
+// forward, from sqlite3.h
+struct sqlite3;
+
 #include "TournamentDataDefs.h"
 #include "TournamentErrorCodes.h"
 
@@ -31,6 +36,14 @@ namespace QTournament
 {
   // forward
   class OnlineMngr;
+  class CatRoundStatusCache;
+  class PlayerScheduleIndex;
+  class RefereeCandidateService;
+  class PairDisplayNameCache;
+  class CatParameterCache;
+  class SqlProfiler;
+  class DbSnapshotPool;
+  class TournamentDB;
 
   enum class TransactionState
   {
@@ -43,8 +56,37 @@ namespace QTournament
   {
     MainThread,
     SyncThread,
+    BackgroundThread,   // a worker thread that modifies the database
+  };
+
+  /**
+   * A lock on the tournament database.
+   *
+   * While a background operation is running, requests for the MainThread
+   * role that come from the worker thread are mapped to the
+   * BackgroundThread role. Thus, the worker can call all the usual
+   * manager functions while the GUI thread and the sync with the
+   * server are locked out.
+   */
+  class DbLockHolder : public SqliteOverlay::DatabaseLockHolder<DatabaseAccessRoles>
+  {
+  public:
+    DbLockHolder(TournamentDB* db, DatabaseAccessRoles role, bool waitForLock = true);
+  };
+
+  /**
+   * A change of the sequence numbers of all rows in a table
+   * that had a sequence number of "firstSeqNum" or higher; the
+   * sequence numbers of these rows have been changed by "delta".
+   *
+   * Used instead of one change log entry per shifted row.
+   */
+  struct SeqNumShift
+  {
+    string tabName;
+    int firstSeqNum;
+    int delta;
   };
-  using DbLockHolder = SqliteOverlay::DatabaseLockHolder<DatabaseAccessRoles>;
 
   class TournamentDB : public SqliteOverlay::SqliteDatabase
   {
@@ -53,10 +95,12 @@ namespace QTournament
   public:
     static unique_ptr<TournamentDB> createNew(const QString& fName, const TournamentSettings& cfg, ERR* err=nullptr);
     static unique_ptr<TournamentDB> openExisting(const QString& fName, ERR* err=nullptr);
+    static unique_ptr<TournamentDB> openSnapshot(const QString& snapshotFileName, ERR* err=nullptr);
 
     virtual void populateTables();
     virtual void populateViews();
     void createIndices();
+    bool createCompositeIndices();
 
     tuple<int, int> getVersion();
 
@@ -72,9 +116,54 @@ namespace QTournament
     bool commitRunningTransaction(int* dbErr = nullptr);
     bool rollbackRunningTransaction(int* dbErr = nullptr);
 
-    // access to the tournament-wide instance of the OnlineMngr
+    // access to the tournament-wide instance of the OnlineMngr;
+    // nullptr for snapshots
     OnlineMngr* getOnlineManager();
 
+    // access to the tournament-wide cache of round status counters
+    CatRoundStatusCache* getRoundStatusCache();
+
+    // access to the tournament-wide index of scheduled matches per player
+    PlayerScheduleIndex* getPlayerScheduleIndex();
+
+    // access to the tournament-wide data of all potential referees
+    RefereeCandidateService* getRefereeCandidateService();
+
+    // access to the tournament-wide cache of player pair display names
+    PairDisplayNameCache* getPairDisplayNameCache();
+
+    // access to the tournament-wide cache of category parameters
+    CatParameterCache* getCatParameterCache();
+
+    // access to the (optional) profiling of all SQL statements
+    SqlProfiler* getSqlProfiler();
+
+    // read-only snapshots of the current database state for
+    // background tasks; only to be called from the main thread.
+    // Snapshots themselves don't have a snapshot pool
+    unique_ptr<TournamentDB> createReadSnapshot(ERR* err = nullptr);
+    bool refreshReadSnapshot(TournamentDB* snap);
+    DbSnapshotPool* getSnapshotPool();
+
+    // snapshots never change, so they don't need any change
+    // notifications from the CentralSignalEmitter
+    bool isSnapshot() const { return isSnapshotConnection; }
+    bool needsChangeNotifications() const;
+
+    // number of rows modified through this connection since it
+    // has been opened; used for detecting outdated snapshots
+    int getTotalChangeCount() const;
+
+    // set by the GUI thread while a worker thread modifies the
+    // database; the GUI must not touch the database or any of
+    // the caches until the flag has been cleared again
+    void setBackgroundOperationRunning(bool isRunning);
+    bool isBackgroundOperationRunning() const { return isBgOpRunning; }
+    DatabaseAccessRoles getEffectiveAccessRole(DatabaseAccessRoles requestedRole) const;
+
+    // drops all cached data; only to be called from the GUI thread
+    void invalidateCaches();
+
     class TransactionGuard
     {
     public:
@@ -96,12 +185,57 @@ namespace QTournament
     string getSyncStringForTable(const string& tabName, const vector<string>& colNames, int rowId=-1);
     string getSyncStringForTable(const string& tabName, const vector<string>& colNames, vector<int> rowList);
 
+    // wrappers for the change log of the base class that keep
+    // track of whether the log is currently enabled
+    void enableChangeLog(bool clearLog);
+    void disableChangeLog(bool clearLog);
+    bool isChangeLogEnabled() const { return isLoggingChanges; }
+
+    // closing the gaps in the sequence numbers after row deletions;
+    // logged as SeqNumShifts instead of one update per shifted row
+    bool closeSeqNumGap(const string& tabName, int deletedSeqNum, int* dbErr = nullptr);
+    bool closeSeqNumGaps(const string& tabName, vector<int> deletedSeqNums, int* dbErr = nullptr);
+    vector<SeqNumShift> getSeqNumShiftsAndClearQueue();
+    string getSyncStringForSeqNumShifts(const vector<SeqNumShift>& shifts);
+
   private:
     TournamentDB(string fName, bool createNew);
+    TournamentDB(string fName, bool createNew, bool isSnapshot);
+    static unique_ptr<TournamentDB> openSnapshotConnection();
+
+    // the raw handle of the connection, as opened by the base class
+    sqlite3* conn;
+
+    bool isSnapshotConnection;
+
+    bool isLoggingChanges;
+
+    atomic<bool> isBgOpRunning;
+    std::thread::id bgOpGuiThreadId;
+
+    vector<SeqNumShift> seqNumShifts;
+
+    // shifts of the running transaction; they are moved to
+    // seqNumShifts on commit and dropped on rollback
+    vector<SeqNumShift> pendingSeqNumShifts;
 
     unique_ptr<SqliteOverlay::Transaction> curTrans;
 
     unique_ptr<OnlineMngr> om;
+
+    unique_ptr<CatRoundStatusCache> rsc;
+
+    unique_ptr<PlayerScheduleIndex> psi;
+
+    unique_ptr<RefereeCandidateService> rcs;
+
+    unique_ptr<PairDisplayNameCache> pdnc;
+
+    unique_ptr<CatParameterCache> cpc;
+
+    unique_ptr<SqlProfiler> sqlProf;
+
+    unique_ptr<DbSnapshotPool> snapPool;
   };
 
 }
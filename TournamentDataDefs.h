@@ -24,7 +24,7 @@
 namespace QTournament
 {
 #define DB_VERSION_MAJOR 2
-#define DB_VERSION_MINOR 3
+#define DB_VERSION_MINOR 5
 #define MIN_REQUIRED_DB_VERSION 2
 
 //----------------------------------------------------------------------------
@@ -169,6 +169,11 @@ namespace QTournament
 #define MA_LOSER_RANK  "LoserRank"
 #define MA_REFEREE_MODE  "RefereeMode"
 #define MA_REFEREE_REF  "RefereeRefId"
+#define MA_PACKED_RESULT  "PackedResult"
+#define MA_GAME_SUM_PAIR1  "GameSumPair1"
+#define MA_GAME_SUM_PAIR2  "GameSumPair2"
+#define MA_POINT_SUM_PAIR1  "PointSumPair1"
+#define MA_POINT_SUM_PAIR2  "PointSumPair2"
 //#define MA_  ""
 //#define MA_  ""
 //#define MA_  ""
@@ -16,6 +16,8 @@
  *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cassert>
+
 #include <SqliteOverlay/ClausesAndQueries.h>
 #include <SqliteOverlay/TabRow.h>
 
@@ -37,39 +39,74 @@ namespace QTournament
   void TournamentDatabaseObjectManager::fixSeqNumberAfterInsert(SqliteOverlay::DbTab* tabPtr) const
   {
     SqliteOverlay::DbTab* t = (tabPtr == nullptr) ? tab : tabPtr;
-    auto r = t->getSingleRowByColumnValueNull(GENERIC_SEQNUM_FIELD_NAME);
-    
-    int newSeqNum = t->length() - 1;
-    
+    string tabName = seqNumTabName(t);
+
     // lock the database before writing
     DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
 
-    r.update(GENERIC_SEQNUM_FIELD_NAME, newSeqNum);
+    // a single statement instead of looking up the row
+    // and the table length before updating the row
+    QString sql = "UPDATE %1 SET %2 = (SELECT COUNT(*) FROM %1) - 1 WHERE %2 IS NULL";
+    sql = sql.arg(QString::fromUtf8(tabName.c_str())).arg(GENERIC_SEQNUM_FIELD_NAME);
+    db->execNonQuery(sql.toUtf8().constData());
   }
 
 //----------------------------------------------------------------------------
 
-  void TournamentDatabaseObjectManager::fixSeqNumberAfterDelete(SqliteOverlay::DbTab* tabPtr, int deletedSeqNum) const
+  /**
+   *  Fixes the sequence number column after a row has been deleted by
+   *  decrementing the sequence numbers of all rows behind the deleted row.
+   *
+   *  The renumbering is done by a few set-based UPDATEs, see
+   *  TournamentDB::closeSeqNumGap().
+   *
+   *  @return true on success, false on database errors
+   */
+  bool TournamentDatabaseObjectManager::fixSeqNumberAfterDelete(SqliteOverlay::DbTab* tabPtr, int deletedSeqNum) const
   {
     SqliteOverlay::DbTab* t = (tabPtr == nullptr) ? tab : tabPtr;
 
-    SqliteOverlay::WhereClause wc;
-    wc.addIntCol(GENERIC_SEQNUM_FIELD_NAME, ">", deletedSeqNum);
-    wc.setOrderColumn_Asc(GENERIC_SEQNUM_FIELD_NAME);
+    // lock the database before writing
+    DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
+
+    return db->closeSeqNumGap(seqNumTabName(t), deletedSeqNum);
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   *  Fixes the sequence number column after several rows have been deleted,
+   *  e.g. by a single DELETE statement.
+   *
+   *  The renumbering is done with a few set-based statements, independent
+   *  of the number of deleted rows, see TournamentDB::closeSeqNumGaps().
+   */
+  bool TournamentDatabaseObjectManager::fixSeqNumberAfterDelete(SqliteOverlay::DbTab* tabPtr, const vector<int>& deletedSeqNums) const
+  {
+    SqliteOverlay::DbTab* t = (tabPtr == nullptr) ? tab : tabPtr;
 
-    auto it = t->getRowsByWhereClause(wc);
-    
     // lock the database before writing
     DbLockHolder lh{db, DatabaseAccessRoles::MainThread};
 
-    // re-number all items behind the deleted item
-    int nextSeqNum = deletedSeqNum;
-    while (!(it.isEnd()))
+    return db->closeSeqNumGaps(seqNumTabName(t), deletedSeqNums);
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * @return the name of a table with a sequence number column; empty
+   * if the table has no sequence number column, which is a programming
+   * error and makes all subsequent renumbering attempts fail
+   */
+  string TournamentDatabaseObjectManager::seqNumTabName(SqliteOverlay::DbTab* t) const
+  {
+    for (const char* tabName : {TAB_COURT, TAB_TEAM, TAB_PLAYER, TAB_CATEGORY, TAB_MATCH_GROUP, TAB_MATCH})
     {
-      (*it).update(GENERIC_SEQNUM_FIELD_NAME, nextSeqNum);
-      nextSeqNum++;
-      ++it;
+      if (db->getTab(tabName) == t) return tabName;
     }
+
+    assert(false);
+    return "";
   }
 
 //----------------------------------------------------------------------------
@@ -39,7 +39,9 @@ namespace QTournament
 
   protected:
     void fixSeqNumberAfterInsert(SqliteOverlay::DbTab* tabPtr = nullptr) const;
-    void fixSeqNumberAfterDelete(SqliteOverlay::DbTab* tabPtr, int deletedSeqNum) const;
+    bool fixSeqNumberAfterDelete(SqliteOverlay::DbTab* tabPtr, int deletedSeqNum) const;
+    bool fixSeqNumberAfterDelete(SqliteOverlay::DbTab* tabPtr, const vector<int>& deletedSeqNums) const;
+    string seqNumTabName(SqliteOverlay::DbTab* t) const;
   };
 
 }
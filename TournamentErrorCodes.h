@@ -99,6 +99,7 @@ namespace QTournament
         REFEREE_NOT_IDLE,
         COURT_NOT_DISABLED,
         COURT_ALREADY_USED,
+        OPERATION_CANCELED,
     };
 }
 
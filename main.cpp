@@ -19,6 +19,8 @@
 #include <iostream>
 
 #include <QApplication>
+#include <QGuiApplication>
+#include <QCommandLineParser>
 #include <QTranslator>
 #include <QLibraryInfo>
 
@@ -28,12 +30,115 @@
 #include <QStyleFactory>
 
 #include "ui/MainFrame.h"
+#include "reports/ReportBatchExporter.h"
+#include "HotPathTracer.h"
+
+static constexpr char HeadlessExportOption[] = "--export-reports";
+
+//----------------------------------------------------------------------------
+
+void installTranslators(QCoreApplication& app, QTranslator& qtTranslator, QTranslator& tournamentTranslator)
+{
+  // try to load the basic Qt translations either from the Qt installation (system-wide)
+  // or from a copy deployed along with the application (on non-Qt computers)
+  QString appPath = app.applicationDirPath();
+  QString transPath = QLibraryInfo::location(QLibraryInfo::TranslationsPath);
+  bool isLoaded = qtTranslator.load(QLocale(), "qt", "_", appPath, ".qm");
+  if (!isLoaded)
+  {
+    isLoaded = qtTranslator.load(QLocale(), "qt", "_", transPath, ".qm");
+  }
+  if (isLoaded) app.installTranslator(&qtTranslator);
+
+  // load the application specific translations
+  tournamentTranslator.load(QLocale(), "tournament", "_", appPath, ".qm");
+  app.installTranslator(&tournamentTranslator);
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * Exports reports of a tournament file to PDF without opening the main window.
+ *
+ * Usage:
+ *   QTournament --export-reports -o <outDir> [-j <threads>] [--list] <file.tdb> [<report> ...]
+ *
+ * Without explicit report names, all available reports are exported.
+ * On machines without a display, add "-platform offscreen".
+ *
+ * @return the process exit code
+ */
+int runHeadlessReportExport(const QCoreApplication& app)
+{
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Headless export of tournament reports to PDF files");
+  parser.addHelpOption();
+  parser.addOption(QCommandLineOption{"export-reports", "Run in headless report export mode."});
+  parser.addOption(QCommandLineOption{QStringList{"o", "out"}, "Destination directory for the PDF files.", "outDir", "."});
+  parser.addOption(QCommandLineOption{QStringList{"j", "threads"}, "Number of worker threads (default: number of CPU cores).", "threads", "0"});
+  parser.addOption(QCommandLineOption{"list", "Only list the available reports."});
+  parser.addPositionalArgument("file", "The tournament file (*.tdb).");
+  parser.addPositionalArgument("reports", "Names of the reports to export; default: all.", "[reports...]");
+  parser.process(app);
+
+  QStringList args = parser.positionalArguments();
+  if (args.isEmpty())
+  {
+    cerr << "No tournament file given." << endl;
+    return 1;
+  }
+  QString fName = args.takeFirst();
+
+  ERR err;
+  auto db = ReportBatchExporter::openTournamentReadOnly(fName, &err);
+  if (db == nullptr)
+  {
+    cerr << "Could not open " << fName.toStdString() << " (error code " << static_cast<int>(err) << ")" << endl;
+    return 1;
+  }
+
+  ReportBatchExporter exporter{db.get()};
+  if (parser.isSet("list"))
+  {
+    for (const QString& repName : exporter.getAvailableReports())
+    {
+      cout << repName.toStdString() << endl;
+    }
+    return 0;
+  }
+
+  QStringList failedReports;
+  int cnt = exporter.exportToPdf(args, parser.value("out"), parser.value("threads").toInt(), &failedReports);
+  cout << "Exported " << cnt << " report(s) to " << parser.value("out").toStdString() << endl;
+  for (const QString& repName : failedReports)
+  {
+    cerr << "Failed: " << repName.toStdString() << endl;
+  }
+
+  return failedReports.isEmpty() ? 0 : 2;
+}
+
+//----------------------------------------------------------------------------
 
 int main(int argc, char *argv[])
 {
   // initialize resources, if needed
   Q_INIT_RESOURCE(tournament);
 
+  // headless mode: export reports without any GUI
+  for (int i=1; i < argc; ++i)
+  {
+    if (QString(argv[i]) == HeadlessExportOption)
+    {
+      QGuiApplication app(argc, argv);
+      QTranslator qtTranslator;
+      QTranslator tournamentTranslator;
+      installTranslators(app, qtTranslator, tournamentTranslator);
+
+      return runHeadlessReportExport(app);
+    }
+  }
+
   QApplication app(argc, argv);
 
   // use the "Fusion" style
@@ -52,20 +157,8 @@ int main(int argc, char *argv[])
   // Only temporary: hard-coded German translation while in debug mode
   //qtTranslator.load("qt_de", QLibraryInfo::location(QLibraryInfo::TranslationsPath));
 
-  // try to load the basic Qt translations either from the Qt installation (system-wide)
-  // or from a copy deployed along with the application (on non-Qt computers)
-  QString appPath = app.applicationDirPath();
-  QString transPath = QLibraryInfo::location(QLibraryInfo::TranslationsPath);
-  bool isLoaded = qtTranslator.load(QLocale(), "qt", "_", appPath, ".qm");
-  if (!isLoaded)
-  {
-    isLoaded = qtTranslator.load(QLocale(), "qt", "_", transPath, ".qm");
-  }
-  if (isLoaded) app.installTranslator(&qtTranslator);
-  
-  // load the application specific translations
   QTranslator tournamentTranslator;
-  tournamentTranslator.load(QLocale(), "tournament", "_", appPath, ".qm");
+  installTranslators(app, qtTranslator, tournamentTranslator);
   //
   // Only temporary: hard-coded German translation while in debug mode
   /*
@@ -74,12 +167,27 @@ int main(int argc, char *argv[])
 #else
   tournamentTranslator.load(app.applicationDirPath() + "/../tournament_de");
 #endif*/
-  app.installTranslator(&tournamentTranslator);
   
+#ifdef QTOURNAMENT_ENABLE_TRACING
+  // record a trace of the hot paths for the whole session
+  // if a trace file has been specified
+  QString traceFileName = QString::fromUtf8(qgetenv("QTOURNAMENT_TRACE_FILE"));
+  if (!(traceFileName.isEmpty()))
+  {
+    QTournament::TraceRecorder::getInstance()->start(traceFileName);
+  }
+#endif
+
   MainFrame w;
   w.show();
 
   // create and show your widgets here
 
-  return app.exec();
+  int result = app.exec();
+
+#ifdef QTOURNAMENT_ENABLE_TRACING
+  QTournament::TraceRecorder::getInstance()->stop();
+#endif
+
+  return result;
 }
@@ -23,6 +23,7 @@
 #include "CatRoundStatus.h"
 #include "CentralSignalEmitter.h"
 #include "CatMngr.h"
+#include "HotPathTracer.h"
 
 using namespace QTournament;
 using namespace SqliteOverlay;
@@ -43,6 +44,10 @@ CategoryTableModel::CategoryTableModel(TournamentDB* _db)
 
 int CategoryTableModel::rowCount(const QModelIndex& parent) const
 {
+  // the database is being modified by a worker thread; the
+  // model is in reset state and will be refreshed afterwards
+  if (db->isBackgroundOperationRunning()) return 0;
+
   return catTab->length();
 }
 
@@ -57,6 +62,8 @@ int CategoryTableModel::columnCount(const QModelIndex& parent) const
 
 QVariant CategoryTableModel::data(const QModelIndex& index, int role) const
 {
+    TRACE_SCOPE("CategoryTableModel::data");
+
     if (!index.isValid())
       return QVariant();
 
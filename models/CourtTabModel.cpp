@@ -25,6 +25,7 @@
 #include "CourtMngr.h"
 #include "CentralSignalEmitter.h"
 #include "MatchMngr.h"
+#include "HotPathTracer.h"
 
 using namespace QTournament;
 using namespace SqliteOverlay;
@@ -43,6 +44,10 @@ CourtTableModel::CourtTableModel(TournamentDB* _db)
   durationUpdateTimer = make_unique<QTimer>(this);
   connect(durationUpdateTimer.get(), SIGNAL(timeout()), this, SLOT(onDurationUpdateTimerElapsed()));
   durationUpdateTimer->start(DURATION_UPDATE_PERIOD__MS);
+
+  // the views would read the database when updating the duration
+  connect(cse, SIGNAL(beginBackgroundDbOperation()), durationUpdateTimer.get(), SLOT(stop()), Qt::DirectConnection);
+  connect(cse, SIGNAL(endBackgroundDbOperation()), durationUpdateTimer.get(), SLOT(start()), Qt::DirectConnection);
 }
 
 //----------------------------------------------------------------------------
@@ -50,6 +55,10 @@ CourtTableModel::CourtTableModel(TournamentDB* _db)
 int CourtTableModel::rowCount(const QModelIndex& parent) const
 {
   if (parent.isValid()) return 0;
+  // the database is being modified by a worker thread; the
+  // model is in reset state and will be refreshed afterwards
+  if (db->isBackgroundOperationRunning()) return 0;
+
   return courtTab->length();
 }
 
@@ -65,6 +74,8 @@ int CourtTableModel::columnCount(const QModelIndex& parent) const
 
 QVariant CourtTableModel::data(const QModelIndex& index, int role) const
 {
+    TRACE_SCOPE("CourtTableModel::data");
+
     if (!index.isValid())
       //return QVariant();
       return QString("Invalid index");
@@ -175,6 +186,8 @@ void CourtTableModel::onCourtStatusChanged(int courtId, int courtSeqNum)
 
 void CourtTableModel::onDurationUpdateTimerElapsed()
 {
+  if (db->isBackgroundOperationRunning()) return;
+
   QModelIndex startIdx = createIndex(0, DURATION_COL_ID);
   QModelIndex endIdx = createIndex(rowCount(), DURATION_COL_ID);
   emit dataChanged(startIdx, endIdx);
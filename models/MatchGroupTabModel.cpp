@@ -22,6 +22,7 @@
 #include "MatchMngr.h"
 #include "../ui/GuiHelpers.h"
 #include "CentralSignalEmitter.h"
+#include "HotPathTracer.h"
 
 #include <QDebug>
 
@@ -44,6 +45,10 @@ MatchGroupTableModel::MatchGroupTableModel(TournamentDB* _db)
 int MatchGroupTableModel::rowCount(const QModelIndex& parent) const
 {
   if (parent.isValid()) return 0;
+  // the database is being modified by a worker thread; the
+  // model is in reset state and will be refreshed afterwards
+  if (db->isBackgroundOperationRunning()) return 0;
+
   return mgTab->length();
 }
 
@@ -59,6 +64,8 @@ int MatchGroupTableModel::columnCount(const QModelIndex& parent) const
 
 QVariant MatchGroupTableModel::data(const QModelIndex& index, int role) const
 {
+    TRACE_SCOPE("MatchGroupTableModel::data");
+
     if (!index.isValid())
       //return QVariant();
       return QString("Invalid index");
@@ -23,6 +23,7 @@
 #include "../ui/GuiHelpers.h"
 #include "CentralSignalEmitter.h"
 #include "MatchMngr.h"
+#include "HotPathTracer.h"
 #include <SqliteOverlay/KeyValueTab.h>
 
 using namespace QTournament;
@@ -35,6 +36,7 @@ MatchTableModel::MatchTableModel(TournamentDB* _db)
   connect(cse, SIGNAL(beginCreateMatch()), this, SLOT(onBeginCreateMatch()), Qt::DirectConnection);
   connect(cse, SIGNAL(endCreateMatch(int)), this, SLOT(onEndCreateMatch(int)), Qt::DirectConnection);
   connect(cse, SIGNAL(matchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), this, SLOT(onMatchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+  connect(cse, SIGNAL(matchPlayersChanged(int,int)), this, SLOT(onMatchPlayersChanged(int,int)), Qt::DirectConnection);
   connect(cse, SIGNAL(beginResetAllModels()), this, SLOT(onBeginResetModel()), Qt::DirectConnection);
   connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onEndResetModel()), Qt::DirectConnection);
   connect(cse, SIGNAL(endCreateCourt(int)), this, SLOT(recalcPrediction()), Qt::DirectConnection);
@@ -50,6 +52,10 @@ MatchTableModel::MatchTableModel(TournamentDB* _db)
 int MatchTableModel::rowCount(const QModelIndex& parent) const
 {
   if (parent.isValid()) return 0;
+  // the database is being modified by a worker thread; the
+  // model is in reset state and will be refreshed afterwards
+  if (db->isBackgroundOperationRunning()) return 0;
+
   return matchTab->length();
 }
 
@@ -65,6 +71,8 @@ int MatchTableModel::columnCount(const QModelIndex& parent) const
 
 QVariant MatchTableModel::data(const QModelIndex& index, int role) const
 {
+    TRACE_SCOPE("MatchTableModel::data");
+
     if (!index.isValid())
       //return QVariant();
       return QString("Invalid index");
@@ -303,6 +311,15 @@ void MatchTableModel::onMatchStatusChanged(int matchId, int matchSeqNum, OBJ_STA
 
 //----------------------------------------------------------------------------
 
+void MatchTableModel::onMatchPlayersChanged(int, int matchSeqNum)
+{
+  QModelIndex startIdx = createIndex(matchSeqNum, 0);
+  QModelIndex endIdx = createIndex(matchSeqNum, COLUMN_COUNT-1);
+  emit dataChanged(startIdx, endIdx);
+}
+
+//----------------------------------------------------------------------------
+
 void MatchTableModel::onBeginResetModel()
 {
   beginResetModel();
@@ -63,6 +63,7 @@ namespace QTournament
     void onBeginCreateMatch();
     void onEndCreateMatch(int newMatchSeqNum);
     void onMatchStatusChanged(int matchId, int matchSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onMatchPlayersChanged(int matchId, int matchSeqNum);
     void onBeginResetModel();
     void onEndResetModel();
     void recalcPrediction();
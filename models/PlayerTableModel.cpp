@@ -22,6 +22,7 @@
 #include "PlayerTableModel.h"
 #include "PlayerMngr.h"
 #include "CentralSignalEmitter.h"
+#include "HotPathTracer.h"
 
 using namespace QTournament;
 using namespace SqliteOverlay;
@@ -48,6 +49,10 @@ PlayerTableModel::PlayerTableModel(TournamentDB* _db)
 
 int PlayerTableModel::rowCount(const QModelIndex& parent) const
 {
+  // the database is being modified by a worker thread; the
+  // model is in reset state and will be refreshed afterwards
+  if (db->isBackgroundOperationRunning()) return 0;
+
   return playerTab->length();
 }
 
@@ -62,6 +67,8 @@ int PlayerTableModel::columnCount(const QModelIndex& parent) const
 
 QVariant PlayerTableModel::data(const QModelIndex& index, int role) const
 {
+    TRACE_SCOPE("PlayerTableModel::data");
+
     if (!index.isValid())
       return QVariant();
 
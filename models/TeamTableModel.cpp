@@ -22,6 +22,7 @@
 #include "TeamTableModel.h"
 #include "TeamMngr.h"
 #include "CentralSignalEmitter.h"
+#include "HotPathTracer.h"
 
 using namespace SqliteOverlay;
 
@@ -35,12 +36,18 @@ namespace QTournament
     connect(cse, SIGNAL(beginCreateTeam()), this, SLOT(onBeginCreateTeam()), Qt::DirectConnection);
     connect(cse, SIGNAL(endCreateTeam(int)), this, SLOT(onEndCreateTeam(int)), Qt::DirectConnection);
     connect(cse, SIGNAL(teamRenamed(int)), this, SLOT(onTeamRenamed(int)), Qt::DirectConnection);
+    connect(cse, SIGNAL(beginResetAllModels()), this, SLOT(onBeginResetModel()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onEndResetModel()), Qt::DirectConnection);
   }
 
 //----------------------------------------------------------------------------
 
   int TeamTableModel::rowCount(const QModelIndex& parent) const
   {
+    // the database is being modified by a worker thread; the
+    // model is in reset state and will be refreshed afterwards
+    if (db->isBackgroundOperationRunning()) return 0;
+
     return teamTab->length();
   }
 
@@ -55,6 +62,8 @@ namespace QTournament
   
   QVariant TeamTableModel::data(const QModelIndex& index, int role) const
   {
+    TRACE_SCOPE("TeamTableModel::data");
+
     if (!index.isValid())
       return QVariant();
 
@@ -136,6 +145,21 @@ namespace QTournament
     QModelIndex index = QAbstractItemModel::createIndex(teamSeqNum, 0);
     emit dataChanged(index, index);
   }
+
+//----------------------------------------------------------------------------
+
+  void TeamTableModel::onBeginResetModel()
+  {
+    beginResetModel();
+  }
+
+//----------------------------------------------------------------------------
+
+  void TeamTableModel::onEndResetModel()
+  {
+    endResetModel();
+  }
+
 //----------------------------------------------------------------------------
 
 
@@ -56,6 +56,8 @@ namespace QTournament
     void onBeginCreateTeam();
     void onEndCreateTeam(int newTeamSeqNum);
     void onTeamRenamed(int teamSeqNum);
+    void onBeginResetModel();
+    void onEndResetModel();
   };
 
 }
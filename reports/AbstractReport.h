@@ -60,6 +60,9 @@ namespace QTournament
     AbstractReport(TournamentDB* _db, const QString& _name);
     virtual ~AbstractReport();
 
+    // reads the report data from the database before regenerateReport() is called;
+    // may run in a worker thread and must therefore not use any Qt GUI classes
+    virtual void prefetchData() {}
     virtual upSimpleReport regenerateReport() { throw std::runtime_error("Unimplemented Method: regenerateReport"); };
     virtual QStringList getReportLocators() const { throw std::runtime_error("Unimplemented Method: getReportLocators"); };
 
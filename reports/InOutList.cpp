@@ -176,7 +176,7 @@ bool InOutList::isValidCatRoundCombination(const Category& _cat, int _round)
   MATCH_SYSTEM mSys = _cat.getMatchSystem();
   if (mSys == GROUPS_WITH_KO)
   {
-    KO_Config cfg = KO_Config(_cat.getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = _cat.getGroupConfig();
     if (_round < cfg.getNumRounds())
     {
       return false;
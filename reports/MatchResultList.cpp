@@ -52,11 +52,11 @@ MatchResultList::MatchResultList(TournamentDB* _db, const QString& _name, const
 
 //----------------------------------------------------------------------------
 
-upSimpleReport MatchResultList::regenerateReport()
+void MatchResultList::prefetchData()
 {
   // collect the numbers of all match groups in this round
   MatchMngr mm{db};
-  MatchGroupList mgl = mm.getMatchGroupsForCat(cat, round);
+  mgl = mm.getMatchGroupsForCat(cat, round);
   if (mgl.size() > 1)
   {
     std::sort(mgl.begin(), mgl.end(), [](MatchGroup& mg1, MatchGroup& mg2){
@@ -65,6 +65,26 @@ upSimpleReport MatchResultList::regenerateReport()
     });
   }
 
+  // collect the sorted matches of each match group
+  sortedMatches.clear();
+  for (const MatchGroup& mg : mgl)
+  {
+    MatchList ml = mg.getMatches();
+    std::sort(ml.begin(), ml.end(), [](Match& m1, Match& m2){
+      return (m1.getMatchNumber() < m2.getMatchNumber());
+    });
+    sortedMatches.push_back(ml);
+  }
+
+  isPrefetched = true;
+}
+
+//----------------------------------------------------------------------------
+
+upSimpleReport MatchResultList::regenerateReport()
+{
+  if (!isPrefetched) prefetchData();
+
   // prepare a subheader if we are in KO-rounds
   QString subHeader = QString();
   if ((mgl.size() == 1) && (mgl.at(0).getGroupNumber() > 0))
@@ -84,9 +104,9 @@ upSimpleReport MatchResultList::regenerateReport()
   }
 
   // print the results of each match group
-  for (MatchGroup mg : mgl)
+  for (size_t idx=0; idx < mgl.size(); ++idx)
   {
-    int grpNum = mg.getGroupNumber();
+    int grpNum = mgl.at(idx).getGroupNumber();
 
     // print a header if we are in round-robin rounds
     if (grpNum > 0)
@@ -95,11 +115,7 @@ upSimpleReport MatchResultList::regenerateReport()
     }
 
     // print each finished match
-    MatchList ml = mg.getMatches();
-    std::sort(ml.begin(), ml.end(), [](Match& m1, Match& m2){
-      return (m1.getMatchNumber() < m2.getMatchNumber());
-    });
-    printMatchList(result, ml, PlayerPairList(), GuiHelpers::groupNumToLongString(grpNum) + tr(" (cont.)"), true, false);
+    printMatchList(result, sortedMatches.at(idx), PlayerPairList(), GuiHelpers::groupNumToLongString(grpNum) + tr(" (cont.)"), true, false);
     result->skip(3.0);
   }
 
@@ -54,43 +54,58 @@ MatchResultList_ByGroup::MatchResultList_ByGroup(TournamentDB* _db, const QStrin
 
 //----------------------------------------------------------------------------
 
-upSimpleReport MatchResultList_ByGroup::regenerateReport()
+void MatchResultList_ByGroup::prefetchData()
 {
   // collect the match groups with the requested match group number and
   // search in all rounds
   MatchMngr mm{db};
-  MatchGroupList mgl = mm.getMatchGroupsForCat(cat);
-  MatchGroupList filteredList;
-  for (MatchGroup mg: mgl)
+  mgl.clear();
+  for (MatchGroup mg: mm.getMatchGroupsForCat(cat))
   {
-    if (mg.getGroupNumber() == grpNum) filteredList.push_back(mg);
+    if (mg.getGroupNumber() == grpNum) mgl.push_back(mg);
   }
 
   // sort match groups by round number
-  if (filteredList.size() > 1)
+  if (mgl.size() > 1)
   {
-    std::sort(filteredList.begin(), filteredList.end(), [](MatchGroup& mg1, MatchGroup& mg2){
+    std::sort(mgl.begin(), mgl.end(), [](MatchGroup& mg1, MatchGroup& mg2){
       if (mg1.getRound() < mg2.getRound()) return true;
       return false;
     });
   }
 
+  // collect the sorted matches of each match group
+  sortedMatches.clear();
+  for (const MatchGroup& mg : mgl)
+  {
+    MatchList maList = mg.getMatches();
+    std::sort(maList.begin(), maList.end(), [](Match& ma1, Match& ma2)
+    {
+      return ma1.getMatchNumber() < ma2.getMatchNumber();
+    });
+    sortedMatches.push_back(maList);
+  }
+
+  isPrefetched = true;
+}
+
+//----------------------------------------------------------------------------
+
+upSimpleReport MatchResultList_ByGroup::regenerateReport()
+{
+  if (!isPrefetched) prefetchData();
+
   upSimpleReport result = createEmptyReport_Portrait();
   QString repName = cat.getName() + tr(" -- Results of Group ") + QString::number(grpNum);
   setHeaderAndHeadline(result.get(), repName);
 
-  for (MatchGroup mg : filteredList)
+  for (size_t idx=0; idx < mgl.size(); ++idx)
   {
+    const MatchGroup& mg = mgl.at(idx);
     int round = mg.getRound();
     printIntermediateHeader(result, tr("Round ") + QString::number(round));
 
-    MatchList maList = mg.getMatches();
-    std::sort(maList.begin(), maList.end(), [](Match& ma1, Match& ma2)
-    {
-      return ma1.getMatchNumber() < ma2.getMatchNumber();
-    });
-
-    printMatchList(result, maList, PlayerPairList(), tr("Results of round ") + QString::number(round) + tr(" (cont.)"), true, false);
+    printMatchList(result, sortedMatches.at(idx), PlayerPairList(), tr("Results of round ") + QString::number(round) + tr(" (cont.)"), true, false);
 
     if (mg.getState() != STAT_MG_FINISHED)
     {
@@ -26,6 +26,7 @@
 #include "reports/AbstractReport.h"
 #include "TournamentDB.h"
 #include "TournamentDataDefs.h"
+#include "MatchMngr.h"
 
 using namespace SqliteOverlay;
 
@@ -38,12 +39,17 @@ namespace QTournament
   public:
     MatchResultList_ByGroup(TournamentDB* _db, const QString& _name, const Category& _cat, int _grpNum);
 
+    virtual void prefetchData() override;
     virtual upSimpleReport regenerateReport() override;
     virtual QStringList getReportLocators() const override;
 
   private:
     Category cat;
     int grpNum;
+
+    bool isPrefetched{false};
+    MatchGroupList mgl;
+    std::vector<MatchList> sortedMatches;
   };
 
 }
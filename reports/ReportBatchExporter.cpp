@@ -0,0 +1,158 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDir>
+#include <QFile>
+
+#include "ReportBatchExporter.h"
+#include "ReportFactory.h"
+
+namespace QTournament
+{
+
+  ReportBatchExporter::ReportBatchExporter(TournamentDB* _db)
+    :db(_db), repCache(_db)
+  {
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Opens a tournament file for report generation.
+   *
+   * The file is loaded into a private in-memory database. Thus, the
+   * file itself is never modified, even if we have to convert it
+   * to the latest database format.
+   *
+   * @param fName the tournament file to open
+   * @param err optional pointer to an error code
+   *
+   * @return the database handle or nullptr in case of errors
+   */
+  unique_ptr<TournamentDB> ReportBatchExporter::openTournamentReadOnly(const QString& fName, ERR* err)
+  {
+    ERR e;
+    auto newDb = TournamentDB::openSnapshot(fName, &e);
+    if (newDb == nullptr)
+    {
+      if (err != nullptr) *err = e;
+      return nullptr;
+    }
+
+    if (!(newDb->isCompatibleDatabaseVersion()))
+    {
+      if (err != nullptr) *err = INCOMPATIBLE_FILE_FORMAT;
+      return nullptr;
+    }
+
+    if (newDb->needsConversion())
+    {
+      if (!(newDb->convertToLatestDatabaseVersion()))
+      {
+        if (err != nullptr) *err = DATABASE_ERROR;
+        return nullptr;
+      }
+    }
+
+    if (err != nullptr) *err = OK;
+    return newDb;
+  }
+
+//----------------------------------------------------------------------------
+
+  QStringList ReportBatchExporter::getAvailableReports() const
+  {
+    ReportFactory repFab{db};
+    return repFab.getReportCatalogue();
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Generates a list of reports and writes each report to a
+   * separate PDF file in a given directory.
+   *
+   * Existing files are overwritten.
+   *
+   * @param repNames the names of the reports to export; an empty list means "all available reports"
+   * @param outDir the destination directory; it is created if necessary
+   * @param nThreads the number of worker threads for the report generation; values < 1 mean "use the number of CPU cores"
+   * @param failedReports optional pointer to a list that receives the names of all reports that couldn't be exported
+   *
+   * @return the number of successfully written PDF files
+   */
+  int ReportBatchExporter::exportToPdf(const QStringList& repNames, const QString& outDir, int nThreads, QStringList* failedReports)
+  {
+    if (failedReports != nullptr) failedReports->clear();
+
+    QStringList allReps = repNames.isEmpty() ? getAvailableReports() : repNames;
+
+    QDir dir{outDir};
+    if (!(dir.exists()) && !(dir.mkpath(".")))
+    {
+      if (failedReports != nullptr) *failedReports = allReps;
+      return 0;
+    }
+
+    // generate all reports in one go
+    auto reports = repCache.getReports(allReps, nThreads);
+
+    int cnt = 0;
+    for (const QString& repName : allReps)
+    {
+      spSimpleReport rep = reports[repName];
+
+      QString fName = dir.filePath(reportNameToFileName(repName));
+      if (QFile::exists(fName)) QFile::remove(fName);
+
+      if (rep != nullptr)
+      {
+        rep->writeReportToPdf(fName);
+      }
+
+      if ((rep != nullptr) && QFile::exists(fName))
+      {
+        ++cnt;
+      } else {
+        if (failedReports != nullptr) failedReports->append(repName);
+      }
+    }
+
+    return cnt;
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Derives a file name from a report name.
+   *
+   * The report name "Results,3,2" results in "Results_3_2.pdf", for instance.
+   *
+   * @param repName the report name as used by the ReportFactory
+   *
+   * @return the file name without path
+   */
+  QString ReportBatchExporter::reportNameToFileName(const QString& repName)
+  {
+    QString fName = repName;
+    fName.replace(",", "_");
+    fName.replace("-", "m");   // negative round numbers
+    return fName + ".pdf";
+  }
+
+}
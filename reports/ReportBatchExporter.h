@@ -0,0 +1,60 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPORTBATCHEXPORTER_H
+#define REPORTBATCHEXPORTER_H
+
+#include <memory>
+
+#include <QString>
+#include <QStringList>
+
+#include "TournamentDB.h"
+#include "ReportCache.h"
+
+namespace QTournament
+{
+
+  /**
+   * Renders a set of reports to PDF files without any user interaction.
+   *
+   * This is the backend of the headless command line mode. The reports
+   * are generated in parallel using the ReportCache and then written
+   * to one PDF file per report.
+   */
+  class ReportBatchExporter
+  {
+  public:
+    ReportBatchExporter(TournamentDB* _db);
+
+    // opens a tournament file as a private in-memory copy that is never written back
+    static unique_ptr<TournamentDB> openTournamentReadOnly(const QString& fName, ERR* err=nullptr);
+
+    QStringList getAvailableReports() const;
+    int exportToPdf(const QStringList& repNames, const QString& outDir, int nThreads = -1, QStringList* failedReports = nullptr);
+
+    static QString reportNameToFileName(const QString& repName);
+
+  private:
+    TournamentDB* db;
+    ReportCache repCache;
+  };
+
+}
+
+#endif // REPORTBATCHEXPORTER_H
@@ -0,0 +1,466 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "ReportCache.h"
+#include "ReportFactory.h"
+#include "CentralSignalEmitter.h"
+#include "MatchMngr.h"
+#include "DbSnapshotPool.h"
+#include "CatParameterCache.h"
+
+namespace QTournament
+{
+  constexpr int ReportCache::MinReportsForParallelRegeneration;
+
+  ReportCache::ReportCache(TournamentDB* _db)
+    :QObject(), db(_db), unspecificChangeCounter{0}
+  {
+    CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+
+    // changes that can be mapped to a category
+    connect(cse, SIGNAL(playersPaired(Category,Player,Player)),
+            this, SLOT(onCategoryPairChanged(Category,Player,Player)), Qt::DirectConnection);
+    connect(cse, SIGNAL(playersSplit(Category,Player,Player)),
+            this, SLOT(onCategoryPairChanged(Category,Player,Player)), Qt::DirectConnection);
+    connect(cse, SIGNAL(playerAddedToCategory(Player,Category)),
+            this, SLOT(onCategoryPlayerChanged(Player,Category)), Qt::DirectConnection);
+    connect(cse, SIGNAL(playerRemovedFromCategory(Player,Category)),
+            this, SLOT(onCategoryPlayerChanged(Player,Category)), Qt::DirectConnection);
+    connect(cse, SIGNAL(categoryStatusChanged(Category,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onCategoryStatusChanged(Category,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+    connect(cse, SIGNAL(categoryRenamed(Category)),
+            this, SLOT(onCategoryRenamed(Category)), Qt::DirectConnection);
+    connect(cse, SIGNAL(matchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onMatchStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+    connect(cse, SIGNAL(matchResultUpdated(int,int)),
+            this, SLOT(onMatchChanged(int,int)), Qt::DirectConnection);
+    connect(cse, SIGNAL(matchPlayersChanged(int,int)),
+            this, SLOT(onMatchChanged(int,int)), Qt::DirectConnection);
+    connect(cse, SIGNAL(matchGroupStatusChanged(int,int,OBJ_STATE,OBJ_STATE)),
+            this, SLOT(onMatchGroupStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), Qt::DirectConnection);
+    connect(cse, SIGNAL(roundCompleted(int,int)),
+            this, SLOT(onRoundCompleted(int,int)), Qt::DirectConnection);
+
+    // changes that potentially affect all categories
+    connect(cse, SIGNAL(endCreateMatch(int)), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endCreateMatchGroup(int)), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(categoryRemovedFromTournament(int,int)), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(playerRenamed(Player)), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(endDeletePlayer()), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(teamRenamed(int)), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(teamAssignmentChanged(Player,Team,Team)), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+    connect(cse, SIGNAL(courtRenamed(Court)), this, SLOT(onUnspecificChange()), Qt::DirectConnection);
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Returns the report data for a given report object, either from the cache
+   * or freshly generated.
+   *
+   * A fresh report is generated synchronously in the calling thread using
+   * the report object's own database connection.
+   *
+   * @param rep the report to retrieve
+   *
+   * @return the (possibly cached) report data or nullptr if the report couldn't be generated
+   */
+  spSimpleReport ReportCache::getReport(AbstractReport& rep)
+  {
+    QString repName = rep.getName();
+
+    auto it = cache.find(repName);
+    if ((it != cache.end()) && isValidEntry(it->second))
+    {
+      return it->second.rep;
+    }
+
+    spSimpleReport newRep{rep.regenerateReport()};
+    if (newRep == nullptr)
+    {
+      cache.erase(repName);
+      return nullptr;
+    }
+
+    // note: create the entry AFTER generating the report because
+    // some reports modify the database while being generated
+    cache[repName] = createEntry(repName, newRep);
+    return newRep;
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Returns the report data for a list of reports.
+   *
+   * Reports that are up to date are served from the cache. All other reports
+   * are regenerated, preferrably in parallel by worker threads that operate
+   * on a read-only snapshot of the database.
+   *
+   * This function blocks until all reports are available.
+   *
+   * @param repNames the names of the reports to retrieve, as used by the ReportFactory
+   * @param nThreads the number of worker threads; values < 1 mean "use the number of CPU cores"
+   *
+   * @return a map of report name to report data; reports that couldn't be generated are mapped to nullptr
+   */
+  std::map<QString, spSimpleReport> ReportCache::getReports(const QStringList& repNames, int nThreads)
+  {
+    std::map<QString, spSimpleReport> result;
+    ReportFactory repFab{db};
+
+    // serve everything that is up to date from the cache
+    // and collect the names of all stale reports.
+    //
+    // reports that write to the database have to be
+    // generated here in the main thread, using the "real"
+    // database connection
+    QStringList staleReps;
+    for (const QString& repName : repNames)
+    {
+      if (result.find(repName) != result.end()) continue;  // duplicate request
+
+      auto it = cache.find(repName);
+      if ((it != cache.end()) && isValidEntry(it->second))
+      {
+        result[repName] = it->second.rep;
+        continue;
+      }
+
+      if (ReportFactory::needsWriteAccess(repName))
+      {
+        upAbstractReport rep = repFab.getReportByName(repName);
+        result[repName] = (rep == nullptr) ? nullptr : getReport(*rep);
+        continue;
+      }
+
+      staleReps.append(repName);
+    }
+    if (staleReps.isEmpty()) return result;
+
+    // regenerate the stale reports. If the workload is too small
+    // to justify the overhead of a snapshot, we do it right here
+    std::vector<spSimpleReport> freshReps;
+    if (staleReps.size() >= MinReportsForParallelRegeneration)
+    {
+      freshReps = regenerateInParallel(staleReps, nThreads);
+    } else {
+      for (const QString& repName : staleReps)
+      {
+        upAbstractReport rep = repFab.getReportByName(repName);
+        freshReps.push_back((rep == nullptr) ? nullptr : spSimpleReport{rep->regenerateReport()});
+      }
+    }
+
+    // store the new reports in the cache. The database is guaranteed
+    // not to have changed since we've started because we didn't
+    // return control to the event loop
+    for (int idx=0; idx < staleReps.size(); ++idx)
+    {
+      const QString& repName = staleReps.at(idx);
+      spSimpleReport rep = freshReps.at(idx);
+
+      result[repName] = rep;
+      if (rep == nullptr)
+      {
+        cache.erase(repName);
+      } else {
+        cache[repName] = createEntry(repName, rep);
+      }
+    }
+
+    return result;
+  }
+
+//----------------------------------------------------------------------------
+
+  bool ReportCache::isUpToDate(const QString& repName) const
+  {
+    auto it = cache.find(repName);
+    if (it == cache.end()) return false;
+
+    return isValidEntry(it->second);
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::invalidateAll()
+  {
+    cache.clear();
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onCategoryPlayerChanged(const Player&, const Category& cat)
+  {
+    bumpCategory(cat.getId());
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onCategoryPairChanged(const Category cat, const Player&, const Player&)
+  {
+    bumpCategory(cat.getId());
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onCategoryStatusChanged(const Category& cat, const OBJ_STATE, const OBJ_STATE)
+  {
+    bumpCategory(cat.getId());
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onCategoryRenamed(const Category& cat)
+  {
+    bumpCategory(cat.getId());
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onMatchChanged(int matchId, int)
+  {
+    MatchMngr mm{db};
+    auto ma = mm.getMatch(matchId);
+    if (ma == nullptr)
+    {
+      onUnspecificChange();
+      return;
+    }
+
+    bumpCategory(ma->getCategory().getId());
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onMatchStatusChanged(int matchId, int matchSeqNum, OBJ_STATE, OBJ_STATE)
+  {
+    // even "faked" state changes with fromState == toState
+    // count as a change, because they are used to indicate
+    // modified match data like referee assignments
+    onMatchChanged(matchId, matchSeqNum);
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onMatchGroupStatusChanged(int, int matchGroupSeqNum, OBJ_STATE, OBJ_STATE)
+  {
+    MatchMngr mm{db};
+    auto mg = mm.getMatchGroupBySeqNum(matchGroupSeqNum);
+    if (mg == nullptr)
+    {
+      onUnspecificChange();
+      return;
+    }
+
+    bumpCategory(mg->getCategory().getId());
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onRoundCompleted(int catId, int)
+  {
+    bumpCategory(catId);
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::onUnspecificChange()
+  {
+    ++unspecificChangeCounter;
+  }
+
+//----------------------------------------------------------------------------
+
+  int ReportCache::getCatChangeCounter(int catId) const
+  {
+    auto it = catId2ChangeCounter.find(catId);
+    return (it == catId2ChangeCounter.end()) ? 0 : it->second;
+  }
+
+//----------------------------------------------------------------------------
+
+  ReportCache::CacheEntry ReportCache::createEntry(const QString& repName, const spSimpleReport& rep) const
+  {
+    int catId = ReportFactory::getCategoryIdFromReportName(repName);
+
+    return CacheEntry{
+      rep,
+      catId,
+      getCatChangeCounter(catId),
+      (catId > 0) ? db->getCatParameterCache()->getVersion(catId) : 0,
+      unspecificChangeCounter,
+      db->getDirtyCounter()
+    };
+  }
+
+//----------------------------------------------------------------------------
+
+  bool ReportCache::isValidEntry(const CacheEntry& e) const
+  {
+    // reports without category reference become stale
+    // with every modification of the database
+    if (e.catId < 1)
+    {
+      return (e.dirtyCounter == db->getDirtyCounter());
+    }
+
+    // parameter changes (e.g., the scoring or the group configuration)
+    // don't emit any signals but they are tracked by the parameter cache
+    return ((e.catChangeCounter == getCatChangeCounter(e.catId)) &&
+            (e.catParamVersion == db->getCatParameterCache()->getVersion(e.catId)) &&
+            (e.unspecificChangeCounter == unspecificChangeCounter));
+  }
+
+//----------------------------------------------------------------------------
+
+  void ReportCache::bumpCategory(int catId)
+  {
+    ++catId2ChangeCounter[catId];
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Regenerates a list of reports using a pool of worker threads.
+   *
+   * Each worker gets its own read-only snapshot of the current state
+   * of the database from the snapshot pool. The workers only prefetch
+   * the report data (AbstractReport::prefetchData()) from their snapshot;
+   * the actual reports are rendered here in the calling thread because
+   * SimpleReportGenerator uses Qt GUI classes like QFont and QPainter.
+   *
+   * Must be called from the main thread.
+   *
+   * @param repNames the names of the reports to generate; these
+   * reports must not write to the database
+   * @param nThreads the number of worker threads; values < 1 mean "use the number of CPU cores"
+   *
+   * @return a list of reports in the same order as the names in repNames; reports that couldn't be generated are nullptr
+   */
+  std::vector<spSimpleReport> ReportCache::regenerateInParallel(const QStringList& repNames, int nThreads)
+  {
+    std::vector<spSimpleReport> result(repNames.size(), nullptr);
+
+    // determine the number of workers
+    if (nThreads < 1)
+    {
+      nThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    nThreads = std::min(nThreads, repNames.size());
+
+    // get one snapshot per worker; the snapshots have to
+    // be taken here in the main thread
+    DbSnapshotPool* snapPool = db->getSnapshotPool();
+    std::vector<DbSnapshotLease> snapshots;
+    for (int i=0; i < nThreads; ++i)
+    {
+      DbSnapshotLease lease = snapPool->acquire();
+      if (!(lease.isValid())) break;
+      snapshots.push_back(std::move(lease));
+    }
+
+    if (snapshots.empty())
+    {
+      // fall back to serial generation
+      ReportFactory repFab{db};
+      for (int idx=0; idx < repNames.size(); ++idx)
+      {
+        upAbstractReport rep = repFab.getReportByName(repNames.at(idx));
+        if (rep != nullptr) result[idx] = spSimpleReport{rep->regenerateReport()};
+      }
+      return result;
+    }
+
+    // create the report objects here in the main thread; each report
+    // is bound to one of the snapshots in a round-robin fashion
+    std::vector<upAbstractReport> reports;
+    std::vector<std::vector<AbstractReport*>> reportsPerSnapshot(snapshots.size());
+    for (int idx=0; idx < repNames.size(); ++idx)
+    {
+      size_t snapIdx = idx % snapshots.size();
+      ReportFactory repFab{snapshots[snapIdx].get()};
+
+      upAbstractReport rep;
+      try
+      {
+        rep = repFab.getReportByName(repNames.at(idx));
+      }
+      catch (std::exception&)
+      {
+        // leave the report at nullptr
+      }
+
+      if (rep != nullptr) reportsPerSnapshot[snapIdx].push_back(rep.get());
+      reports.push_back(std::move(rep));
+    }
+
+    // the worker function: prefetch the data of all reports
+    // that are bound to the worker's snapshot
+    //
+    // a report that fails here is retried during rendering
+    // and then dropped if it fails again
+    auto worker = [](const std::vector<AbstractReport*>& repList)
+    {
+      for (AbstractReport* rep : repList)
+      {
+        try
+        {
+          rep->prefetchData();
+        }
+        catch (std::exception&)
+        {
+        }
+      }
+    };
+
+    std::vector<std::thread> pool;
+    for (const auto& repList : reportsPerSnapshot)
+    {
+      pool.push_back(std::thread{worker, std::cref(repList)});
+    }
+    for (std::thread& t : pool)
+    {
+      t.join();
+    }
+
+    // render all reports here in the main thread
+    for (int idx=0; idx < repNames.size(); ++idx)
+    {
+      if (reports[idx] == nullptr) continue;
+
+      try
+      {
+        result[idx] = spSimpleReport{reports[idx]->regenerateReport()};
+      }
+      catch (std::exception&)
+      {
+        // leave the result at nullptr
+      }
+    }
+
+    return result;
+  }
+
+}
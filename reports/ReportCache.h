@@ -0,0 +1,117 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPORTCACHE_H
+#define REPORTCACHE_H
+
+#include <map>
+#include <unordered_map>
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include "TournamentDB.h"
+#include "AbstractReport.h"
+
+namespace QTournament
+{
+
+  /**
+   * Keeps already generated reports and serves them again as long as
+   * the underlying data hasn't changed.
+   *
+   * Each cache entry is tagged with a set of change counters at the time
+   * of its generation:
+   *   * reports that belong to a category (name pattern "BaseName,catId,x")
+   *     are tagged with the change counter of their category, the version
+   *     of the category's parameters and with a counter for all changes that
+   *     can't be mapped to a specific category (e.g., renamed players or a
+   *     model reset);
+   *   * all other reports are tagged with the database's dirty counter and
+   *     thus become stale with any modification of the database.
+   *
+   * The per-category counters are fed by the signals of the CentralSignalEmitter.
+   *
+   * The data for stale reports can be prefetched in parallel by worker
+   * threads. Each worker operates on its own private, read-only snapshot
+   * of the tournament database so that the main database connection is
+   * never touched by a worker thread. The reports themselves are always
+   * rendered in the main thread.
+   */
+  class ReportCache : public QObject
+  {
+    Q_OBJECT
+
+  public:
+    ReportCache(TournamentDB* _db);
+
+    // cached access to a single report; regeneration takes
+    // place synchronously in the calling thread
+    spSimpleReport getReport(AbstractReport& rep);
+
+    // cached access to a list of reports; stale reports are
+    // regenerated in parallel
+    std::map<QString, spSimpleReport> getReports(const QStringList& repNames, int nThreads = -1);
+
+    bool isUpToDate(const QString& repName) const;
+    void invalidateAll();
+
+    // the minimum number of stale reports that justifies
+    // the overhead of creating a database snapshot and worker threads
+    static constexpr int MinReportsForParallelRegeneration = 3;
+
+  public slots:
+    void onCategoryPlayerChanged(const Player& p, const Category& cat);
+    void onCategoryPairChanged(const Category cat, const Player& p1, const Player& p2);
+    void onCategoryStatusChanged(const Category& cat, const OBJ_STATE fromState, const OBJ_STATE toState);
+    void onCategoryRenamed(const Category& cat);
+    void onMatchChanged(int matchId, int matchSeqNum);
+    void onMatchStatusChanged(int matchId, int matchSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onMatchGroupStatusChanged(int matchGroupId, int matchGroupSeqNum, OBJ_STATE fromState, OBJ_STATE toState);
+    void onRoundCompleted(int catId, int round);
+    void onUnspecificChange();
+
+  protected:
+    struct CacheEntry
+    {
+      spSimpleReport rep;
+      int catId;
+      int catChangeCounter;
+      int catParamVersion;
+      int unspecificChangeCounter;
+      int dirtyCounter;
+    };
+
+    int getCatChangeCounter(int catId) const;
+    CacheEntry createEntry(const QString& repName, const spSimpleReport& rep) const;
+    bool isValidEntry(const CacheEntry& e) const;
+    void bumpCategory(int catId);
+
+    std::vector<spSimpleReport> regenerateInParallel(const QStringList& repNames, int nThreads);
+
+  private:
+    TournamentDB* db;
+    std::map<QString, CacheEntry> cache;
+    std::unordered_map<int, int> catId2ChangeCounter;
+    int unspecificChangeCounter;
+  };
+
+}
+
+#endif // REPORTCACHE_H
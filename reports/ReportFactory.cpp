@@ -114,7 +114,7 @@ namespace QTournament
         result.append(genRepName(REP__MATRIX_AND_STANDINGS, cat, 0));
 
         // a matrix for each finished round of the round-robin phase
-        KO_Config cfg = KO_Config(cat.getParameter_string(GROUP_CONFIG));
+        KO_Config cfg = cat.getGroupConfig();
         int numGroupRounds = cfg.getNumRounds();
         for (int round = 1; ((round <= numGroupRounds) && (round <= numFinishedRounds)); ++round)
         {
@@ -320,6 +320,48 @@ namespace QTournament
     return result;
   }
 
+//----------------------------------------------------------------------------
+
+  /**
+   * Determines the ID of the category that a report refers to.
+   *
+   * @param repName the report name as generated by genRepName()
+   *
+   * @return the category ID or -1 if the report is not bound to a category
+   */
+  int ReportFactory::getCategoryIdFromReportName(const QString& repName)
+  {
+    QStringList repNameComponent = repName.split(",");
+    if (repNameComponent.size() < 2) return -1;
+
+    // all reports with parameters use the category ID as their
+    // first parameter... except for the result sheets
+    QString pureRepName = repNameComponent[0];
+    if (pureRepName == REP__RESULTSHEETS) return -1;
+
+    bool isOk;
+    int catId = repNameComponent[1].toInt(&isOk);
+    return isOk ? catId : -1;
+  }
+
+//----------------------------------------------------------------------------
+
+  /**
+   * Checks whether the generation of a report modifies the database.
+   *
+   * Such reports must be generated using the main database connection
+   * and can't be generated from a read-only snapshot.
+   *
+   * @param repName the report name as generated by genRepName()
+   *
+   * @return true if the report generation writes to the database
+   */
+  bool ReportFactory::needsWriteAccess(const QString& repName)
+  {
+    // brackets fill in missing player names while being generated
+    return repName.startsWith(QString(REP__BRACKET) + ",");
+  }
+
 //----------------------------------------------------------------------------
 
   QString ReportFactory::genRepName(QString repBaseName, const Category& cat, int intParam) const
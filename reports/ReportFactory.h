@@ -42,6 +42,10 @@ namespace QTournament
     // this works only with std::vector; QList<> won't compile... weird...
     std::vector<upAbstractReport> getMissingReports(const QStringList& existingReportNames) const;
 
+    // information that can be derived from the report name alone
+    static int getCategoryIdFromReportName(const QString& repName);
+    static bool needsWriteAccess(const QString& repName);
+
     static constexpr char REP__PARTLIST_BY_NAME[] = "ParticipantsListByName";
     static constexpr char REP__PARTLIST_BY_TEAM[] = "ParticipantsListByTeam";
     static constexpr char REP__PARTLIST_BY_CATEGORY[] = "ParticipantsListByCategory";
@@ -48,11 +48,20 @@ Standings::Standings(TournamentDB* _db, const QString& _name, const Category& _c
 
 //----------------------------------------------------------------------------
 
-upSimpleReport Standings::regenerateReport()
+void Standings::prefetchData()
 {
   // retrieve the ranking(s) for this round
   RankingMngr rm{db};
-  RankingEntryListList rll = rm.getSortedRanking(cat, round);
+  rll = rm.getSortedRanking(cat, round);
+
+  isPrefetched = true;
+}
+
+//----------------------------------------------------------------------------
+
+upSimpleReport Standings::regenerateReport()
+{
+  if (!isPrefetched) prefetchData();
 
   QString repName = cat.getName() + " -- " + tr("Standings after round ") + QString::number(round);
   upSimpleReport result = createEmptyReport_Portrait();
@@ -26,6 +26,7 @@
 #include "reports/AbstractReport.h"
 #include "TournamentDB.h"
 #include "TournamentDataDefs.h"
+#include "RankingMngr.h"
 
 using namespace SqliteOverlay;
 
@@ -38,6 +39,7 @@ namespace QTournament
   public:
     Standings(TournamentDB* _db, const QString& _name, const Category& _cat, int _round);
 
+    virtual void prefetchData() override;
     virtual upSimpleReport regenerateReport() override;
     virtual QStringList getReportLocators() const override;
 
@@ -45,6 +47,9 @@ namespace QTournament
     Category cat;
     int round;
 
+    bool isPrefetched{false};
+    RankingEntryListList rll;
+
     int determineBestPossibleRankForPlayerAfterRound(const PlayerPair& pp, int round) const;
     void printBestCaseList(upSimpleReport& rep) const;
   };
@@ -22,8 +22,10 @@
 #include "MatchMngr.h"
 #include "CatRoundStatus.h"
 #include "TournamentDB.h"
+#include "HelperFunc.h"
 #include "reports/AbstractReport.h"
 #include "PureRoundRobinCategory.h"
+#include "PairDisplayNameCache.h"
 
 MatchMatrix::MatchMatrix(SimpleReportGenerator* _rep, const QString& tabName, const Category& _cat, int _round, int _grpNum)
   :AbstractReportElement(_rep), tableName(tabName), cat(_cat), round(_round), grpNum(_grpNum), showMatchNumbersOnly(round <= 0)
@@ -42,7 +44,7 @@ MatchMatrix::MatchMatrix(SimpleReportGenerator* _rep, const QString& tabName, co
 
   if (msys == GROUPS_WITH_KO)
   {
-    KO_Config cfg{cat.getParameter_string(GROUP_CONFIG)};
+    KO_Config cfg = cat.getGroupConfig();
     if (round > cfg.getNumRounds())
     {
       throw invalid_argument("Requested match matrix a non-round-robin round!");
@@ -93,13 +95,19 @@ QRectF MatchMatrix::plot(const QPointF& topLeft)
   PlayerPairList ppList;
   ppList = cat.getPlayerPairs(grpNum);
 
+  // resolve all pair names with a single query; the
+  // header cells below will then be served from the cache
+  vector<int> pairIds;
+  for (const PlayerPair& pp : ppList) pairIds.push_back(pp.getPairId());
+  cat.getDatabaseHandle()->getPairDisplayNameCache()->getDisplayNames(pairIds);
+
   // determine the maximum round number up to
   // which will be searched for matches
   int maxRoundNum = 99999;  // default: search in whole category
   MATCH_SYSTEM msys = cat.getMatchSystem();
   if (msys == GROUPS_WITH_KO)
   {
-    KO_Config cfg = cat.getParameter_string(GROUP_CONFIG);
+    KO_Config cfg = cat.getGroupConfig();
 
     // in group matches, limit the search radius to the
     // group phase, because otherwise we might end up displaying
@@ -125,6 +133,9 @@ QRectF MatchMatrix::plot(const QPointF& topLeft)
     }
   }
 
+  // fetch all matches in the search radius at once
+  loadCellData(minRoundNum, maxRoundNum);
+
   // get the textstyle for the table contents
   TextStyle* baseStyle = rep->getTextStyle();
   assert(baseStyle != nullptr);
@@ -159,7 +170,7 @@ QRectF MatchMatrix::plot(const QPointF& topLeft)
       // get the cell's content
       QString txt;
       CELL_CONTENT_TYPE cct;
-      tie(cct, txt) = getCellContent(ppList, r, c, minRoundNum, maxRoundNum);
+      tie(cct, txt) = getCellContent(ppList, r, c);
 
       // special case: content == tableName
       if (cct == CELL_CONTENT_TYPE::TITLE)
@@ -199,42 +210,6 @@ QRectF MatchMatrix::plot(const QPointF& topLeft)
       // plot the contents. Call the "multiline"-function even although we
       // sometime have only one line of text. That doesn't do any harm-.
       rep->drawMultilineText(cell, posInCell, txtBasePoint, txt, CENTER, 0.15 * style->getFontSize_MM(), style);
-
-      // draw the "mirrored" match result, if applicable
-      //
-      // this string-based approach is faster than calling again
-      // getMatchForCell() with swapped row/column values
-      if (cct == CELL_CONTENT_TYPE::SCORE)
-      {
-        QString swappedScore;
-        for (QString gameScore : txt.split("\n"))
-        {
-          gameScore = gameScore.trimmed();
-          QStringList scores = gameScore.split(" : ");
-          if (scores.length() > 1)
-          {
-            QString sc1 = scores.at(0);
-            QString sc2 = scores.at(1);
-            if (sc2.endsWith(",")) sc2.chop(1);
-
-            QString s = "%1 : %2\n";
-            swappedScore += s.arg(sc2).arg(sc1);
-          } else {
-            swappedScore += gameScore + "\n";  // in this case, the value of "gamescore" is "walkover";
-          }
-        }
-        swappedScore.chop(1);
-        auto mirroredCell = grid.getCell(c, r);
-        rep->drawMultilineText(mirroredCell, posInCell, txtBasePoint, swappedScore, CENTER, 0.15 * style->getFontSize_MM(), style);
-      }
-
-      // draw the "mirrored" match number
-      if (cct == CELL_CONTENT_TYPE::MATCH_NUMBER)
-      {
-        auto mirroredCell = grid.getCell(c, r);
-        mirroredCell.adjust(0, GAP_TEXT_TO_GRID__MM, -GAP_TEXT_TO_GRID__MM, 0);
-        rep->drawText(mirroredCell, posInCell, txtBasePoint, txt, style);
-      }
     }
   }
 
@@ -243,87 +218,115 @@ QRectF MatchMatrix::plot(const QPointF& topLeft)
 
 //----------------------------------------------------------------------------
 
-upMatch MatchMatrix::getMatchForCell(const PlayerPairList& ppList, int row, int col, int minRound, int maxRound) const
+/**
+ * Fetches all matches of the category within a given round range with
+ * one single query and stores the pre-rendered cell contents in a
+ * map, keyed by (lower pair ID, higher pair ID).
+ *
+ * If there are multiple matches between the same two pairs in the
+ * round range, the match with the lowest ID wins.
+ *
+ * @param minRound the lowest round number to include
+ * @param maxRound the highest round number to include
+ */
+void MatchMatrix::loadCellData(int minRound, int maxRound)
 {
-  if ((row < 1) || (col < 1) || (row > ppList.size()) || (col > ppList.size()))
-  {
-    return nullptr;
-  }
+  cellData.clear();
 
-  PlayerPair ppRow = ppList.at(row - 1);
-  PlayerPair ppCol = ppList.at(col - 1);
+  QString sql = "SELECT ma.%1, ma.%2, COALESCE(ma.%3, -1), ma.%4, mg.%5, COALESCE(ma.%6, ''), (ma.%7 IS NULL), COALESCE(ma.%8, -1) ";
+  sql += "FROM %9 ma JOIN %10 mg ON ma.%11 = mg.id ";
+  sql += "WHERE mg.%12 = %13 AND mg.%5 >= %14 AND mg.%5 <= %15 ";
+  sql += "AND ma.%1 IS NOT NULL AND ma.%2 IS NOT NULL ORDER BY ma.id";
+  sql = sql.arg(MA_PAIR1_REF).arg(MA_PAIR2_REF).arg(MA_NUM).arg(GENERIC_STATE_FIELD_NAME);
+  sql = sql.arg(MG_ROUND).arg(MA_RESULT).arg(MA_FINISH_TIME).arg(MA_PACKED_RESULT);
+  sql = sql.arg(TAB_MATCH).arg(TAB_MATCH_GROUP).arg(MA_GRP_REF);
+  sql = sql.arg(MG_CAT_REF).arg(cat.getId()).arg(minRound).arg(maxRound);
 
-  // create a direct, low-level database query for the
-  // applicable matches
   TournamentDB* db = cat.getDatabaseHandle();
-  MatchMngr mm{db};
-  QString where = "(%1 = %2 AND %3 = %4) OR (%1 = %4 AND %3 = %2)";
-  where = where.arg(MA_PAIR1_REF).arg(ppRow.getPairId());
-  where = where.arg(MA_PAIR2_REF).arg(ppCol.getPairId());
-  DbTab* matchTab = db->getTab(TAB_MATCH);
-  DbTab::CachingRowIterator it = matchTab->getRowsByWhereClause(where.toUtf8().constData());
-  while (!(it.isEnd()))
-  {
-    auto ma = mm.getMatch((*it).getId());
-    assert(ma != nullptr);
+  auto stmt = db->execContentQuery(sql.toUtf8().constData());
+  if (stmt == nullptr) return;
 
-    // check for right category and the right round number
-    int r = ma->getMatchGroup().getRound();
-    if ((ma->getCategory() == cat) && (r >= minRound) && (r <= maxRound))
+  while (stmt->hasData())
+  {
+    int pp1Id;
+    int pp2Id;
+    int maStateId;
+    int finishTimeIsNull;
+    int packedResult;
+    string result;
+    MatrixCellData mcd;
+    stmt->getInt(0, &pp1Id);
+    stmt->getInt(1, &pp2Id);
+    stmt->getInt(2, &(mcd.maNum));
+    stmt->getInt(3, &maStateId);
+    stmt->getInt(4, &(mcd.maRound));
+    stmt->getString(5, &result);
+    stmt->getInt(6, &finishTimeIsNull);
+    stmt->getInt(7, &packedResult);
+    mcd.maState = static_cast<OBJ_STATE>(maStateId);
+
+    // if the match is finished but has no finish time,
+    // it has been won by a walkover
+    mcd.isWalkover = ((mcd.maState == STAT_MA_FINISHED) && (finishTimeIsNull != 0));
+
+    // render the score from both perspectives, one line per game.
+    //
+    // prefer the packed score and use the score string only as a fallback
+    auto score = (packedResult > 0) ? MatchScore::fromPackedInt(packedResult) : nullptr;
+    if ((score == nullptr) && !(result.empty()))
     {
-      return ma;
+      score = MatchScore::fromStringWithoutValidation(stdString2QString(result));
     }
+    if (score != nullptr)
+    {
+      bool pp1IsLower = (pp1Id < pp2Id);
+      for (int g=0; g < score->getNumGames(); ++g)
+      {
+        auto gameScore = score->getGame(g);
+        assert(gameScore != nullptr);
 
-    ++it;
-  }
+        int sc1;
+        int sc2;
+        tie(sc1, sc2) = gameScore->getScore();
 
-  return nullptr;
+        QString s = "%1 : %2\n";
+        mcd.scoreFromLowerPairId += pp1IsLower ? s.arg(sc1).arg(sc2) : s.arg(sc2).arg(sc1);
+        mcd.scoreFromHigherPairId += pp1IsLower ? s.arg(sc2).arg(sc1) : s.arg(sc1).arg(sc2);
+      }
+      mcd.scoreFromLowerPairId.chop(1);
+      mcd.scoreFromHigherPairId.chop(1);
+    }
+
+    // "emplace" doesn't overwrite existing entries; thus,
+    // the match with the lowest ID wins
+    auto key = make_pair(min(pp1Id, pp2Id), max(pp1Id, pp2Id));
+    cellData.emplace(key, mcd);
+
+    stmt->step();
+  }
 }
 
 //----------------------------------------------------------------------------
 
-QStringList MatchMatrix::getSortedMatchScoreStrings(const Match& ma, const PlayerPair& ppRow, const PlayerPair& ppCol) const
+const MatrixCellData* MatchMatrix::getCellData(const PlayerPairList& ppList, int row, int col) const
 {
-  PlayerPair pp1 = ma.getPlayerPair1();
-  PlayerPair pp2 = ma.getPlayerPair2();
-  if (!(  ((pp1 == ppRow) && (pp2 == ppCol)) || ((pp2 == ppRow) && (pp1 == ppCol))  ) )
+  if ((row < 1) || (col < 1) || (row > ppList.size()) || (col > ppList.size()))
   {
-    return QStringList();
+    return nullptr;
   }
 
-  bool mustSwapScore = (ppRow == pp2);
-
-  auto score = ma.getScore();
-  if (score == nullptr) return QStringList();
-
-  QStringList result;
-  for (int g=0; g < score->getNumGames(); ++g)
-  {
-    auto gameScore = score->getGame(g);
-    assert(gameScore != nullptr);
-
-    int sc1;
-    int sc2;
-    tie(sc1, sc2) = gameScore->getScore();
+  int ppRowId = ppList.at(row - 1).getPairId();
+  int ppColId = ppList.at(col - 1).getPairId();
 
-    if (mustSwapScore)
-    {
-      int tmp = sc1;
-      sc1 = sc2;
-      sc2 = tmp;
-    }
-
-    QString s = "%1 : %2";
-    s = s.arg(sc1).arg(sc2);
-    result.append(s);
-  }
+  auto it = cellData.find(make_pair(min(ppRowId, ppColId), max(ppRowId, ppColId)));
+  if (it == cellData.end()) return nullptr;
 
-  return result;
+  return &(it->second);
 }
 
 //----------------------------------------------------------------------------
 
-tuple<MatchMatrix::CELL_CONTENT_TYPE, QString> MatchMatrix::getCellContent(const PlayerPairList& ppList, int row, int col, int minRound, int maxRound) const
+tuple<MatchMatrix::CELL_CONTENT_TYPE, QString> MatchMatrix::getCellContent(const PlayerPairList& ppList, int row, int col) const
 {
   // the table name goes in the top-left corner
   if ((row == 0) && (col == 0))
@@ -337,27 +340,27 @@ tuple<MatchMatrix::CELL_CONTENT_TYPE, QString> MatchMatrix::getCellContent(const
     return make_tuple(CELL_CONTENT_TYPE::HEADER, ppList.at(row + col - 1).getDisplayName());
   }
 
-  // for every cell above the diagonal, check for
+  // for every cell except the diagonal, check for
   // the associated match and print the score
   // or the match number, if applicable
-  if ((row > 0) && (col > row))
+  if ((row > 0) && (col > 0) && (col != row))
   {
-    auto ma = getMatchForCell(ppList, row, col, minRound, maxRound);
+    const MatrixCellData* mcd = getCellData(ppList, row, col);
 
-    if (ma == nullptr)
+    if (mcd == nullptr)
     {
       return make_tuple(CELL_CONTENT_TYPE::EMPTY, QString());
     }
 
-    int maRound = ma->getMatchGroup().getRound();
-    OBJ_STATE maStat = ma->getState();
+    int maRound = mcd->maRound;
+    OBJ_STATE maStat = mcd->maState;
 
     // if the match is later than "round", print only
     // the match number. The same applies if the match
     // is not yet finished
     if ((maRound > round) || (maStat != STAT_MA_FINISHED) || (showMatchNumbersOnly))
     {
-      int maNum = ma->getMatchNumber();
+      int maNum = mcd->maNum;
       if (maNum < 0)
       {
         // no score, no match number. nothing more to do.
@@ -372,20 +375,13 @@ tuple<MatchMatrix::CELL_CONTENT_TYPE, QString> MatchMatrix::getCellContent(const
     if ((maRound <= round) && (maStat == STAT_MA_FINISHED))
     {
       // the match is in the correct round range and is finished,
-      // so we print the score
-      PlayerPair ppRow = ppList.at(row - 1);
-      PlayerPair ppCol = ppList.at(col - 1);
-      QStringList scList = getSortedMatchScoreStrings(*ma, ppRow, ppCol);
-
-      QString txt;
-      for (const QString& l : scList)
-      {
-        txt += l + "\n";
-      }
-      txt.chop(1);
+      // so we print the score from the row's perspective
+      int ppRowId = ppList.at(row - 1).getPairId();
+      int ppColId = ppList.at(col - 1).getPairId();
+      QString txt = (ppRowId < ppColId) ? mcd->scoreFromLowerPairId : mcd->scoreFromHigherPairId;
 
       // add a line "walkover", if necessary
-      if (ma->isWonByWalkover())
+      if (mcd->isWalkover)
       {
         txt += "\n" + tr("walkover");
       }
@@ -419,11 +415,14 @@ QString MatchMatrix::getTruncatedPlayerNames(const PlayerPair& pp, const TextSty
   // a little helper function that truncates a player name
   // until it fits to a maximum width
   auto truncPlayerName = [&](const Player& _p, const QString& postfix) {
-    int fullLen = _p.getDisplayName().length();
+    // read the names only once and not for every iteration
+    QString first = _p.getFirstName();
+    QString last = _p.getLastName();
+    int fullLen = Player::formatDisplayName(first, last).length();
     QString truncName;
     for (int len = fullLen; len > 3; --len)
     {
-      truncName = _p.getDisplayName(len) + postfix;
+      truncName = Player::formatDisplayName(first, last, len) + postfix;
       double width = rep->getTextDimensions_MM(truncName, style).width();
       if (width <= maxWidth) break;
     }
@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <tuple>
+#include <unordered_map>
 
 #include <QObject>
 
@@ -51,6 +52,31 @@ private:
 
 //----------------------------------------------------------------------------
 
+// all data that is necessary to fill the two cells of a match
+// between two player pairs, pre-rendered from one database row
+struct MatrixCellData
+{
+  int maNum;
+  OBJ_STATE maState;
+  int maRound;
+  bool isWalkover;
+  QString scoreFromLowerPairId;   // score text from the perspective of the pair with the lower ID
+  QString scoreFromHigherPairId;  // score text from the perspective of the pair with the higher ID
+};
+
+// hash function for (minPairId, maxPairId) keys
+struct PairIdHash
+{
+  size_t operator()(const pair<int, int>& p) const
+  {
+    return hash<int>()(p.first) ^ (hash<int>()(p.second) << 1);
+  }
+};
+
+using MatrixCellDataMap = unordered_map<pair<int, int>, MatrixCellData, PairIdHash>;
+
+//----------------------------------------------------------------------------
+
 class MatchMatrix : public QObject, AbstractReportElement
 {
   Q_OBJECT
@@ -76,10 +102,11 @@ protected:
   int round;
   int grpNum;
   bool showMatchNumbersOnly;
+  MatrixCellDataMap cellData;
 
-  upMatch getMatchForCell(const PlayerPairList& ppList, int row, int col, int minRound, int maxRound) const;
-  QStringList getSortedMatchScoreStrings(const Match& ma, const PlayerPair& ppRow, const PlayerPair& ppCol) const;
-  tuple<CELL_CONTENT_TYPE, QString> getCellContent(const PlayerPairList& ppList, int row, int col, int minRound, int maxRound) const;
+  void loadCellData(int minRound, int maxRound);
+  const MatrixCellData* getCellData(const PlayerPairList& ppList, int row, int col) const;
+  tuple<CELL_CONTENT_TYPE, QString> getCellContent(const PlayerPairList& ppList, int row, int col) const;
   QString getTruncatedPlayerNames(const PlayerPair& pp, const TextStyle* style, double maxWidth) const;
 };
 
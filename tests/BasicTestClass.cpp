@@ -26,6 +26,7 @@
 #include "../PlayerMngr.h"
 
 #include "BasicTestClass.h"
+#include "LargeTournamentGenerator.h"
 
 namespace boostfs = boost::filesystem;
 
@@ -152,3 +153,26 @@ void BasicTestFixture::getScenario03(unique_ptr<TournamentDB>& result) const
   e = cm.startCategory(rr, {}, {});
   ASSERT_EQ(OK, e);
 }
+
+//----------------------------------------------------------------------------
+
+void BasicTestFixture::getLargeScenario(unique_ptr<TournamentDB>& result, unique_ptr<LargeTournamentGenerator>& gen,
+                                        LargeScenarioSize size) const
+{
+  LargeTournamentConfig cfg;
+  cfg.nCourts = 4;
+  if (size == LargeScenarioSize::Small)
+  {
+    cfg.nPlayers = 60;
+    cfg.nCategories = 3;
+    cfg.entriesPerCategory = 8;
+  } else {
+    cfg.nPlayers = 100;
+    cfg.nCategories = 5;
+    cfg.entriesPerCategory = 16;
+  }
+
+  gen = make_unique<LargeTournamentGenerator>(cfg);
+  result = gen->generate();
+  ASSERT_TRUE(result != nullptr);
+}
@@ -34,8 +34,16 @@ class EmptyFixture
 
 namespace QTournament {
   class TournamentDB;
+  class LargeTournamentGenerator;
 }
 
+// the sizes of the tournaments provided by getLargeScenario()
+enum class LargeScenarioSize
+{
+  Small,    // 60 players, 3 categories with 8 entries each, 4 courts
+  Medium,   // 100 players, 5 categories with 16 entries each, 4 courts
+};
+
 class BasicTestFixture : public ::testing::Test
 {
 protected:
@@ -52,6 +60,11 @@ protected:
   void getScenario02(unique_ptr<QTournament::TournamentDB>& result) const;
   void getScenario03(unique_ptr<QTournament::TournamentDB>& result) const;
 
+  // a tournament with started categories, created by the LargeTournamentGenerator;
+  // the generator is needed for later steps like scheduling or playing matches
+  void getLargeScenario(unique_ptr<QTournament::TournamentDB>& result, unique_ptr<QTournament::LargeTournamentGenerator>& gen,
+                        LargeScenarioSize size) const;
+
 };
 
 #endif /* BASICTESTCLASS_H */
@@ -0,0 +1,476 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include <QStringList>
+#include <QtGlobal>
+
+#include "LargeTournamentGenerator.h"
+
+#include "TournamentDB.h"
+#include "CatMngr.h"
+#include "CourtMngr.h"
+#include "MatchMngr.h"
+#include "PlayerMngr.h"
+#include "TeamMngr.h"
+#include "KO_Config.h"
+#include "Score.h"
+
+namespace QTournament
+{
+  namespace
+  {
+    constexpr int nTeams = 40;
+
+    // number of groups in GROUPS_WITH_KO categories; must
+    // match the KO_START in addCategory()
+    constexpr int nKoGroups = 8;
+
+    const vector<MATCH_TYPE> allMatchTypes{SINGLES, DOUBLES, MIXED};
+  }
+
+  //----------------------------------------------------------------------------
+
+  LargeTournamentGenerator::LargeTournamentGenerator(const LargeTournamentConfig& _cfg)
+    :cfg{_cfg}
+  {
+    if ((cfg.entriesPerCategory < nKoGroups) || ((cfg.entriesPerCategory % nKoGroups) != 0) || (cfg.entriesPerCategory > 32))
+    {
+      throw std::invalid_argument("LargeTournamentGenerator: entries per category must be 8, 16, 24 or 32");
+    }
+
+    // mixed and doubles categories need twice as many players
+    // of the same sex as singles categories
+    if ((cfg.nPlayers / 2) < (2 * cfg.entriesPerCategory))
+    {
+      throw std::invalid_argument("LargeTournamentGenerator: not enough players for the requested category size");
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Creates a new in-memory tournament with teams, players, courts
+   * and categories as defined in the generator configuration.
+   *
+   * @return the database of the new tournament
+   */
+  unique_ptr<TournamentDB> LargeTournamentGenerator::generate()
+  {
+    TournamentSettings ts;
+    ts.organizingClub = "Benchmark Club";
+    ts.tournamentName = "Large Tournament";
+    ts.useTeams = true;
+    ts.refereeMode = REFEREE_MODE::NONE;
+    auto db = TournamentDB::createNew(":memory:", ts);
+    if (db == nullptr)
+    {
+      throw std::runtime_error("LargeTournamentGenerator: could not create the database");
+    }
+
+    // make the random match results reproducible
+    qsrand(cfg.seed);
+
+    createPlayers(db.get());
+    createCourts(db.get());
+
+    for (int i=0; i < cfg.nCategories; ++i)
+    {
+      int catId = addCategory(db.get(), i);
+
+      if (cfg.startCategories)
+      {
+        ERR e = startCategory(db.get(), catId);
+        if (e != OK)
+        {
+          throw std::runtime_error("LargeTournamentGenerator: could not start category");
+        }
+      }
+    }
+
+    return db;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Creates a new category, fills it with players and freezes it.
+   *
+   * Match system, match type and sex are derived from the category
+   * index so that all combinations occur in the tournament.
+   *
+   * @param db the database to create the category in
+   * @param catIdx a running index for the category; also determines the category name
+   *
+   * @return the ID of the new category
+   */
+  int LargeTournamentGenerator::addCategory(TournamentDB* db, int catIdx)
+  {
+    CatMngr cm{db};
+    PlayerMngr pm{db};
+
+    QString catName = QString("Cat %1").arg(catIdx + 1);
+    ERR e = cm.createNewCategory(catName);
+    if (e != OK)
+    {
+      throw std::runtime_error("LargeTournamentGenerator: could not create category");
+    }
+    Category cat = cm.getCategory(catName);
+
+    const vector<MATCH_SYSTEM>& allSystems = getSupportedMatchSystems();
+    int nSystems = static_cast<int>(allSystems.size());
+    MATCH_SYSTEM ms = allSystems[catIdx % nSystems];
+    MATCH_TYPE mt = allMatchTypes[(catIdx / nSystems) % allMatchTypes.size()];
+    SEX sex = (((catIdx / (nSystems * allMatchTypes.size())) % 2) == 0) ? M : F;
+
+    cm.setSex(cat, sex);
+    cm.setMatchType(cat, mt);
+    cm.setMatchSystem(cat, ms);
+    if (ms == GROUPS_WITH_KO)
+    {
+      GroupDefList gdl;
+      gdl.append(GroupDef(cfg.entriesPerCategory / nKoGroups, nKoGroups));
+      KO_Config ko{QUARTER, false, gdl};
+      cm.setCatParameter(cat, GROUP_CONFIG, ko.toString());
+    }
+
+    // pick the players; the offset makes sure that
+    // each category gets a different set of players
+    int offset = catIdx * 37;
+    int n = cfg.entriesPerCategory;
+    const vector<int>& pool = (sex == M) ? maleIds : femaleIds;
+    vector<pair<int, int>> pairs;
+    vector<int> playerIds;
+    if (mt == SINGLES)
+    {
+      playerIds = pickPlayers(pool, offset, n);
+    }
+    if (mt == DOUBLES)
+    {
+      playerIds = pickPlayers(pool, offset, 2 * n);
+      for (int i=0; i < n; ++i)
+      {
+        pairs.push_back(make_pair(playerIds[2*i], playerIds[2*i + 1]));
+      }
+    }
+    if (mt == MIXED)
+    {
+      vector<int> men = pickPlayers(maleIds, offset, n);
+      vector<int> women = pickPlayers(femaleIds, offset, n);
+      for (int i=0; i < n; ++i)
+      {
+        pairs.push_back(make_pair(men[i], women[i]));
+      }
+      playerIds = men;
+      playerIds.insert(playerIds.end(), women.begin(), women.end());
+    }
+
+    vector<pair<int, int>> playerAndCatIds;
+    for (int id : playerIds)
+    {
+      playerAndCatIds.push_back(make_pair(id, cat.getId()));
+    }
+    e = cm.addPlayersToCategories(playerAndCatIds);
+    if (e != OK)
+    {
+      throw std::runtime_error("LargeTournamentGenerator: could not add players to category");
+    }
+
+    for (const pair<int, int>& p : pairs)
+    {
+      e = cm.pairPlayers(cat, pm.getPlayer(p.first), pm.getPlayer(p.second));
+      if (e != OK)
+      {
+        throw std::runtime_error("LargeTournamentGenerator: could not pair players");
+      }
+    }
+
+    e = cm.freezeConfig(cat);
+    if (e != OK)
+    {
+      throw std::runtime_error("LargeTournamentGenerator: could not freeze category");
+    }
+
+    return cat.getId();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Starts a frozen category.
+   *
+   * The initial seeding is the order of the player pairs in the
+   * database; groups are filled in a round-robin manner.
+   *
+   * @param db the database containing the category
+   * @param catId the ID of a frozen category
+   * @param progressNotificationQueue an optional queue that is passed on to CatMngr::startCategory()
+   *
+   * @return the error code of CatMngr::startCategory()
+   */
+  ERR LargeTournamentGenerator::startCategory(TournamentDB* db, int catId, ProgressQueue* progressNotificationQueue)
+  {
+    CatMngr cm{db};
+    auto cat = cm.getCategory(catId);
+    if (cat == nullptr) return INVALID_ID;
+
+    PlayerPairList seed = cat->getPlayerPairs();
+    vector<PlayerPairList> grpCfg;
+    if (cat->getMatchSystem() == GROUPS_WITH_KO)
+    {
+      grpCfg.resize(nKoGroups);
+      for (size_t i=0; i < seed.size(); ++i)
+      {
+        grpCfg[i % nKoGroups].push_back(seed[i]);
+      }
+      seed.clear();
+    }
+
+    return cm.startCategory(*cat, grpCfg, seed, progressNotificationQueue);
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Stages all match groups up to a given round and schedules them.
+   *
+   * @param db the tournament database
+   * @param maxRound match groups of later rounds are not staged
+   *
+   * @return the number of staged match groups
+   */
+  int LargeTournamentGenerator::stageAndScheduleAll(TournamentDB* db, int maxRound)
+  {
+    MatchMngr mm{db};
+
+    // staging a group can promote other groups to IDLE,
+    // so we repeat until nothing changes anymore
+    int cnt = 0;
+    bool hasStaged = true;
+    while (hasStaged)
+    {
+      hasStaged = false;
+      for (const MatchGroup& mg : mm.getAllMatchGroups())
+      {
+        if (mg.getState() != STAT_MG_IDLE) continue;
+        if (mg.getRound() > maxRound) continue;
+
+        if (mm.stageMatchGroup(mg) == OK)
+        {
+          ++cnt;
+          hasStaged = true;
+        }
+      }
+    }
+
+    mm.scheduleAllStagedMatchGroups();
+
+    return cnt;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Calls matches until either all courts are busy, no further
+   * match is available or the maximum number of matches has been
+   * called.
+   *
+   * @param db the tournament database
+   * @param maxMatches the maximum number of matches to call
+   *
+   * @return the IDs of the called matches
+   */
+  vector<int> LargeTournamentGenerator::callMatches(TournamentDB* db, int maxMatches)
+  {
+    MatchMngr mm{db};
+    CourtMngr cm{db};
+
+    vector<int> result;
+    while (static_cast<int>(result.size()) < maxMatches)
+    {
+      int maId;
+      int coId;
+      if (mm.getNextViableMatchCourtPair(&maId, &coId) != OK) break;
+
+      auto ma = mm.getMatch(maId);
+      auto co = cm.getCourtById(coId);
+      if (mm.assignMatchToCourt(*ma, *co) != OK) break;
+
+      result.push_back(maId);
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Enters random results for a list of running matches.
+   *
+   * @param db the tournament database
+   * @param matchIds the IDs of the running matches
+   *
+   * @return the number of successfully finalized matches
+   */
+  int LargeTournamentGenerator::finishMatches(TournamentDB* db, const vector<int>& matchIds)
+  {
+    MatchMngr mm{db};
+
+    int cnt = 0;
+    for (int maId : matchIds)
+    {
+      auto ma = mm.getMatch(maId);
+      if (ma == nullptr) continue;
+
+      int round = ma->getMatchGroup().getRound();
+      bool isDrawAllowed = ma->getCategory().isDrawAllowedInRound(round);
+      auto score = MatchScore::genRandomScore(2, isDrawAllowed);
+
+      if (mm.setMatchScoreAndFinalizeMatch(*ma, *score) == OK) ++cnt;
+    }
+
+    return cnt;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Plays matches (call and random result) until no further match
+   * can be called or a maximum number of matches has been played.
+   *
+   * @param db the tournament database
+   * @param maxMatches the maximum number of matches to play
+   *
+   * @return the number of played matches
+   */
+  int LargeTournamentGenerator::playMatches(TournamentDB* db, int maxMatches)
+  {
+    int cnt = 0;
+    while (cnt < maxMatches)
+    {
+      vector<int> called = callMatches(db, std::min(cfg.nCourts, maxMatches - cnt));
+      if (called.empty()) break;
+
+      cnt += finishMatches(db, called);
+    }
+
+    return cnt;
+  }
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * @return all match systems that have a specialized category implementation
+   */
+  const vector<MATCH_SYSTEM>& LargeTournamentGenerator::getSupportedMatchSystems()
+  {
+    // RANDOMIZE is not implemented yet
+    static const vector<MATCH_SYSTEM> systems{GROUPS_WITH_KO, SINGLE_ELIM, RANKING, ROUND_ROBIN, SWISS_LADDER};
+    return systems;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void LargeTournamentGenerator::createPlayers(TournamentDB* db)
+  {
+    TeamMngr tm{db};
+    QStringList teamNames;
+    for (int i=0; i < nTeams; ++i)
+    {
+      teamNames.append(QString("Team %1").arg(i + 1));
+    }
+    ERR e = tm.createNewTeams(teamNames);
+    if (e != OK)
+    {
+      throw std::runtime_error("LargeTournamentGenerator: could not create teams");
+    }
+
+    vector<NewPlayerData> newPlayers;
+    for (int i=0; i < cfg.nPlayers; ++i)
+    {
+      SEX sex = ((i % 2) == 0) ? M : F;
+      newPlayers.push_back(NewPlayerData{
+                             QString("First%1").arg(i + 1),
+                             QString("Last%1").arg(i + 1),
+                             sex,
+                             teamNames[i % nTeams]
+                           });
+    }
+
+    PlayerMngr pm{db};
+    vector<int> ids;
+    e = pm.createNewPlayers(newPlayers, &ids);
+    if ((e != OK) || (ids.size() != newPlayers.size()))
+    {
+      throw std::runtime_error("LargeTournamentGenerator: could not create players");
+    }
+
+    maleIds.clear();
+    femaleIds.clear();
+    for (size_t i=0; i < ids.size(); ++i)
+    {
+      if (newPlayers[i].sex == M)
+      {
+        maleIds.push_back(ids[i]);
+      } else {
+        femaleIds.push_back(ids[i]);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  void LargeTournamentGenerator::createCourts(TournamentDB* db)
+  {
+    CourtMngr cm{db};
+    for (int i=1; i <= cfg.nCourts; ++i)
+    {
+      ERR e;
+      cm.createNewCourt(i, QString::number(i), &e);
+      if (e != OK)
+      {
+        throw std::runtime_error("LargeTournamentGenerator: could not create courts");
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  vector<int> LargeTournamentGenerator::pickPlayers(const vector<int>& pool, int offset, int cnt) const
+  {
+    if (cnt > static_cast<int>(pool.size()))
+    {
+      throw std::invalid_argument("LargeTournamentGenerator: player pool too small");
+    }
+
+    vector<int> result;
+    for (int i=0; i < cnt; ++i)
+    {
+      result.push_back(pool[(offset + i) % pool.size()]);
+    }
+
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+
+
+  //----------------------------------------------------------------------------
+
+}
@@ -0,0 +1,93 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LARGETOURNAMENTGENERATOR_H
+#define LARGETOURNAMENTGENERATOR_H
+
+#include <memory>
+#include <vector>
+
+#include "TournamentDataDefs.h"
+#include "TournamentErrorCodes.h"
+
+using namespace std;
+
+class ProgressQueue;
+
+namespace QTournament
+{
+  class TournamentDB;
+
+  /**
+   * The size and shape of a generated tournament
+   */
+  struct LargeTournamentConfig
+  {
+    int nPlayers = 2000;   // half of them male, half of them female
+    int nCategories = 60;
+    int nCourts = 20;
+    int entriesPerCategory = 32;   // players or pairs per category; multiple of 8, max. 32
+    bool startCategories = true;
+    unsigned int seed = 42;   // for the random match results
+  };
+
+  /**
+   * Creates large, realistic tournaments for benchmarks and
+   * stress tests.
+   *
+   * In contrast to the SQL-based data in tstQueryPlan, all objects
+   * are created through the regular managers, so the resulting
+   * tournament is consistent in terms of the tournament logic.
+   *
+   * The categories cycle through all implemented match systems
+   * and all match types. Players are assigned to categories in a
+   * rotating manner, so most players play in several categories.
+   */
+  class LargeTournamentGenerator
+  {
+  public:
+    LargeTournamentGenerator(const LargeTournamentConfig& _cfg = LargeTournamentConfig{});
+
+    // creates a complete tournament in an in-memory database
+    unique_ptr<TournamentDB> generate();
+
+    // single steps, e.g. for timing them individually;
+    // require a database that has been created by generate()
+    int addCategory(TournamentDB* db, int catIdx);
+    ERR startCategory(TournamentDB* db, int catId, ProgressQueue* progressNotificationQueue = nullptr);
+    int stageAndScheduleAll(TournamentDB* db, int maxRound = 1);
+    vector<int> callMatches(TournamentDB* db, int maxMatches);
+    int finishMatches(TournamentDB* db, const vector<int>& matchIds);
+    int playMatches(TournamentDB* db, int maxMatches);
+
+    static const vector<MATCH_SYSTEM>& getSupportedMatchSystems();
+
+  protected:
+    void createPlayers(TournamentDB* db);
+    void createCourts(TournamentDB* db);
+    vector<int> pickPlayers(const vector<int>& pool, int offset, int cnt) const;
+
+  private:
+    LargeTournamentConfig cfg;
+    vector<int> maleIds;
+    vector<int> femaleIds;
+  };
+
+}
+
+#endif // LARGETOURNAMENTGENERATOR_H
@@ -0,0 +1,330 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Benchmarks for the hot paths of a running tournament.
+ *
+ * All benchmarks operate on tournaments created by the
+ * LargeTournamentGenerator. Benchmarks that modify the database
+ * run each iteration in a transaction that is rolled back afterwards,
+ * so that every iteration starts from the same state.
+ *
+ * Use the "run_benchmarks" target for getting the results as JSON
+ * or call the executable with "--benchmark_out=<file>
+ * --benchmark_out_format=json".
+ */
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "TournamentDB.h"
+#include "CatMngr.h"
+#include "CourtMngr.h"
+#include "MatchMngr.h"
+#include "MatchTimePredictor.h"
+#include "PartialSyncString.h"
+#include "PlayerMngr.h"
+#include "RankingMngr.h"
+#include "TeamMngr.h"
+
+#include "LargeTournamentGenerator.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // the generated tournaments in increasing stages of progress;
+  // they are created on first use and shared by all benchmarks
+  enum class TournamentStage
+  {
+    Started,     // all categories started, nothing scheduled
+    Scheduled,   // all first-round matches scheduled
+    Played,      // all first-round matches played
+  };
+
+  struct GeneratedTournament
+  {
+    LargeTournamentGenerator gen;
+    unique_ptr<TournamentDB> db;
+  };
+
+  GeneratedTournament& getTournament(TournamentStage stage)
+  {
+    static GeneratedTournament started;
+    static GeneratedTournament scheduled;
+    static GeneratedTournament played;
+
+    GeneratedTournament* result = &started;
+    if (stage == TournamentStage::Scheduled) result = &scheduled;
+    if (stage == TournamentStage::Played) result = &played;
+
+    if (result->db == nullptr)
+    {
+      result->db = result->gen.generate();
+      if (stage != TournamentStage::Started)
+      {
+        result->gen.stageAndScheduleAll(result->db.get());
+      }
+      if (stage == TournamentStage::Played)
+      {
+        result->gen.playMatches(result->db.get(), std::numeric_limits<int>::max());
+      }
+    }
+
+    return *result;
+  }
+}
+
+//----------------------------------------------------------------------------
+
+static void BM_StartCategory(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Started);
+  TournamentDB* db = gt.db.get();
+
+  // the category index determines the match system; the offset
+  // avoids name clashes with the existing categories
+  int nSystems = static_cast<int>(LargeTournamentGenerator::getSupportedMatchSystems().size());
+  int catIdx = 100 * nSystems + static_cast<int>(state.range(0));
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto tg = db->acquireTransactionGuard(false);
+    int catId = gt.gen.addCategory(db, catIdx);
+    state.ResumeTiming();
+
+    ERR e = gt.gen.startCategory(db, catId);
+
+    state.PauseTiming();
+    tg.reset();  // rollback
+    state.ResumeTiming();
+
+    if (e != OK)
+    {
+      state.SkipWithError("Could not start category");
+      break;
+    }
+  }
+}
+BENCHMARK(BM_StartCategory)->DenseRange(0, 4)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+static void BM_StageAndSchedule(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Started);
+  TournamentDB* db = gt.db.get();
+
+  int nGroups = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto tg = db->acquireTransactionGuard(false);
+    state.ResumeTiming();
+
+    nGroups += gt.gen.stageAndScheduleAll(db);
+
+    state.PauseTiming();
+    tg.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(nGroups);
+}
+BENCHMARK(BM_StageAndSchedule)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+static void BM_CallMatches(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Scheduled);
+  TournamentDB* db = gt.db.get();
+
+  int nMatches = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto tg = db->acquireTransactionGuard(false);
+    state.ResumeTiming();
+
+    nMatches += gt.gen.callMatches(db, std::numeric_limits<int>::max()).size();
+
+    state.PauseTiming();
+    tg.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(nMatches);
+}
+BENCHMARK(BM_CallMatches)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+static void BM_EnterResults(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Scheduled);
+  TournamentDB* db = gt.db.get();
+
+  int nMatches = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto tg = db->acquireTransactionGuard(false);
+    vector<int> called = gt.gen.callMatches(db, std::numeric_limits<int>::max());
+    state.ResumeTiming();
+
+    nMatches += gt.gen.finishMatches(db, called);
+
+    state.PauseTiming();
+    tg.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(nMatches);
+}
+BENCHMARK(BM_EnterResults)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+static void BM_RankingSort(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Played);
+  TournamentDB* db = gt.db.get();
+
+  CatMngr cm{db};
+  RankingMngr rm{db};
+  CategoryList allCats = cm.getAllCategories();
+
+  int nCats = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto tg = db->acquireTransactionGuard(false);
+    state.ResumeTiming();
+
+    for (const Category& cat : allCats)
+    {
+      ERR e;
+      rm.sortRankingEntriesForLastRound(cat, &e);
+      if (e == OK) ++nCats;
+    }
+
+    state.PauseTiming();
+    tg.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(nCats);
+}
+BENCHMARK(BM_RankingSort)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+static void BM_MatchTimePrediction(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Scheduled);
+  TournamentDB* db = gt.db.get();
+
+  // a few finished and a few running matches
+  // provide the input for the prediction
+  auto tg = db->acquireTransactionGuard(false);
+  gt.gen.playMatches(db, 100);
+  gt.gen.callMatches(db, std::numeric_limits<int>::max());
+
+  size_t nPredictions = 0;
+  for (auto _ : state)
+  {
+    MatchTimePredictor mtp{db};
+    nPredictions += mtp.getMatchTimePrediction().size();
+  }
+
+  state.SetItemsProcessed(nPredictions);
+}
+BENCHMARK(BM_MatchTimePrediction)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+static void BM_FullSyncString(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Played);
+  TournamentDB* db = gt.db.get();
+
+  // same order as in OnlineMngr::doFullSync()
+  size_t nBytes = 0;
+  for (auto _ : state)
+  {
+    string csv;
+    csv += CourtMngr{db}.getSyncString({});
+    csv += TeamMngr{db}.getSyncString({});
+    PlayerMngr pm{db};
+    csv += pm.getSyncString({});
+    csv += pm.getSyncString_P2C({});
+    csv += pm.getSyncString_Pairs({});
+    csv += CatMngr{db}.getSyncString({});
+    MatchMngr mm{db};
+    csv += mm.getSyncString({});
+    csv += mm.getSyncString_MatchGroups({});
+    csv += RankingMngr{db}.getSyncString({});
+
+    nBytes += csv.size();
+  }
+
+  state.SetBytesProcessed(nBytes);
+}
+BENCHMARK(BM_FullSyncString)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+static void BM_PartialSyncString(benchmark::State& state)
+{
+  GeneratedTournament& gt = getTournament(TournamentStage::Scheduled);
+  TournamentDB* db = gt.db.get();
+
+  db->enableChangeLog(true);
+
+  size_t nBytes = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    db->getAllChangesAndClearQueue();
+    auto tg = db->acquireTransactionGuard(false);
+    gt.gen.finishMatches(db, gt.gen.callMatches(db, std::numeric_limits<int>::max()));
+    state.ResumeTiming();
+
+    string csv = changeLogToPartialSyncString(db, db->getAllChangesAndClearQueue(), db->getSeqNumShiftsAndClearQueue());
+    nBytes += csv.size();
+
+    state.PauseTiming();
+    tg.reset();
+    state.ResumeTiming();
+  }
+
+  db->enableChangeLog(false);
+  db->getAllChangesAndClearQueue();
+
+  state.SetBytesProcessed(nBytes);
+}
+BENCHMARK(BM_PartialSyncString)->Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
@@ -0,0 +1,207 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro-benchmarks comparing the mutex-based ThreadSafeQueue
+ * with the lock-free BoundedLockFreeQueue.
+ *
+ * The multi-threaded benchmarks use benchmark's own threads as
+ * producers and a separate consumer thread that drains the queue.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../LockFreeQueue.h"
+#include "../ThreadSafeQueue.h"
+
+namespace
+{
+  constexpr int BatchSize = 1000;
+
+  // a consumer thread that runs while the benchmark's producer
+  // threads are active and takes values out of the queue
+  template <typename Q>
+  class Consumer
+  {
+  public:
+    using PopFunc = bool (*)(Q&);
+
+    Consumer(Q& _q, PopFunc _pop)
+      :q{_q}, pop{_pop}, isRunning{true}, t{[this]() { run(); }} {}
+
+    ~Consumer()
+    {
+      isRunning = false;
+      t.join();
+    }
+
+  private:
+    void run()
+    {
+      while (isRunning)
+      {
+        if (!(pop(q))) std::this_thread::yield();
+      }
+      while (pop(q)) {}
+    }
+
+    Q& q;
+    PopFunc pop;
+    std::atomic<bool> isRunning;
+    std::thread t;
+  };
+
+  using LockFreeIntQueue = BoundedLockFreeQueue<int>;
+
+  bool popOne(ThreadSafeIntQueue& q)
+  {
+    return (q.nonblockingPop() != nullptr);
+  }
+
+  bool popOne(LockFreeIntQueue& q)
+  {
+    int val;
+    return q.tryPop(val);
+  }
+}
+
+//----------------------------------------------------------------------------
+
+// single thread: push a batch of values, then pop them again
+static void BM_ThreadSafeQueue_PushPop(benchmark::State& state)
+{
+  ThreadSafeIntQueue q;
+  for (auto _ : state)
+  {
+    for (int i = 0; i < BatchSize; ++i) q.push(i);
+    for (int i = 0; i < BatchSize; ++i) benchmark::DoNotOptimize(q.nonblockingPop());
+  }
+  state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK(BM_ThreadSafeQueue_PushPop);
+
+static void BM_LockFreeQueue_PushPop(benchmark::State& state)
+{
+  LockFreeIntQueue q{BatchSize};
+  int val = 0;
+  for (auto _ : state)
+  {
+    for (int i = 0; i < BatchSize; ++i) q.tryPush(i);
+    for (int i = 0; i < BatchSize; ++i)
+    {
+      q.tryPop(val);
+      benchmark::DoNotOptimize(val);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK(BM_LockFreeQueue_PushPop);
+
+static void BM_LockFreeQueue_PushPopBatch(benchmark::State& state)
+{
+  LockFreeIntQueue q{BatchSize};
+  vector<int> vals;
+  vals.reserve(BatchSize);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < BatchSize; ++i) q.tryPush(i);
+    vals.clear();
+    q.popBatch(vals, BatchSize);
+    benchmark::DoNotOptimize(vals.data());
+  }
+  state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK(BM_LockFreeQueue_PushPopBatch);
+
+//----------------------------------------------------------------------------
+
+// one or more producers and one consumer thread
+static void BM_ThreadSafeQueue_Contended(benchmark::State& state)
+{
+  static ThreadSafeIntQueue q;
+  static unique_ptr<Consumer<ThreadSafeIntQueue>> consumer;
+
+  if (state.thread_index() == 0)
+  {
+    consumer.reset(new Consumer<ThreadSafeIntQueue>{q, popOne});
+  }
+
+  for (auto _ : state)
+  {
+    for (int i = 0; i < BatchSize; ++i) q.push(i);
+  }
+
+  if (state.thread_index() == 0) consumer.reset();
+  state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK(BM_ThreadSafeQueue_Contended)->ThreadRange(1, 4)->UseRealTime();
+
+static void BM_LockFreeQueue_Contended(benchmark::State& state)
+{
+  static LockFreeIntQueue q{4096};
+  static unique_ptr<Consumer<LockFreeIntQueue>> consumer;
+
+  if (state.thread_index() == 0)
+  {
+    consumer.reset(new Consumer<LockFreeIntQueue>{q, popOne});
+  }
+
+  for (auto _ : state)
+  {
+    for (int i = 0; i < BatchSize; ++i) q.push(i);
+  }
+
+  if (state.thread_index() == 0) consumer.reset();
+  state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK(BM_LockFreeQueue_Contended)->ThreadRange(1, 4)->UseRealTime();
+
+//----------------------------------------------------------------------------
+
+// the progress notification path as used during category start
+static void BM_ProgressQueue_Step(benchmark::State& state)
+{
+  ProgressQueue pq{BatchSize};
+  vector<int> vals;
+  vals.reserve(ProgressQueue::Capacity);
+  for (auto _ : state)
+  {
+    pq.reset(BatchSize);
+    for (int i = 0; i < BatchSize; ++i)
+    {
+      pq.step();
+
+      // emulate a UI thread that polls every now and then
+      if ((i % 100) == 0)
+      {
+        vals.clear();
+        pq.popBatch(vals, ProgressQueue::Capacity);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK(BM_ProgressQueue_Step);
+
+//----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
@@ -0,0 +1,378 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * A headless driver that plays a complete tournament without the GUI.
+ *
+ * The driver either opens an existing tournament file or generates
+ * a large tournament with the LargeTournamentGenerator. It then runs
+ * the tournament like a tournament director would: stage and schedule
+ * all available rounds, call matches on free courts, enter results,
+ * handle intermediate seeding, until all categories are finalized.
+ *
+ * Match durations are taken from a simulated clock; the clock only
+ * determines the order in which matches are finished. The time stamps
+ * in the database are still the real ones.
+ *
+ * For each operation the driver records the latency and the number of
+ * executed SQL statements and prints a summary with latency histograms
+ * at the end. The exit code is non-zero if not all categories could be
+ * finalized.
+ *
+ * If the code has been compiled with QTOURNAMENT_ENABLE_TRACING,
+ * "--trace <file>" writes a Chrome trace of the simulation.
+ *
+ * Usage: QTournament_Simulation [--db <file>] [--players <n>]
+ *          [--categories <n>] [--courts <n>] [--seed <n>] [--trace <file>]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <QString>
+#include <QtGlobal>
+
+#include "TournamentDB.h"
+#include "CatMngr.h"
+#include "CourtMngr.h"
+#include "MatchMngr.h"
+#include "Score.h"
+#include "HotPathTracer.h"
+#include "SqlProfiler.h"
+
+#include "LargeTournamentGenerator.h"
+
+using namespace QTournament;
+
+namespace
+{
+  /**
+   * Latencies and SQL statement counts of one type of operation
+   */
+  class OperationStats
+  {
+  public:
+    void add(long usecs, long nStatements)
+    {
+      latencies.push_back(usecs);
+      totalStatements += nStatements;
+
+      // bucket i contains all latencies in [2^(i-1), 2^i) microseconds
+      size_t bucket = 0;
+      while ((bucket < 63) && (usecs >= (1L << bucket))) ++bucket;
+      if (histogram.size() <= bucket) histogram.resize(bucket + 1, 0);
+      ++histogram[bucket];
+    }
+
+    void print(const string& opName)
+    {
+      if (latencies.empty()) return;
+
+      std::sort(latencies.begin(), latencies.end());
+      long total = 0;
+      for (long l : latencies) total += l;
+      size_t n = latencies.size();
+
+      cout << opName << ": " << n << " calls, " << total / 1000 << " ms total" << endl;
+      cout << "  latency [us]: mean = " << total / static_cast<long>(n);
+      cout << ", p50 = " << percentile(50) << ", p90 = " << percentile(90);
+      cout << ", p99 = " << percentile(99) << ", max = " << latencies.back() << endl;
+      cout << "  SQL statements: " << totalStatements << " total, ";
+      cout << std::fixed << std::setprecision(1) << (totalStatements * 1.0) / n << " per call" << endl;
+
+      long maxCount = *(std::max_element(histogram.begin(), histogram.end()));
+      for (size_t i=0; i < histogram.size(); ++i)
+      {
+        if (histogram[i] == 0) continue;
+
+        long lower = (i == 0) ? 0 : (1L << (i - 1));
+        long upper = (1L << i);
+        int barLen = static_cast<int>((histogram[i] * 50) / maxCount);
+        cout << "    " << std::setw(9) << lower << " - " << std::setw(9) << upper << " us: ";
+        cout << std::setw(7) << histogram[i] << " " << string(barLen, '#') << endl;
+      }
+      cout << endl;
+    }
+
+  protected:
+    long percentile(int p) const
+    {
+      size_t idx = ((latencies.size() - 1) * p) / 100;
+      return latencies[idx];
+    }
+
+  private:
+    vector<long> latencies;
+    vector<long> histogram;
+    long totalStatements = 0;
+  };
+
+  //----------------------------------------------------------------------------
+
+  /**
+   * Measures latency and SQL statement count of a single
+   * operation from construction to destruction
+   */
+  class OperationTimer
+  {
+  public:
+    OperationTimer(OperationStats& _stats, const SqlProfiler* _prof)
+      :stats{_stats}, prof{_prof}, startTime{std::chrono::steady_clock::now()}, startStatementCount{_prof->getTotalStatementCount()} {}
+
+    ~OperationTimer()
+    {
+      auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+      stats.add(usecs, prof->getTotalStatementCount() - startStatementCount);
+    }
+
+  private:
+    OperationStats& stats;
+    const SqlProfiler* prof;
+    std::chrono::steady_clock::time_point startTime;
+    long startStatementCount;
+  };
+
+  //----------------------------------------------------------------------------
+
+  struct RunningMatch
+  {
+    int matchId;
+    int finishTime;   // in simulated minutes
+
+    bool operator > (const RunningMatch& other) const
+    {
+      return (finishTime > other.finishTime);
+    }
+  };
+
+  //----------------------------------------------------------------------------
+
+  class TournamentSimulation
+  {
+  public:
+    TournamentSimulation(TournamentDB* _db)
+      :prof{_db->getSqlProfiler()}, cm{_db}, mm{_db} {}
+
+    void run()
+    {
+      while (true)
+      {
+        bool hasProgress = handleIntermediateSeeding();
+        hasProgress = stageAndSchedule() || hasProgress;
+        hasProgress = callMatches() || hasProgress;
+
+        if (runningMatches.empty())
+        {
+          if (!hasProgress) break;   // finished or stuck
+          continue;
+        }
+
+        // advance the clock to the next finished match
+        RunningMatch rm = runningMatches.top();
+        runningMatches.pop();
+        simTime = rm.finishTime;
+        enterResult(rm.matchId);
+      }
+    }
+
+    void printSummary()
+    {
+      cout << endl << "Simulated tournament duration: " << simTime / 60 << "h " << simTime % 60 << "min" << endl;
+      cout << "Played matches: " << nPlayedMatches << endl << endl;
+
+      for (auto& s : stats)
+      {
+        s.second.print(s.first);
+      }
+    }
+
+    vector<QString> getUnfinishedCategories()
+    {
+      vector<QString> result;
+      for (const Category& cat : cm.getAllCategories())
+      {
+        if (cat.getState() != STAT_CAT_FINALIZED) result.push_back(cat.getName());
+      }
+      return result;
+    }
+
+  protected:
+    bool handleIntermediateSeeding()
+    {
+      bool hasSeeded = false;
+      for (const Category& cat : cm.getAllCategories())
+      {
+        if (cat.getState() != STAT_CAT_WAIT_FOR_INTERMEDIATE_SEEDING) continue;
+
+        OperationTimer ot{stats["intermediate seeding"], prof};
+        unique_ptr<Category> specializedCat = cat.convertToSpecializedObject();
+        PlayerPairList seeding = specializedCat->getPlayerPairsForIntermediateSeeding();
+        if (cm.continueWithIntermediateSeeding(cat, seeding) == OK) hasSeeded = true;
+      }
+
+      return hasSeeded;
+    }
+
+    bool stageAndSchedule()
+    {
+      // stage everything that's possible; staging can
+      // promote other groups to IDLE, so we repeat
+      // until nothing changes anymore
+      bool hasStagedAny = false;
+      bool hasStaged = true;
+      while (hasStaged)
+      {
+        hasStaged = false;
+        for (const MatchGroup& mg : mm.getAllMatchGroups())
+        {
+          if (mg.getState() != STAT_MG_IDLE) continue;
+
+          OperationTimer ot{stats["stage match group"], prof};
+          if (mm.stageMatchGroup(mg) == OK) hasStaged = true;
+        }
+        hasStagedAny = hasStagedAny || hasStaged;
+      }
+
+      if (hasStagedAny)
+      {
+        OperationTimer ot{stats["schedule"], prof};
+        mm.scheduleAllStagedMatchGroups();
+      }
+
+      return hasStagedAny;
+    }
+
+    bool callMatches()
+    {
+      bool hasCalled = false;
+      while (true)
+      {
+        unique_ptr<Match> ma;
+        {
+          OperationTimer ot{stats["find next match"], prof};
+          int maId;
+          int coId;
+          if (mm.getNextViableMatchCourtPair(&maId, &coId) != OK) break;
+          ma = mm.getMatch(maId);
+        }
+
+        ERR e;
+        {
+          OperationTimer ot{stats["call match"], prof};
+          mm.autoAssignMatchToNextAvailCourt(*ma, &e);
+        }
+        if (e != OK) break;
+
+        // a match takes between 20 and 45 minutes
+        int duration = 20 + (qrand() % 26);
+        runningMatches.push(RunningMatch{ma->getId(), simTime + duration});
+        hasCalled = true;
+      }
+
+      return hasCalled;
+    }
+
+    void enterResult(int matchId)
+    {
+      auto ma = mm.getMatch(matchId);
+      int round = ma->getMatchGroup().getRound();
+      bool isDrawAllowed = ma->getCategory().isDrawAllowedInRound(round);
+      auto score = MatchScore::genRandomScore(2, isDrawAllowed);
+
+      OperationTimer ot{stats["enter result"], prof};
+      if (mm.setMatchScoreAndFinalizeMatch(*ma, *score) == OK) ++nPlayedMatches;
+    }
+
+  private:
+    const SqlProfiler* prof;
+    CatMngr cm;
+    MatchMngr mm;
+    std::priority_queue<RunningMatch, vector<RunningMatch>, std::greater<RunningMatch>> runningMatches;
+    std::map<string, OperationStats> stats;
+    int simTime = 0;
+    int nPlayedMatches = 0;
+  };
+}
+
+//----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+  QString dbFileName;
+  QString traceFileName;
+  LargeTournamentConfig cfg;
+  for (int i=1; i < (argc - 1); i += 2)
+  {
+    string opt{argv[i]};
+    QString val = QString::fromUtf8(argv[i + 1]);
+    if (opt == "--db") dbFileName = val;
+    else if (opt == "--players") cfg.nPlayers = val.toInt();
+    else if (opt == "--categories") cfg.nCategories = val.toInt();
+    else if (opt == "--courts") cfg.nCourts = val.toInt();
+    else if (opt == "--seed") cfg.seed = val.toUInt();
+    else if (opt == "--trace") traceFileName = val;
+    else
+    {
+      cerr << "Unknown option " << opt << endl;
+      return 2;
+    }
+  }
+
+  unique_ptr<TournamentDB> db;
+  if (dbFileName.isEmpty())
+  {
+    cout << "Generating tournament with " << cfg.nPlayers << " players, " << cfg.nCategories;
+    cout << " categories and " << cfg.nCourts << " courts..." << endl;
+    LargeTournamentGenerator gen{cfg};
+    db = gen.generate();
+  } else {
+    ERR e;
+    db = TournamentDB::openExisting(dbFileName, &e);
+    if (db == nullptr)
+    {
+      cerr << "Could not open " << dbFileName.toStdString() << endl;
+      return 2;
+    }
+  }
+
+  // the statement counts are taken from the profiler
+  // of the tournament's database connection
+  qsrand(cfg.seed);
+  db->getSqlProfiler()->start();
+  TournamentSimulation sim{db.get()};
+  if (!(traceFileName.isEmpty())) TraceRecorder::getInstance()->start(traceFileName);
+  sim.run();
+  if (!(traceFileName.isEmpty())) TraceRecorder::getInstance()->stop();
+  sim.printSummary();
+
+  vector<QString> unfinished = sim.getUnfinishedCategories();
+  if (unfinished.empty()) return 0;
+
+  cout << "The following categories could not be finalized:" << endl;
+  for (const QString& catName : unfinished)
+  {
+    cout << "  " << catName.toStdString() << endl;
+  }
+  return 1;
+}
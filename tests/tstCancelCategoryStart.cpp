@@ -0,0 +1,72 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../CatMngr.h"
+#include "../ThreadSafeQueue.h"
+
+#include "LargeTournamentGenerator.h"
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+TEST_F(BasicTestFixture, CanceledCategoryStartIsRolledBack)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Medium);
+  int nMatches = db->getTab(TAB_MATCH)->length();
+  int nGroups = db->getTab(TAB_MATCH_GROUP)->length();
+
+  // an additional category with groups with KO rounds; the
+  // offset avoids name clashes with the existing categories
+  int nSystems = static_cast<int>(LargeTournamentGenerator::getSupportedMatchSystems().size());
+  int catId = gen->addCategory(db.get(), 6 * nSystems);
+  CatMngr cm{db.get()};
+  ASSERT_EQ(STAT_CAT_FROZEN, cm.getCategory(catId)->getState());
+
+  // a canceled start throws upon the first progress step
+  // and the transaction guard rolls back all changes
+  ProgressQueue pq;
+  pq.requestCancel();
+  {
+    auto tg = db->acquireTransactionGuard(false);
+    ASSERT_TRUE(tg != nullptr);
+    ASSERT_THROW(gen->startCategory(db.get(), catId, &pq), OperationCanceledException);
+  }
+  ASSERT_EQ(STAT_CAT_FROZEN, cm.getCategory(catId)->getState());
+  ASSERT_EQ(nMatches, db->getTab(TAB_MATCH)->length());
+  ASSERT_EQ(nGroups, db->getTab(TAB_MATCH_GROUP)->length());
+
+  // a regular start reports its progress and ends with -1
+  ProgressQueue pq2;
+  ASSERT_EQ(OK, gen->startCategory(db.get(), catId, &pq2));
+  ASSERT_EQ(STAT_CAT_IDLE, cm.getCategory(catId)->getState());
+  ASSERT_GT(db->getTab(TAB_MATCH)->length(), nMatches);
+
+  vector<int> vals;
+  ASSERT_GT(pq2.popBatch(vals, ProgressQueue::Capacity), 1u);
+  ASSERT_EQ(-1, vals.back());
+  for (size_t i = 1; i < (vals.size() - 1); ++i)
+  {
+    ASSERT_GE(vals[i], vals[i - 1]);
+    ASSERT_LE(vals[i], 100);
+  }
+}
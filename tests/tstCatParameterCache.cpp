@@ -0,0 +1,159 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../CatMngr.h"
+#include "../CatParameterCache.h"
+#include "../KO_Config.h"
+
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // checks that a setter replaced the cached snapshot
+  // and changed the version number of the category
+  void checkInvalidated(TournamentDB* db, const Category& cat, const spCatParameterSnapshot& oldSnap, int oldVersion)
+  {
+    CatParameterCache* cpc = db->getCatParameterCache();
+    ASSERT_NE(oldVersion, cpc->getVersion(cat.getId()));
+    ASSERT_TRUE(cat.getParameterSnapshot() != oldSnap);
+
+    // the new snapshot is cached again
+    ASSERT_TRUE(cat.getParameterSnapshot() == cat.getParameterSnapshot());
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, CatParameterSnapshotAfterSetters)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario01(db);
+
+  CatMngr cm{db.get()};
+  ASSERT_EQ(OK, cm.createNewCategory("C"));
+  Category cat = cm.getCategory("C");
+  CatParameterCache* cpc = db->getCatParameterCache();
+
+  // repeated reads share the same snapshot
+  spCatParameterSnapshot snap = cat.getParameterSnapshot();
+  ASSERT_TRUE(snap == cat.getParameterSnapshot());
+  ASSERT_EQ(GROUPS_WITH_KO, snap->matchSystem);
+  int ver = cpc->getVersion(cat.getId());
+
+  ASSERT_EQ(OK, cm.setMatchSystem(cat, ROUND_ROBIN));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ver = cpc->getVersion(cat.getId());
+  ASSERT_EQ(ROUND_ROBIN, snap->matchSystem);
+
+  ASSERT_EQ(OK, cm.setSex(cat, F));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ver = cpc->getVersion(cat.getId());
+  ASSERT_EQ(F, snap->sex);
+
+  ASSERT_EQ(OK, cm.setMatchType(cat, DOUBLES));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ver = cpc->getVersion(cat.getId());
+  ASSERT_EQ(DOUBLES, snap->matchType);
+
+  ASSERT_TRUE(cm.setCatParameter(cat, ALLOW_DRAW, true));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ver = cpc->getVersion(cat.getId());
+  ASSERT_TRUE(snap->allowDraw);
+
+  ASSERT_TRUE(cm.setCatParameter(cat, WIN_SCORE, 5));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ver = cpc->getVersion(cat.getId());
+  ASSERT_EQ(5, snap->winScore);
+
+  ASSERT_TRUE(cm.setCatParameter(cat, DRAW_SCORE, 3));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ver = cpc->getVersion(cat.getId());
+  ASSERT_EQ(3, snap->drawScore);
+
+  ASSERT_TRUE(cm.setCatParameter(cat, ROUND_ROBIN_ITERATIONS, 2));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ver = cpc->getVersion(cat.getId());
+  ASSERT_EQ(2, snap->roundRobinIterations);
+
+  KO_Config ko{SEMI, true};
+  ASSERT_TRUE(cm.setCatParameter(cat, GROUP_CONFIG, ko.toString()));
+  checkInvalidated(db.get(), cat, snap, ver);
+  snap = cat.getParameterSnapshot();
+  ASSERT_TRUE(snap->hasValidGroupConfig);
+  ASSERT_EQ(ko.toString(), snap->groupConfigString);
+  ASSERT_EQ(ko.toString(), cat.getGroupConfig().toString());
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, CatParameterSnapshotInvalidGroupConfig)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario01(db);
+
+  CatMngr cm{db.get()};
+  ASSERT_EQ(OK, cm.createNewCategory("C"));
+  Category cat = cm.getCategory("C");
+
+  // an unparsable config string is reported like
+  // before and not silently replaced by a default
+  ASSERT_TRUE(cm.setCatParameter(cat, GROUP_CONFIG, "garbage"));
+  spCatParameterSnapshot snap = cat.getParameterSnapshot();
+  ASSERT_FALSE(snap->hasValidGroupConfig);
+  ASSERT_EQ("garbage", snap->groupConfigString);
+  ASSERT_THROW(cat.getGroupConfig(), std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, CatParameterSnapshotAfterRollback)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario01(db);
+
+  CatMngr cm{db.get()};
+  ASSERT_EQ(OK, cm.createNewCategory("C"));
+  Category cat = cm.getCategory("C");
+  ASSERT_EQ(2, cat.getParameterSnapshot()->winScore);
+
+  // the snapshot reflects changes within a transaction...
+  {
+    auto tg = db->acquireTransactionGuard(false);
+    ASSERT_TRUE(tg != nullptr);
+    ASSERT_TRUE(cm.setCatParameter(cat, WIN_SCORE, 7));
+    ASSERT_EQ(7, cat.getParameterSnapshot()->winScore);
+  }
+
+  // ... and is refreshed after the rollback
+  ASSERT_EQ(2, cat.getParameterSnapshot()->winScore);
+  ASSERT_EQ(2, cat.getParameter_int(WIN_SCORE));
+}
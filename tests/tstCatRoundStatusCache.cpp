@@ -0,0 +1,70 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../CatMngr.h"
+#include "../CatRoundStatusCache.h"
+
+#include "LargeTournamentGenerator.h"
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // fills the cache for all categories and checks the
+  // cached counters against the database contents
+  void checkAllCategories(TournamentDB* db)
+  {
+    CatRoundStatusCache* crsc = db->getRoundStatusCache();
+    CatMngr cm{db};
+    for (const Category& cat : cm.getAllCategories())
+    {
+      CatRoundCounters crc = crsc->getCounters(cat);
+      ASSERT_TRUE(crc == crsc->recalcCountersFromScratch(cat));
+      ASSERT_TRUE(crsc->isConsistent(cat));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, CatRoundStatusCacheIncrementalUpdates)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Small);
+  gen->stageAndScheduleAll(db.get());
+  checkAllCategories(db.get());
+
+  // calling matches updates the counters
+  // of the running matches
+  vector<int> called = gen->callMatches(db.get(), 4);
+  ASSERT_FALSE(called.empty());
+  checkAllCategories(db.get());
+
+  // finishing matches updates the counters of the
+  // finished matches and, eventually, of the groups
+  ASSERT_EQ(static_cast<int>(called.size()), gen->finishMatches(db.get(), called));
+  checkAllCategories(db.get());
+
+  gen->playMatches(db.get(), 30);
+  checkAllCategories(db.get());
+}
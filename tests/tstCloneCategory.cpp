@@ -0,0 +1,112 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../CatMngr.h"
+#include "../PlayerMngr.h"
+
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+TEST_F(BasicTestFixture, CloneCategory)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario02(db);
+
+  CatMngr cm{db.get()};
+  PlayerMngr pm{db.get()};
+  Category ld = cm.getCategory("LD");
+  cm.setCatParam_Score(ld, 3, false);
+
+  // pair a few players, the rest remains unpaired
+  for (int i=0; i < 6; i += 2)
+  {
+    Player p1 = pm.getPlayer("a", QString("f%1").arg(i));
+    Player p2 = pm.getPlayer("a", QString("f%1").arg(i + 1));
+    ASSERT_EQ(OK, cm.pairPlayers(ld, p1, p2));
+  }
+
+  auto pairsTab = db->getTab(TAB_PAIRS);
+  int nCats = cm.getAllCategories().size();
+
+  // invalid postfixes
+  ASSERT_EQ(INVALID_NAME, cm.cloneCategory(ld, ""));
+  ASSERT_EQ(INVALID_NAME, cm.cloneCategory(ld, "12345678901"));
+  ASSERT_EQ(nCats, static_cast<int>(cm.getAllCategories().size()));
+
+  // clone the category twice
+  ASSERT_EQ(OK, cm.cloneCategory(ld, "Clone"));
+  ASSERT_EQ(OK, cm.cloneCategory(ld, "Clone"));
+  ASSERT_EQ(nCats + 2, static_cast<int>(cm.getAllCategories().size()));
+
+  for (int i=1; i <= 2; ++i)
+  {
+    QString cloneName = QString("LD - Clone %1").arg(i);
+    ASSERT_TRUE(cm.hasCategory(cloneName));
+    Category clone = cm.getCategory(cloneName);
+
+    // settings
+    ASSERT_EQ(nCats + i - 1, clone.getSeqNum());
+    ASSERT_EQ(STAT_CAT_CONFIG, clone.getState());
+    ASSERT_EQ(ld.getMatchType(), clone.getMatchType());
+    ASSERT_EQ(ld.getSex(), clone.getSex());
+    ASSERT_EQ(ld.getMatchSystem(), clone.getMatchSystem());
+    ASSERT_EQ(3, clone.getParameter_int(WIN_SCORE));
+    ASSERT_EQ(ld.getParameter_string(GROUP_CONFIG), clone.getParameter_string(GROUP_CONFIG));
+
+    // players and pairs
+    ASSERT_EQ(ld.getAllPlayersInCategory().size(), clone.getAllPlayersInCategory().size());
+    ASSERT_EQ(3, pairsTab->getMatchCountForColumnValue(PAIRS_CAT_REF, clone.getId()));
+    Player p1 = pm.getPlayer("a", "f0");
+    Player p2 = pm.getPlayer("a", "f1");
+    ASSERT_TRUE(clone.isPaired(p1));
+    ASSERT_EQ(p2.getId(), clone.getPartner(p1).getId());
+    ASSERT_FALSE(clone.isPaired(pm.getPlayer("a", "f10")));
+  }
+
+  // the source category is unchanged
+  ASSERT_EQ(3, pairsTab->getMatchCountForColumnValue(PAIRS_CAT_REF, ld.getId()));
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, CloneCategoryWithSpecialCharacters)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario02(db);
+
+  CatMngr cm{db.get()};
+  Category ld = cm.getCategory("LD");
+
+  // quotes and placeholder-like sequences must
+  // appear unmodified in the clone's name
+  QString srcName = "L'D %1 %14";
+  ASSERT_EQ(OK, cm.renameCategory(ld, srcName));
+  ASSERT_EQ(OK, cm.cloneCategory(ld, "%15'x"));
+
+  QString cloneName = srcName + " - %15'x 1";
+  ASSERT_TRUE(cm.hasCategory(cloneName));
+  Category clone = cm.getCategory(cloneName);
+  ASSERT_EQ(cloneName, clone.getName());
+  ASSERT_EQ(ld.getMatchType(), clone.getMatchType());
+  ASSERT_EQ(ld.getSex(), clone.getSex());
+  ASSERT_EQ(ld.getAllPlayersInCategory().size(), clone.getAllPlayersInCategory().size());
+}
@@ -6,6 +6,9 @@
 
 #include "../TournamentDB.h"
 #include "../CSVImporter.h"
+#include "../PlayerMngr.h"
+#include "../TeamMngr.h"
+#include "../CatMngr.h"
 
 #include "BasicTestClass.h"
 
@@ -142,3 +145,59 @@ TEST_F(BasicTestFixture, CSVAnalysis)
                  }
                );
 }
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, CSVImport)
+{
+  unique_ptr<QTournament::TournamentDB> _db;
+  getScenario02(_db);
+  TournamentDB* db = _db.get();
+
+  PlayerMngr pm{db};
+  TeamMngr tm{db};
+  CatMngr cm{db};
+  Category ms = cm.getCategory("MS");
+  Category ld = cm.getCategory("LD");
+  size_t nPlayers = pm.getAllPlayers().size();
+  size_t nMS = ms.getAllPlayersInCategory().size();
+  size_t nLD = ld.getAllPlayersInCategory().size();
+
+  // a successful import with a new team, two
+  // new players and an already existing player
+  string raw = "Doe,John,m,T2,MS\nDoe,Jane,f,T1,LD\nm0,a,m,T1,MS";
+  auto records = convertCSVfromPlainText(db, splitCSV(raw));
+  for (const CSVError& err : analyseCSV(db, records))
+  {
+    ASSERT_FALSE(err.isFatal);
+  }
+  ASSERT_EQ(OK, importCSV(db, records));
+  ASSERT_EQ(nPlayers + 2, pm.getAllPlayers().size());
+  ASSERT_TRUE(tm.hasTeam("T2"));
+  Player john = pm.getPlayer("John", "Doe");
+  ASSERT_EQ("T2", john.getTeam().getName());
+  ASSERT_TRUE(ms.hasPlayer(john));
+  ASSERT_TRUE(ld.hasPlayer(pm.getPlayer("Jane", "Doe")));
+  ASSERT_EQ(nMS + 1, ms.getAllPlayersInCategory().size());  // m0 was already in MS
+  ASSERT_EQ(nLD + 1, ld.getAllPlayersInCategory().size());
+  ASSERT_FALSE(db->isTransactionRunning());
+
+  // let the insertion of a player fail; the team and the
+  // player that has been inserted before have to be rolled back
+  string sql = string{"CREATE TRIGGER FailTrigger BEFORE INSERT ON "} + TAB_PLAYER;
+  sql += string{" WHEN NEW."} + PL_FNAME + " = 'Fail'";
+  sql += " BEGIN SELECT RAISE(ABORT, 'Test'); END";
+  ASSERT_TRUE(db->execNonQuery(sql));
+
+  nPlayers = pm.getAllPlayers().size();
+  nMS = ms.getAllPlayersInCategory().size();
+  raw = "Smith,Jim,m,T3,MS\nSmith,Fail,m,T3,MS";
+  records = convertCSVfromPlainText(db, splitCSV(raw));
+  ASSERT_TRUE(analyseCSV(db, records).empty());
+  ASSERT_EQ(DATABASE_ERROR, importCSV(db, records));
+  ASSERT_EQ(nPlayers, pm.getAllPlayers().size());
+  ASSERT_FALSE(pm.hasPlayer("Jim", "Smith"));
+  ASSERT_FALSE(tm.hasTeam("T3"));
+  ASSERT_EQ(nMS, ms.getAllPlayersInCategory().size());
+  ASSERT_FALSE(db->isTransactionRunning());
+}
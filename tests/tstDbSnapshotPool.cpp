@@ -0,0 +1,157 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <sqlite3.h>
+
+#include "../TournamentDB.h"
+#include "../DbSnapshotPool.h"
+#include "../CatMngr.h"
+
+#include "LargeTournamentGenerator.h"
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+namespace
+{
+  int countFinishedMatches(TournamentDB* db)
+  {
+    return db->getTab(TAB_MATCH)->getMatchCountForColumnValue(GENERIC_STATE_FIELD_NAME, static_cast<int>(STAT_MA_FINISHED));
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SnapshotIsReadOnlyCopy)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Medium);
+  gen->stageAndScheduleAll(db.get());
+  int nMatches = db->getTab(TAB_MATCH)->length();
+  ASSERT_GT(nMatches, 0);
+
+  ERR e;
+  DbSnapshotLease snap = db->getSnapshotPool()->acquire(&e);
+  ASSERT_EQ(OK, e);
+  ASSERT_TRUE(snap.isValid());
+  ASSERT_TRUE(snap->isSnapshot());
+  ASSERT_FALSE(db->isSnapshot());
+
+  // snapshots have neither an online manager nor a snapshot pool
+  ASSERT_EQ(nullptr, snap->getOnlineManager());
+  ASSERT_EQ(nullptr, snap->getSnapshotPool());
+
+  // the snapshot contains the same data
+  ASSERT_EQ(nMatches, snap->getTab(TAB_MATCH)->length());
+  ASSERT_EQ(CatMngr{db.get()}.getAllCategories().size(), CatMngr{snap.get()}.getAllCategories().size());
+
+  // but can't be modified
+  string sql = "DELETE FROM " + string{TAB_MATCH};
+  int dbErr;
+  snap->execNonQuery(sql.c_str(), &dbErr);
+  ASSERT_NE(SQLITE_OK, dbErr);
+  ASSERT_EQ(nMatches, snap->getTab(TAB_MATCH)->length());
+
+  // changes to the main database don't show up in the snapshot
+  gen->playMatches(db.get(), 5);
+  ASSERT_EQ(5, countFinishedMatches(db.get()));
+  ASSERT_EQ(0, countFinishedMatches(snap.get()));
+
+  // no snapshots while a transaction is running
+  {
+    auto tg = db->acquireTransactionGuard(false);
+    DbSnapshotLease failed = db->getSnapshotPool()->acquire(&e);
+    ASSERT_FALSE(failed.isValid());
+    ASSERT_EQ(DATABASE_ERROR, e);
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SnapshotsAreRecycled)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Medium);
+  gen->stageAndScheduleAll(db.get());
+  DbSnapshotPool* pool = db->getSnapshotPool();
+  ASSERT_EQ(0u, pool->getIdleCount());
+
+  {
+    DbSnapshotLease s1 = pool->acquire();
+    DbSnapshotLease s2 = pool->acquire();
+    DbSnapshotLease s3 = pool->acquire();
+    ASSERT_TRUE(s1.isValid() && s2.isValid() && s3.isValid());
+  }
+
+  // only the configured number of idle snapshots is kept
+  ASSERT_EQ(DbSnapshotPool::DefaultMaxIdleSnapshots, pool->getIdleCount());
+
+  // a recycled snapshot is updated if the database has changed
+  gen->playMatches(db.get(), 3);
+  DbSnapshotLease s = pool->acquire();
+  ASSERT_TRUE(s.isValid());
+  ASSERT_EQ(1u, pool->getIdleCount());
+  ASSERT_EQ(countFinishedMatches(db.get()), countFinishedMatches(s.get()));
+  ASSERT_EQ(3, countFinishedMatches(s.get()));
+
+  // leases may outlive the pool's database
+  db.reset();
+  ASSERT_EQ(3, countFinishedMatches(s.get()));
+  s.release();
+  ASSERT_FALSE(s.isValid());
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SnapshotReadWhileMainThreadWrites)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Medium);
+  gen->stageAndScheduleAll(db.get());
+
+  DbSnapshotLease snap = db->getSnapshotPool()->acquire();
+  ASSERT_TRUE(snap.isValid());
+  int nMatches = snap->getTab(TAB_MATCH)->length();
+
+  // the worker reads from its snapshot while the main thread plays
+  // matches; the worker must always see the same, consistent state
+  bool isConsistent = true;
+  std::thread worker{[&]()
+  {
+    for (int i=0; i < 20; ++i)
+    {
+      CatMngr cm{snap.get()};
+      for (const Category& cat : cm.getAllCategories())
+      {
+        if (cat.getState() != STAT_CAT_IDLE) isConsistent = false;
+      }
+      if (snap->getTab(TAB_MATCH)->length() != nMatches) isConsistent = false;
+    }
+  }};
+  gen->playMatches(db.get(), 20);
+  worker.join();
+
+  ASSERT_TRUE(isConsistent);
+}
@@ -0,0 +1,245 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include "../ExternalPlayerDB.h"
+#include "../ExternalPlayerNameIndex.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // a CSV player list with names "first<n>, last<n>"
+  QString genCsv(int firstIdx, int count)
+  {
+    QString result;
+    for (int i = firstIdx; i < (firstIdx + count); ++i)
+    {
+      result += QString("last%1, first%1, m\n").arg(i);
+    }
+    return result;
+  }
+
+  // lets the commit of the transaction fail that contains
+  // a player with the first name "Fail"; this is done with a deferred
+  // foreign key that is only checked upon commit
+  void installCommitFailure(ExternalPlayerDB* extDb)
+  {
+    extDb->execNonQuery("PRAGMA foreign_keys = ON");
+    extDb->execNonQuery("CREATE TABLE FailParent (id INTEGER PRIMARY KEY)");
+    extDb->execNonQuery("CREATE TABLE FailChild (parentId INTEGER REFERENCES FailParent(id) DEFERRABLE INITIALLY DEFERRED)");
+
+    string sql = "CREATE TRIGGER FailTrigger AFTER INSERT ON " + TAB_EPD_PLAYER;
+    sql += " WHEN NEW." + EPD_PL_FNAME + " = 'Fail'";
+    sql += " BEGIN INSERT INTO FailChild (parentId) VALUES (-1); END";
+    extDb->execNonQuery(sql);
+  }
+
+  // returns "lastName, firstName" of all search results
+  QStringList searchNames(ExternalPlayerDB* extDb, const QString& substring)
+  {
+    QStringList result;
+    for (const ExternalPlayerDatabaseEntry& e : extDb->searchForMatchingPlayers(substring))
+    {
+      result.append(e.getLastname() + ", " + e.getFirstname());
+    }
+    return result;
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST(ExternalPlayerDB, BulkImportWithFailedChunk)
+{
+  auto extDb = ExternalPlayerDB::createNew(":memory:");
+  ASSERT_TRUE(extDb != nullptr);
+  installCommitFailure(extDb.get());
+
+  constexpr int ChunkSize = ExternalPlayerDB::BulkImportChunkSize;
+
+  // the first chunk is okay; the second chunk contains the player that
+  // causes the failure and a player that occurs again in the third chunk
+  QString csv = genCsv(0, ChunkSize);
+  csv += genCsv(ChunkSize, ChunkSize - 1);
+  csv += "Somebody, Fail, f\n";
+  csv += genCsv(2 * ChunkSize, 10);
+  csv += QString("last%1, first%1, m\n").arg(ChunkSize + 5);
+
+  QList<int> newIds;
+  QList<int> skippedIds;
+  QHash<int, QString> id2Team;
+  int errCnt;
+  tie(newIds, skippedIds, id2Team, errCnt) = extDb->bulkImportCSV(csv);
+
+  // the second chunk has been rolled back and counts as errors
+  ASSERT_EQ(ChunkSize, errCnt);
+  ASSERT_EQ(ChunkSize + 11, newIds.size());
+  ASSERT_TRUE(skippedIds.isEmpty());
+  ASSERT_EQ(ChunkSize + 11, extDb->getAllPlayers().size());
+
+  // all returned IDs exist in the database
+  for (int id : newIds)
+  {
+    ASSERT_TRUE(extDb->getPlayer(id) != nullptr);
+    ASSERT_TRUE(id2Team.contains(id));
+  }
+
+  // the duplicate of the rolled back player has not been skipped
+  // but inserted in the third chunk
+  auto pl = extDb->getPlayer(QString("first%1").arg(ChunkSize + 5), QString("last%1").arg(ChunkSize + 5));
+  ASSERT_TRUE(pl != nullptr);
+  ASSERT_TRUE(newIds.contains(pl->getId()));
+
+  // the rolled back players are neither in the database
+  // nor in the name index
+  ASSERT_FALSE(extDb->hasPlayer(QString("first%1").arg(ChunkSize), QString("last%1").arg(ChunkSize)));
+  ASSERT_FALSE(extDb->hasPlayer("Fail", "Somebody"));
+  ASSERT_TRUE(extDb->searchForMatchingPlayers("Fail").isEmpty());
+  ASSERT_EQ(1, extDb->searchForMatchingPlayers(QString("first%1").arg(ChunkSize + 5)).size());
+
+  // a second import only skips the players that actually exist
+  tie(newIds, skippedIds, id2Team, errCnt) = extDb->bulkImportCSV(genCsv(0, 2) + genCsv(ChunkSize, 2));
+  ASSERT_EQ(0, errCnt);
+  ASSERT_EQ(2, newIds.size());
+  ASSERT_EQ(2, skippedIds.size());
+}
+
+//----------------------------------------------------------------------------
+
+TEST(ExternalPlayerDB, NameSearch)
+{
+  auto extDb = ExternalPlayerDB::createNew(":memory:");
+  ASSERT_TRUE(extDb != nullptr);
+
+  QString csv = "Meier, Hans, m\n";
+  csv += "Meierhofer, Anna, f\n";
+  csv += "Schulz, Meike, f\n";
+  csv += "Obermeier, Karl, m\n";
+  csv += "Müller, Jürgen, m\n";
+  csv += "Mueller, Jens, m\n";
+  int errCnt = get<3>(extDb->bulkImportCSV(csv));
+  ASSERT_EQ(0, errCnt);
+
+  // exact last names first, then last name prefixes,
+  // first name prefixes and other substrings
+  QStringList expected{"Meier, Hans", "Meierhofer, Anna", "Schulz, Meike", "Obermeier, Karl"};
+  ASSERT_EQ(expected, searchNames(extDb.get(), "mei"));
+  ASSERT_EQ(expected, searchNames(extDb.get(), "Mei"));
+  ASSERT_EQ(expected, searchNames(extDb.get(), "  MEI "));
+  expected = QStringList{"Meier, Hans", "Meierhofer, Anna", "Obermeier, Karl"};
+  ASSERT_EQ(expected, searchNames(extDb.get(), "meier"));
+  ASSERT_EQ(QStringList{"Obermeier, Karl"}, searchNames(extDb.get(), "bermei"));
+
+  // umlauts are compared case insensitive and
+  // are not mixed up with their transliteration
+  ASSERT_EQ(QStringList{"Müller, Jürgen"}, searchNames(extDb.get(), "mül"));
+  ASSERT_EQ(QStringList{"Müller, Jürgen"}, searchNames(extDb.get(), "MÜLLER"));
+  ASSERT_EQ(QStringList{"Müller, Jürgen"}, searchNames(extDb.get(), "jür"));
+  ASSERT_EQ(QStringList{"Mueller, Jens"}, searchNames(extDb.get(), "muel"));
+
+  // search strings that are too short or don't match at all
+  ASSERT_TRUE(searchNames(extDb.get(), "me").isEmpty());
+  ASSERT_TRUE(searchNames(extDb.get(), "xyz").isEmpty());
+  ASSERT_TRUE(searchNames(extDb.get(), "meix").isEmpty());
+}
+
+//----------------------------------------------------------------------------
+
+TEST(ExternalPlayerDB, NameIndexUpdates)
+{
+  QString dbName = "ExternalPlayerDBTest.db";
+  QFile::remove(dbName);
+
+  auto extDb = ExternalPlayerDB::createNew(dbName);
+  ASSERT_TRUE(extDb != nullptr);
+  ASSERT_TRUE(searchNames(extDb.get(), "lin").isEmpty());
+
+  // single inserts
+  auto pl = extDb->storeNewPlayer(ExternalPlayerDatabaseEntry{"Lin", "Dan"});
+  ASSERT_TRUE(pl != nullptr);
+  ASSERT_EQ(QStringList{"Dan, Lin"}, searchNames(extDb.get(), "lin"));
+  ASSERT_EQ(DONT_CARE, extDb->searchForMatchingPlayers("lin")[0].getSex());
+
+  // updates of the player's sex
+  ASSERT_TRUE(extDb->updatePlayerSexIfUndefined(pl->getId(), M));
+  ASSERT_EQ(M, extDb->searchForMatchingPlayers("lin")[0].getSex());
+
+  // bulk inserts
+  int errCnt = get<3>(extDb->bulkImportCSV("Lindgren, Astrid, f\nKarlsson, Lina, f\n"));
+  ASSERT_EQ(0, errCnt);
+  QStringList expected{"Lindgren, Astrid", "Dan, Lin", "Karlsson, Lina"};
+  ASSERT_EQ(expected, searchNames(extDb.get(), "lin"));
+
+  // the database has no API for renaming players; names that have
+  // been changed by other tools are picked up when the database is opened
+  string sql = "UPDATE " + TAB_EPD_PLAYER + " SET " + EPD_PL_LNAME + " = 'Lindqvist' WHERE id = " + to_string(pl->getId());
+  extDb->execNonQuery(sql);
+  extDb.reset();
+  extDb = ExternalPlayerDB::openExisting(dbName);
+  ASSERT_TRUE(extDb != nullptr);
+  expected = QStringList{"Lindgren, Astrid", "Lindqvist, Lin", "Karlsson, Lina"};
+  ASSERT_EQ(expected, searchNames(extDb.get(), "lin"));
+  ASSERT_TRUE(searchNames(extDb.get(), "dan").isEmpty());
+
+  extDb.reset();
+  QFile::remove(dbName);
+}
+
+//----------------------------------------------------------------------------
+
+TEST(ExternalPlayerDB, NameIndexLatency)
+{
+  // 100k generated names with a realistic
+  // distribution of trigrams
+  const vector<QString> syllables{"ma", "ri", "an", "ne", "ber", "schu", "lz", "mül", "ler", "ko", "wal", "ski", "hof", "er", "te", "li"};
+  ExternalPlayerNameIndex idx;
+  for (int i = 0; i < 100000; ++i)
+  {
+    int n = i;
+    QString lName;
+    QString fName;
+    for (int k = 0; k < 3; ++k)
+    {
+      lName += syllables[n % syllables.size()];
+      n /= static_cast<int>(syllables.size());
+      fName += syllables[(i * 7 + k) % syllables.size()];
+    }
+    idx.addPlayer(i + 1, fName, lName + QString::number(i), (i % 2) ? M : F);
+  }
+  ASSERT_EQ(100000, idx.size());
+
+  // the target is less than 5 ms per search (keystroke)
+  const QStringList queries{"mar", "mül", "schu", "berko", "lerhof", "ski", "anne", "xyz", "li1", "walski"};
+  auto start = std::chrono::steady_clock::now();
+  size_t nResults = 0;
+  for (const QString& q : queries)
+  {
+    nResults += idx.search(q).size();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  long long avgUsecs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / queries.size();
+  ASSERT_GT(nResults, 0u);
+  ASSERT_LT(avgUsecs, 5000);
+}
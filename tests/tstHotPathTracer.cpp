@@ -0,0 +1,136 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "../HotPathTracer.h"
+
+using namespace QTournament;
+
+TEST(HotPathTracer, WritesNestedEvents)
+{
+  QString traceName = "HotPathTracerTest.json";
+  TraceRecorder* tr = TraceRecorder::getInstance();
+
+  // no events are recorded without a session
+  {
+    ScopedTrace st{"outside"};
+  }
+
+  tr->start(traceName);
+  ASSERT_TRUE(tr->isActive());
+  {
+    ScopedTrace outer{"outer"};
+    {
+      ScopedTrace inner{"inner"};
+    }
+  }
+  ASSERT_TRUE(tr->stop());
+  ASSERT_FALSE(tr->isActive());
+
+  // a second stop doesn't do anything
+  ASSERT_FALSE(tr->stop());
+
+  QFile f{traceName};
+  ASSERT_TRUE(f.open(QIODevice::ReadOnly));
+  QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+  f.close();
+  f.remove();
+
+  ASSERT_TRUE(doc.isObject());
+  QJsonArray events = doc.object()["traceEvents"].toArray();
+  ASSERT_EQ(2, events.size());
+
+  // events are recorded when the scope is left,
+  // so the inner event comes first
+  QJsonObject inner = events[0].toObject();
+  QJsonObject outer = events[1].toObject();
+  ASSERT_EQ("inner", inner["name"].toString());
+  ASSERT_EQ("outer", outer["name"].toString());
+  ASSERT_EQ("X", outer["ph"].toString());
+
+  // the inner event is nested in the outer event; allow
+  // for rounding to full microseconds at the end
+  double innerStart = inner["ts"].toDouble();
+  double outerStart = outer["ts"].toDouble();
+  ASSERT_GE(innerStart, outerStart);
+  ASSERT_LE(innerStart + inner["dur"].toDouble(), outerStart + outer["dur"].toDouble() + 2);
+}
+
+//----------------------------------------------------------------------------
+
+TEST(HotPathTracer, RecordsEventsFromMultipleThreads)
+{
+  QString traceName = "HotPathTracerThreadTest.json";
+  constexpr int nThreads = 4;
+  constexpr int nEventsPerThread = 500;
+
+  // the first call of getInstance() may happen in
+  // any thread and must always return the same instance
+  std::vector<TraceRecorder*> instances(nThreads, nullptr);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i)
+  {
+    threads.emplace_back([&instances, i]() { instances[i] = TraceRecorder::getInstance(); });
+  }
+  for (std::thread& t : threads) t.join();
+  threads.clear();
+  for (TraceRecorder* inst : instances) ASSERT_EQ(TraceRecorder::getInstance(), inst);
+
+  // concurrent appends must neither lose nor corrupt events
+  TraceRecorder* tr = TraceRecorder::getInstance();
+  tr->start(traceName);
+  for (int i = 0; i < nThreads; ++i)
+  {
+    threads.emplace_back([]()
+    {
+      for (int n = 0; n < nEventsPerThread; ++n)
+      {
+        ScopedTrace st{"worker"};
+      }
+    });
+  }
+  for (std::thread& t : threads) t.join();
+  ASSERT_TRUE(tr->stop());
+
+  QFile f{traceName};
+  ASSERT_TRUE(f.open(QIODevice::ReadOnly));
+  QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+  f.close();
+  f.remove();
+
+  ASSERT_TRUE(doc.isObject());
+  QJsonArray events = doc.object()["traceEvents"].toArray();
+  ASSERT_EQ(nThreads * nEventsPerThread, events.size());
+
+  // each thread got its own, small thread number
+  for (const QJsonValue& v : events)
+  {
+    int tid = v.toObject()["tid"].toInt();
+    ASSERT_GE(tid, 1);
+    ASSERT_LE(tid, nThreads);
+  }
+}
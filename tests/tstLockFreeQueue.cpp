@@ -0,0 +1,152 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../LockFreeQueue.h"
+#include "../ThreadSafeQueue.h"
+
+TEST(LockFreeQueue, PushAndPop)
+{
+  BoundedLockFreeQueue<int> q{5};
+  ASSERT_EQ(8u, q.capacity());
+  ASSERT_FALSE(q.hasData());
+
+  int val = -1;
+  ASSERT_FALSE(q.tryPop(val));
+
+  // fill the queue
+  for (int i = 0; i < 8; ++i)
+  {
+    ASSERT_TRUE(q.tryPush(i));
+  }
+  ASSERT_FALSE(q.tryPush(42));
+  ASSERT_EQ(8u, q.approxSize());
+
+  // elements come out in FIFO order
+  ASSERT_TRUE(q.tryPop(val));
+  ASSERT_EQ(0, val);
+  ASSERT_EQ(1, q.blockingPop());
+
+  // batch pop
+  vector<int> batch;
+  ASSERT_EQ(3u, q.popBatch(batch, 3));
+  ASSERT_EQ((vector<int>{2, 3, 4}), batch);
+  ASSERT_EQ(3u, q.popBatch(batch, 100));
+  ASSERT_EQ(6u, batch.size());
+  ASSERT_EQ(7, batch.back());
+  ASSERT_FALSE(q.hasData());
+
+  // the ring buffer wraps around
+  for (int i = 0; i < 20; ++i)
+  {
+    ASSERT_TRUE(q.tryPush(i));
+    ASSERT_TRUE(q.tryPop(val));
+    ASSERT_EQ(i, val);
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST(LockFreeQueue, MoveOnlyElements)
+{
+  BoundedLockFreeQueue<unique_ptr<int>> q{4};
+  ASSERT_TRUE(q.tryPush(make_unique<int>(42)));
+
+  unique_ptr<int> p;
+  ASSERT_TRUE(q.tryPop(p));
+  ASSERT_TRUE(p != nullptr);
+  ASSERT_EQ(42, *p);
+}
+
+//----------------------------------------------------------------------------
+
+TEST(LockFreeQueue, MultipleProducers)
+{
+  constexpr int nProducers = 4;
+  constexpr int nValsPerProducer = 20000;
+
+  // a small queue forces the producers to wait for the consumer
+  BoundedLockFreeQueue<int> q{64};
+
+  vector<thread> producers;
+  for (int p = 0; p < nProducers; ++p)
+  {
+    producers.emplace_back([&q, p]()
+    {
+      for (int i = 0; i < nValsPerProducer; ++i)
+      {
+        q.push(p * nValsPerProducer + i);
+      }
+    });
+  }
+
+  // each value must arrive exactly once and the
+  // values of each producer must arrive in order
+  vector<int> lastVal(nProducers, -1);
+  vector<bool> seen(nProducers * nValsPerProducer, false);
+  for (int i = 0; i < (nProducers * nValsPerProducer); ++i)
+  {
+    int val = q.blockingPop();
+    ASSERT_FALSE(seen[val]);
+    seen[val] = true;
+
+    int p = val / nValsPerProducer;
+    ASSERT_GT(val, lastVal[p]);
+    lastVal[p] = val;
+  }
+
+  for (thread& t : producers) t.join();
+  ASSERT_FALSE(q.hasData());
+}
+
+//----------------------------------------------------------------------------
+
+TEST(LockFreeQueue, ProgressQueue)
+{
+  ProgressQueue pq{4};
+  pq.step();
+  pq.step(2);
+  pq.step(5);  // clamped to the max value
+
+  vector<int> vals;
+  ASSERT_EQ(3u, pq.popBatch(vals, 10));
+  ASSERT_EQ((vector<int>{25, 75, 100}), vals);
+
+  // if the queue is full, the oldest values are dropped
+  pq.reset(1000);
+  for (int i = 0; i < 1000; ++i) pq.step();
+  pq.push(-1);
+
+  vals.clear();
+  ASSERT_EQ(ProgressQueue::Capacity, pq.popBatch(vals, 10000));
+  ASSERT_EQ(100, vals[vals.size() - 2]);
+  ASSERT_EQ(-1, vals.back());
+
+  // reset() clears the queue
+  pq.step();
+  pq.reset(10);
+  ASSERT_FALSE(pq.hasData());
+  pq.step();
+  ASSERT_EQ(10, pq.blockingPop());
+
+  ASSERT_THROW(pq.reset(0), std::invalid_argument);
+}
@@ -0,0 +1,108 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../PlayerMngr.h"
+#include "../CatMngr.h"
+#include "../PairDisplayNameCache.h"
+
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // compares a cached name with a name from a fresh cache
+  void checkAgainstFreshCache(TournamentDB* db, int pairId)
+  {
+    PairDisplayNameCache freshCache{db};
+    PairDisplayNameCache* cache = db->getPairDisplayNameCache();
+    for (bool withBrackets : {false, true})
+    {
+      for (int maxLen : {0, 20})
+      {
+        ASSERT_EQ(freshCache.getDisplayName(pairId, maxLen, withBrackets), cache->getDisplayName(pairId, maxLen, withBrackets));
+      }
+    }
+  }
+
+  // returns the ID of the pair that contains a given player or -1
+  int findPairId(const Category& cat, const Player& p)
+  {
+    for (const PlayerPair& pp : cat.getPlayerPairs())
+    {
+      if (!(pp.hasPlayer2())) continue;
+      if ((pp.getPlayer1().getId() == p.getId()) || (pp.getPlayer2().getId() == p.getId())) return pp.getPairId();
+    }
+    return -1;
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, PairDisplayNameCacheUpdates)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario02(db);
+
+  PlayerMngr pm{db.get()};
+  CatMngr cm{db.get()};
+  Category ld = cm.getCategory("LD");
+  Player f0 = pm.getPlayer("a", "f0");
+  Player f1 = pm.getPlayer("a", "f1");
+  ASSERT_EQ(OK, cm.pairPlayers(ld, f0, f1));
+
+  int pairId = findPairId(ld, f0);
+  ASSERT_GT(pairId, 0);
+
+  // fill the cache
+  PairDisplayNameCache* cache = db->getPairDisplayNameCache();
+  QString oldName = cache->getDisplayName(pairId);
+  ASSERT_TRUE(oldName.contains("f0"));
+  checkAgainstFreshCache(db.get(), pairId);
+
+  // renaming a player
+  ASSERT_EQ(OK, pm.renamePlayer(f0, "Berta", "Renamed"));
+  QString newName = cache->getDisplayName(pairId);
+  ASSERT_NE(oldName, newName);
+  ASSERT_TRUE(newName.contains("Renamed"));
+  ASSERT_FALSE(newName.contains("f0"));
+  checkAgainstFreshCache(db.get(), pairId);
+
+  // unregistered players are put in brackets
+  QString nameWithBrackets = cache->getDisplayName(pairId, 0, true);
+  ASSERT_EQ(OK, pm.setWaitForRegistration(f1, true));
+  ASSERT_NE(nameWithBrackets, cache->getDisplayName(pairId, 0, true));
+  ASSERT_TRUE(cache->getDisplayName(pairId, 0, true).contains("("));
+  checkAgainstFreshCache(db.get(), pairId);
+
+  ASSERT_EQ(OK, pm.setWaitForRegistration(f1, false));
+  ASSERT_EQ(nameWithBrackets, cache->getDisplayName(pairId, 0, true));
+  checkAgainstFreshCache(db.get(), pairId);
+
+  // splitting and re-pairing with another player
+  Player f2 = pm.getPlayer("a", "f2");
+  ASSERT_EQ(OK, cm.splitPlayers(ld, pairId));
+  ASSERT_EQ(OK, cm.pairPlayers(ld, f0, f2));
+  int newPairId = findPairId(ld, f0);
+  ASSERT_GT(newPairId, 0);
+  ASSERT_TRUE(cache->getDisplayName(newPairId).contains("f2"));
+  checkAgainstFreshCache(db.get(), newPairId);
+}
@@ -0,0 +1,92 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../MatchMngr.h"
+#include "../PlayerScheduleIndex.h"
+
+#include "LargeTournamentGenerator.h"
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // returns the IDs of all players of a player pair
+  vector<int> getPlayerIds(const PlayerPair& pp)
+  {
+    vector<int> result{pp.getPlayer1().getId()};
+    if (pp.hasPlayer2()) result.push_back(pp.getPlayer2().getId());
+    return result;
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, PlayerScheduleIndexSwapPlayer)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Small);
+  gen->stageAndScheduleAll(db.get());
+
+  // the first scheduled match is the next match
+  // of all its players, regardless of the category
+  MatchMngr mm{db.get()};
+  auto ma = mm.getMatchByMatchNum(1);
+  ASSERT_TRUE(ma != nullptr);
+  ASSERT_TRUE(ma->hasPlayerPair1());
+  ASSERT_TRUE(ma->hasPlayerPair2());
+  PlayerPair ppOld = ma->getPlayerPair1();
+  int otherPairId = ma->getPlayerPair2().getPairId();
+
+  // a pair of the same category that is not part of the match
+  unique_ptr<PlayerPair> ppNew;
+  for (const PlayerPair& pp : ma->getCategory().getPlayerPairs())
+  {
+    if ((pp.getPairId() == ppOld.getPairId()) || (pp.getPairId() == otherPairId)) continue;
+    ppNew = make_unique<PlayerPair>(pp);
+    break;
+  }
+  ASSERT_TRUE(ppNew != nullptr);
+
+  // fill the index before the swap
+  PlayerScheduleIndex* psi = db->getPlayerScheduleIndex();
+  for (int plId : getPlayerIds(ppOld)) ASSERT_EQ(1, psi->getNextMatchNumber(plId));
+  for (int plId : getPlayerIds(*ppNew)) ASSERT_NE(1, psi->getNextMatchNumber(plId));
+
+  ASSERT_EQ(OK, mm.swapPlayer(*ma, ppOld, *ppNew));
+
+  // the index is updated without being invalidated
+  // and matches an index that is built from scratch
+  PlayerScheduleIndex freshIndex{db.get()};
+  for (int plId : getPlayerIds(*ppNew))
+  {
+    ASSERT_EQ(1, psi->getNextMatchNumber(plId));
+    ASSERT_EQ(freshIndex.getNextMatchNumber(plId), psi->getNextMatchNumber(plId));
+  }
+  for (int plId : getPlayerIds(ppOld))
+  {
+    ASSERT_NE(1, psi->getNextMatchNumber(plId));
+    ASSERT_EQ(freshIndex.getNextMatchNumber(plId), psi->getNextMatchNumber(plId));
+  }
+}
@@ -0,0 +1,188 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+
+#include <QString>
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../TournamentDataDefs.h"
+
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // sizes of the generated tournament
+  constexpr int nPlayers = 4000;
+  constexpr int nPairs = nPlayers / 2;
+  constexpr int nRounds = 20;
+  constexpr int nGroups = 8;
+  constexpr int nMatches = 20000;
+
+  //----------------------------------------------------------------------------
+
+  void execOrFail(TournamentDB* db, const QString& sql)
+  {
+    int dbErr;
+    bool isOkay = db->execNonQuery(sql.toUtf8().constData(), &dbErr);
+    ASSERT_TRUE(isOkay) << sql.toStdString();
+  }
+
+  //----------------------------------------------------------------------------
+
+  // fills the database with a large, synthetic tournament
+  // directly via SQL; the data doesn't need to be consistent
+  // in terms of the tournament logic, it only needs to have
+  // a realistic size and value distribution
+  void generateLargeTournament(TournamentDB* db)
+  {
+    QString series = "WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x+1 FROM cnt WHERE x < %1) ";
+
+    // one category that takes it all
+    QString sql = "INSERT INTO %1 (id, %2, %3, %4) VALUES (1, 'Large', %5, 0)";
+    sql = sql.arg(TAB_CATEGORY).arg(GENERIC_NAME_FIELD_NAME).arg(GENERIC_STATE_FIELD_NAME).arg(GENERIC_SEQNUM_FIELD_NAME);
+    sql = sql.arg(static_cast<int>(STAT_CAT_IDLE));
+    execOrFail(db, sql);
+
+    sql = series.arg(nPlayers) + "INSERT INTO %1 (id, %2, %3, %4, %5, %6) SELECT x, 'f' || x, 'l' || x, %7, x % 2, x - 1 FROM cnt";
+    sql = sql.arg(TAB_PLAYER).arg(PL_FNAME).arg(PL_LNAME).arg(GENERIC_STATE_FIELD_NAME).arg(PL_SEX).arg(GENERIC_SEQNUM_FIELD_NAME);
+    sql = sql.arg(static_cast<int>(STAT_PL_IDLE));
+    execOrFail(db, sql);
+
+    sql = series.arg(nPlayers) + "INSERT INTO %1 (%2, %3) SELECT x, 1 FROM cnt";
+    sql = sql.arg(TAB_P2C).arg(P2C_PLAYER_REF).arg(P2C_CAT_REF);
+    execOrFail(db, sql);
+
+    sql = series.arg(nPairs) + "INSERT INTO %1 (id, %2, %3, %4, %5) SELECT x, 2*x - 1, 2*x, 1, x % %6 + 1 FROM cnt";
+    sql = sql.arg(TAB_PAIRS).arg(PAIRS_PLAYER1_REF).arg(PAIRS_PLAYER2_REF).arg(PAIRS_CAT_REF).arg(PAIRS_GRP_NUM);
+    sql = sql.arg(nGroups);
+    execOrFail(db, sql);
+
+    // one match group per round and group
+    sql = series.arg(nRounds * nGroups) + "INSERT INTO %1 (id, %2, %3, %4, %5, %6) "
+                                          "SELECT x, 1, (x - 1) / %7 + 1, (x - 1) % %7 + 1, %8, x - 1 FROM cnt";
+    sql = sql.arg(TAB_MATCH_GROUP).arg(MG_CAT_REF).arg(MG_ROUND).arg(MG_GRP_NUM);
+    sql = sql.arg(GENERIC_STATE_FIELD_NAME).arg(GENERIC_SEQNUM_FIELD_NAME);
+    sql = sql.arg(nGroups).arg(static_cast<int>(STAT_MG_FINISHED));
+    execOrFail(db, sql);
+
+    // matches in all sorts of states
+    sql = series.arg(nMatches) + "INSERT INTO %1 (id, %2, %3, %4, %5, %6, %7) "
+                                 "SELECT x, x % %8 + 1, x, x % %9 + 1, (x + 7) % %9 + 1, x % 7, x - 1 FROM cnt";
+    sql = sql.arg(TAB_MATCH).arg(MA_GRP_REF).arg(MA_NUM).arg(MA_PAIR1_REF).arg(MA_PAIR2_REF);
+    sql = sql.arg(GENERIC_STATE_FIELD_NAME).arg(GENERIC_SEQNUM_FIELD_NAME);
+    sql = sql.arg(nRounds * nGroups).arg(nPairs);
+    execOrFail(db, sql);
+
+    // one ranking entry per pair and round
+    sql = series.arg(nPairs * nRounds) + "INSERT INTO %1 (%2, %3, %4, %5, %6) "
+                                         "SELECT (x - 1) % %7 + 1, (x - 1) / %7 + 1, 1, (x - 1) % %8 + 1, 0 FROM cnt";
+    sql = sql.arg(TAB_RANKING).arg(RA_PAIR_REF).arg(RA_ROUND).arg(RA_CAT_REF).arg(RA_GRP_NUM).arg(RA_RANK);
+    sql = sql.arg(nPairs).arg(nGroups);
+    execOrFail(db, sql);
+  }
+
+  //----------------------------------------------------------------------------
+
+  // returns all steps of the query plan that are full table scans
+  std::vector<std::string> getFullScans(TournamentDB* db, const QString& sql)
+  {
+    std::vector<std::string> result;
+
+    QString explain = "EXPLAIN QUERY PLAN " + sql;
+    auto stmt = db->execContentQuery(explain.toUtf8().constData());
+    EXPECT_TRUE(stmt != nullptr) << sql.toStdString();
+    if (stmt == nullptr) return result;
+
+    while (stmt->hasData())
+    {
+      std::string detail;
+      stmt->getString(3, &detail);
+
+      // "SEARCH" means index lookup, "SCAN" means a full pass over a
+      // table or index (older SQLite versions print "SCAN TABLE ...")
+      if (detail.find("SCAN") == 0) result.push_back(detail);
+
+      stmt->step();
+    }
+
+    return result;
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, HotQueriesUseIndices)
+{
+  unique_ptr<TournamentDB> _db;
+  getScenario01(_db);
+  TournamentDB* db = _db.get();
+
+  generateLargeTournament(db);
+
+  // the WHERE clauses of the most frequent queries in the managers
+  std::vector<QString> hotQueries{
+    // MatchMngr: next callable match
+    QString("SELECT id FROM %1 WHERE %2 = %3 AND %4 > 0 ORDER BY %4 ASC LIMIT 1")
+        .arg(TAB_MATCH).arg(GENERIC_STATE_FIELD_NAME).arg(static_cast<int>(STAT_MA_READY)).arg(MA_NUM),
+
+    // MatchMngr: match between two pairs
+    QString("SELECT id FROM %1 WHERE %2 = 17 AND %3 = 24").arg(TAB_MATCH).arg(MA_PAIR1_REF).arg(MA_PAIR2_REF),
+
+    // MatchMngr / PlayerProfile: all matches of a pair
+    QString("SELECT id FROM %1 WHERE %2 = 17 OR %3 = 17").arg(TAB_MATCH).arg(MA_PAIR1_REF).arg(MA_PAIR2_REF),
+
+    // MatchGroup: matches of a group in a given state
+    QString("SELECT COUNT(*) FROM %1 WHERE %2 = 5 AND %3 = %4")
+        .arg(TAB_MATCH).arg(MA_GRP_REF).arg(GENERIC_STATE_FIELD_NAME).arg(static_cast<int>(STAT_MA_FINISHED)),
+
+    // MatchMngr: match groups of a category and round
+    QString("SELECT id FROM %1 WHERE %2 = 1 AND %3 = 3").arg(TAB_MATCH_GROUP).arg(MG_CAT_REF).arg(MG_ROUND),
+    QString("SELECT id FROM %1 WHERE %2 = 1 AND %3 = 3 AND %4 = 2")
+        .arg(TAB_MATCH_GROUP).arg(MG_CAT_REF).arg(MG_ROUND).arg(MG_GRP_NUM),
+
+    // RankingMngr: ranking of a category, round and group
+    QString("SELECT id FROM %1 WHERE %2 = 1 AND %3 = 4 AND %4 = 2 ORDER BY %5")
+        .arg(TAB_RANKING).arg(RA_CAT_REF).arg(RA_ROUND).arg(RA_GRP_NUM).arg(RA_RANK),
+
+    // Category: pairs of a group
+    QString("SELECT id FROM %1 WHERE %2 = 1 AND %3 = 3").arg(TAB_PAIRS).arg(PAIRS_CAT_REF).arg(PAIRS_GRP_NUM),
+
+    // Category / PlayerMngr: pairs of a player
+    QString("SELECT id FROM %1 WHERE %2 = 42 OR %3 = 42").arg(TAB_PAIRS).arg(PAIRS_PLAYER1_REF).arg(PAIRS_PLAYER2_REF),
+
+    // Category: is a player in a category
+    QString("SELECT id FROM %1 WHERE %2 = 1 AND %3 = 42").arg(TAB_P2C).arg(P2C_CAT_REF).arg(P2C_PLAYER_REF),
+  };
+
+  for (const QString& sql : hotQueries)
+  {
+    auto scans = getFullScans(db, sql);
+    std::string allScans;
+    for (const std::string& s : scans) allScans += s + "; ";
+    ASSERT_TRUE(scans.empty()) << sql.toStdString() << " --> " << allScans;
+  }
+}
+
+//----------------------------------------------------------------------------
+
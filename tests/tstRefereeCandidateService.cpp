@@ -0,0 +1,102 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../PlayerMngr.h"
+#include "../MatchMngr.h"
+#include "../RefereeCandidateService.h"
+
+#include "LargeTournamentGenerator.h"
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // compares the cached candidates with
+  // candidates that have been loaded from scratch
+  void checkAgainstFreshService(TournamentDB* db)
+  {
+    RefereeCandidateService freshService{db};
+    vector<RefereeCandidate> expected = freshService.getCandidates();
+    vector<RefereeCandidate> actual = db->getRefereeCandidateService()->getCandidates();
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+      ASSERT_EQ(expected[i].playerId, actual[i].playerId);
+      ASSERT_EQ(expected[i].displayName, actual[i].displayName);
+      ASSERT_EQ(expected[i].teamId, actual[i].teamId);
+      ASSERT_EQ(expected[i].teamName, actual[i].teamName);
+      ASSERT_EQ(expected[i].state, actual[i].state);
+      ASSERT_EQ(expected[i].refereeCount, actual[i].refereeCount);
+      ASSERT_EQ(expected[i].lastFinishTime, actual[i].lastFinishTime);
+      ASSERT_EQ(expected[i].nextMatchNumber, actual[i].nextMatchNumber);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, RefereeCandidateServiceUpdatesAfterChanges)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Small);
+  gen->stageAndScheduleAll(db.get());
+
+  // fill the cache
+  RefereeCandidateService* rcs = db->getRefereeCandidateService();
+  ASSERT_FALSE(rcs->getCandidates().empty());
+  checkAgainstFreshService(db.get());
+
+  // renaming a player
+  PlayerMngr pm{db.get()};
+  Player pl = *(pm.getPlayerBySeqNum(0));
+  ASSERT_EQ(OK, pm.renamePlayer(pl, "Xaver", "Aaaaa"));
+  RefereeCandidate rc;
+  ASSERT_TRUE(rcs->getCandidate(pl.getId(), rc));
+  ASSERT_EQ("Aaaaa, Xaver", rc.displayName);
+  ASSERT_EQ(pl.getId(), rcs->getCandidates()[0].playerId);   // the sort order has been updated as well
+  checkAgainstFreshService(db.get());
+
+  // calling a match changes the state of its players
+  vector<int> called = gen->callMatches(db.get(), 1);
+  ASSERT_EQ(1u, called.size());
+  MatchMngr mm{db.get()};
+  auto ma = mm.getMatch(called[0]);
+  int calledPlayerId = ma->getPlayerPair1().getPlayer1().getId();
+  ASSERT_TRUE(rcs->getCandidate(calledPlayerId, rc));
+  ASSERT_EQ(STAT_PL_PLAYING, rc.state);
+  ASSERT_FALSE(rc.lastFinishTime.isValid());
+  checkAgainstFreshService(db.get());
+
+  // finishing the match sets the finish time
+  ASSERT_EQ(1, gen->finishMatches(db.get(), called));
+  ASSERT_TRUE(rcs->getCandidate(calledPlayerId, rc));
+  ASSERT_NE(STAT_PL_PLAYING, rc.state);
+  ASSERT_TRUE(rc.lastFinishTime.isValid());
+  checkAgainstFreshService(db.get());
+
+  // new players invalidate the whole cache
+  ASSERT_EQ(OK, pm.createNewPlayer("Zoe", "Zzzzz", F, "Team 1"));
+  ASSERT_EQ("Zzzzz, Zoe", rcs->getCandidates().back().displayName);
+  checkAgainstFreshService(db.get());
+}
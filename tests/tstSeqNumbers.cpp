@@ -0,0 +1,307 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "../TournamentDB.h"
+#include "../CourtMngr.h"
+#include "../CatMngr.h"
+#include "../MatchMngr.h"
+
+#include "BasicTestClass.h"
+#include "LargeTournamentGenerator.h"
+
+using namespace QTournament;
+
+namespace
+{
+  // checks that the sequence numbers of all courts are 0...n-1
+  // and that the court numbers are still in ascending order
+  void checkCourtSeqNums(CourtMngr& cm, int expectedCount)
+  {
+    ASSERT_EQ(expectedCount, static_cast<int>(cm.getAllCourts().size()));
+
+    int lastCourtNum = -1;
+    for (int seq = 0; seq < expectedCount; ++seq)
+    {
+      auto co = cm.getCourtBySeqNum(seq);
+      ASSERT_TRUE(co != nullptr);
+      ASSERT_GT(co->getNumber(), lastCourtNum);
+      lastCourtNum = co->getNumber();
+    }
+    ASSERT_TRUE(cm.getCourtBySeqNum(expectedCount) == nullptr);
+  }
+
+  // checks that the sequence numbers of a table are 0...n-1
+  void checkSeqNums(TournamentDB* db, const string& tabName)
+  {
+    string sql = "SELECT COUNT(*), COALESCE(MIN(%1), 0), COALESCE(MAX(%1), -1), COUNT(DISTINCT %1) FROM %2";
+    QString qSql = QString::fromUtf8(sql.c_str()).arg(GENERIC_SEQNUM_FIELD_NAME).arg(QString::fromUtf8(tabName.c_str()));
+    auto stmt = db->execContentQuery(qSql.toUtf8().constData());
+    ASSERT_TRUE(stmt != nullptr);
+    ASSERT_TRUE(stmt->hasData());
+
+    int cnt, minSeq, maxSeq, distinctCnt;
+    stmt->getInt(0, &cnt);
+    stmt->getInt(1, &minSeq);
+    stmt->getInt(2, &maxSeq);
+    stmt->getInt(3, &distinctCnt);
+    ASSERT_EQ(0, minSeq);
+    ASSERT_EQ(cnt - 1, maxSeq);
+    ASSERT_EQ(cnt, distinctCnt);
+  }
+
+  // returns the sequence numbers of all courts, indexed by court ID
+  map<int, int> getCourtSeqNums(CourtMngr& cm)
+  {
+    map<int, int> result;
+    for (const Court& co : cm.getAllCourts())
+    {
+      result[co.getId()] = co.getSeqNum();
+    }
+    return result;
+  }
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SeqNumbersAfterDelete)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario01(db);
+
+  CourtMngr cm{db.get()};
+  for (int i=1; i <= 20; ++i)
+  {
+    ERR e;
+    auto co = cm.createNewCourt(i, QString("Court %1").arg(i), &e);
+    ASSERT_EQ(OK, e);
+    ASSERT_EQ(i - 1, co->getSeqNum());
+  }
+  checkCourtSeqNums(cm, 20);
+
+  // delete a court near the start with an active change log
+  db->enableChangeLog(true);
+  ASSERT_TRUE(db->isChangeLogEnabled());
+  auto co = cm.getCourtBySeqNum(2);
+  db->getAllChangesAndClearQueue();
+  ASSERT_EQ(OK, cm.deleteCourt(*co));
+  checkCourtSeqNums(cm, 19);
+
+  // only the deletion itself is logged row by row,
+  // the renumbering is logged as a single shift
+  auto log = db->getAllChangesAndClearQueue();
+  ASSERT_EQ(1u, log.size());
+  ASSERT_TRUE(log[0].action == SqliteOverlay::RowChangeAction::Delete);
+
+  auto shifts = db->getSeqNumShiftsAndClearQueue();
+  ASSERT_EQ(1u, shifts.size());
+  ASSERT_EQ(TAB_COURT, shifts[0].tabName);
+  ASSERT_EQ(3, shifts[0].firstSeqNum);
+  ASSERT_EQ(-1, shifts[0].delta);
+  ASSERT_TRUE(db->getSeqNumShiftsAndClearQueue().empty());
+
+  string sync = db->getSyncStringForSeqNumShifts(shifts);
+  string expectedSync = "SeqNumShift:1\ntabName,firstSeqNum,delta\n";
+  expectedSync += string{TAB_COURT} + ",3,-1\n";
+  ASSERT_EQ(expectedSync, sync);
+  ASSERT_EQ("", db->getSyncStringForSeqNumShifts({}));
+
+  // deleting the last court doesn't shift anything
+  co = cm.getCourtBySeqNum(18);
+  ASSERT_EQ(OK, cm.deleteCourt(*co));
+  checkCourtSeqNums(cm, 18);
+  ASSERT_TRUE(db->getSeqNumShiftsAndClearQueue().empty());
+
+  // no shifts are recorded without change log
+  db->disableChangeLog(true);
+  ASSERT_FALSE(db->isChangeLogEnabled());
+  co = cm.getCourtBySeqNum(0);
+  ASSERT_EQ(OK, cm.deleteCourt(*co));
+  checkCourtSeqNums(cm, 17);
+  ASSERT_TRUE(db->getSeqNumShiftsAndClearQueue().empty());
+
+  // new rows are appended after the renumbered rows
+  ERR e;
+  co = cm.createNewCourt(42, "Court 42", &e);
+  ASSERT_EQ(OK, e);
+  ASSERT_EQ(17, co->getSeqNum());
+  checkCourtSeqNums(cm, 18);
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SeqNumbersAfterDeleteInTransaction)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario01(db);
+
+  CourtMngr cm{db.get()};
+  for (int i=1; i <= 5; ++i)
+  {
+    ERR e;
+    cm.createNewCourt(i, QString("Court %1").arg(i), &e);
+    ASSERT_EQ(OK, e);
+  }
+
+  // the renumbering joins an already running transaction
+  // and is undone by its rollback
+  db->enableChangeLog(true);
+  {
+    auto tg = db->acquireTransactionGuard(false);
+    ASSERT_TRUE(tg != nullptr);
+    auto co = cm.getCourtBySeqNum(0);
+    ASSERT_EQ(OK, cm.deleteCourt(*co));
+    checkCourtSeqNums(cm, 4);
+  }
+  checkCourtSeqNums(cm, 5);
+  ASSERT_EQ(1, cm.getCourtBySeqNum(0)->getNumber());
+
+  // the rolled back shift must not be sent to the server
+  ASSERT_TRUE(db->getSeqNumShiftsAndClearQueue().empty());
+
+  // a committed shift is only queued after the commit
+  {
+    auto tg = db->acquireTransactionGuard(false);
+    ASSERT_TRUE(tg != nullptr);
+    auto co = cm.getCourtBySeqNum(0);
+    ASSERT_EQ(OK, cm.deleteCourt(*co));
+    ASSERT_TRUE(db->getSeqNumShiftsAndClearQueue().empty());
+    ASSERT_TRUE(tg->commit());
+  }
+  checkCourtSeqNums(cm, 4);
+  auto shifts = db->getSeqNumShiftsAndClearQueue();
+  ASSERT_EQ(1, shifts.size());
+  ASSERT_EQ(1, shifts[0].firstSeqNum);
+  ASSERT_EQ(-1, shifts[0].delta);
+  db->disableChangeLog(true);
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SeqNumShiftsWithInsertAndDelete)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario01(db);
+
+  CourtMngr cm{db.get()};
+  for (int i=1; i <= 6; ++i)
+  {
+    ERR e;
+    cm.createNewCourt(i, QString("Court %1").arg(i), &e);
+    ASSERT_EQ(OK, e);
+  }
+
+  // the state of the server before the sync
+  map<int, int> serverSeqNums = getCourtSeqNums(cm);
+
+  // insert and delete courts in one sync window; the inserted
+  // courts are shifted locally by the subsequent deletions
+  db->enableChangeLog(true);
+  ERR e;
+  cm.createNewCourt(7, "Court 7", &e);
+  ASSERT_EQ(OK, e);
+  ASSERT_EQ(OK, cm.deleteCourt(*(cm.getCourtBySeqNum(1))));
+  cm.createNewCourt(8, "Court 8", &e);
+  ASSERT_EQ(OK, e);
+  ASSERT_EQ(OK, cm.deleteCourt(*(cm.getCourtBySeqNum(3))));
+  checkCourtSeqNums(cm, 6);
+
+  auto log = db->getAllChangesAndClearQueue();
+  auto shifts = db->getSeqNumShiftsAndClearQueue();
+  ASSERT_EQ(2u, shifts.size());
+  map<int, int> localSeqNums = getCourtSeqNums(cm);
+
+  // apply the changes like the server does: deletions first,
+  // then the shifts and finally the inserted / updated rows
+  for (const auto& cle : log)
+  {
+    if ((cle.tabName != TAB_COURT) || (cle.action != SqliteOverlay::RowChangeAction::Delete)) continue;
+    serverSeqNums.erase(cle.rowId);
+  }
+  for (const SeqNumShift& s : shifts)
+  {
+    ASSERT_EQ(TAB_COURT, s.tabName);
+    for (auto& entry : serverSeqNums)
+    {
+      if (entry.second >= s.firstSeqNum) entry.second += s.delta;
+    }
+  }
+  for (const auto& cle : log)
+  {
+    if ((cle.tabName != TAB_COURT) || (cle.action == SqliteOverlay::RowChangeAction::Delete)) continue;
+    auto it = localSeqNums.find(cle.rowId);
+    if (it != localSeqNums.end()) serverSeqNums[cle.rowId] = it->second;
+  }
+
+  // the server ends up with the local sequence numbers; shifting
+  // after the upserts would have decremented courts 7 and 8 twice
+  ASSERT_EQ(localSeqNums, serverSeqNums);
+
+  // the sync string contains the shifts in the same order
+  string expectedSync = "SeqNumShift:2\ntabName,firstSeqNum,delta\n";
+  expectedSync += string{TAB_COURT} + ",2,-1\n";
+  expectedSync += string{TAB_COURT} + ",4,-1\n";
+  ASSERT_EQ(expectedSync, db->getSyncStringForSeqNumShifts(shifts));
+
+  db->disableChangeLog(true);
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SeqNumbersAfterDeleteRunningCategory)
+{
+  unique_ptr<TournamentDB> db;
+  unique_ptr<LargeTournamentGenerator> gen;
+  getLargeScenario(db, gen, LargeScenarioSize::Medium);
+  gen->stageAndScheduleAll(db.get());
+  gen->playMatches(db.get(), 20);
+
+  auto maTab = db->getTab(TAB_MATCH);
+  auto mgTab = db->getTab(TAB_MATCH_GROUP);
+  int nMatches = maTab->length();
+  int nGroups = mgTab->length();
+
+  // delete the first category; its matches and groups
+  // are followed by the matches and groups of all other categories
+  CatMngr cm{db.get()};
+  Category cat = cm.getCategoryBySeqNum(0);
+  MatchMngr mm{db.get()};
+  int nCatGroups = mm.getMatchGroupsForCat(cat).size();
+  int nCatMatches = 0;
+  for (const MatchGroup& mg : mm.getMatchGroupsForCat(cat)) nCatMatches += mg.getMatches().size();
+  ASSERT_GT(nCatGroups, 0);
+  ASSERT_GT(nCatMatches, 0);
+
+  db->enableChangeLog(true);
+  ASSERT_EQ(OK, cm.deleteRunningCategory(cat));
+
+  ASSERT_EQ(nMatches - nCatMatches, maTab->length());
+  ASSERT_EQ(nGroups - nCatGroups, mgTab->length());
+  ASSERT_EQ(0, mgTab->getMatchCountForColumnValue(MG_CAT_REF, cat.getId()));
+  checkSeqNums(db.get(), TAB_MATCH);
+  checkSeqNums(db.get(), TAB_MATCH_GROUP);
+  checkSeqNums(db.get(), TAB_CATEGORY);
+
+  // one shift per deleted row instead of one update per shifted row
+  auto shifts = db->getSeqNumShiftsAndClearQueue();
+  ASSERT_EQ(static_cast<size_t>(nCatMatches + nCatGroups + 1), shifts.size());
+  db->disableChangeLog(true);
+}
@@ -0,0 +1,103 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+
+#include "../TournamentDB.h"
+#include "../SqlProfiler.h"
+#include "../CatMngr.h"
+
+#include "BasicTestClass.h"
+
+using namespace QTournament;
+
+TEST(SqlProfiler, NormalizeSql)
+{
+  // literals are replaced, identifiers with digits are kept
+  string sql = SqlProfiler::normalizeSql("SELECT id FROM P2C WHERE  CatRef = 42\n AND Name = 'O''Brien'");
+  ASSERT_EQ("SELECT id FROM P2C WHERE CatRef = ? AND Name = ?", sql);
+
+  // lists are collapsed
+  sql = SqlProfiler::normalizeSql("DELETE FROM Match WHERE id IN (1, 2, 3,4)");
+  ASSERT_EQ("DELETE FROM Match WHERE id IN (?)", sql);
+
+  sql = SqlProfiler::normalizeSql("UPDATE Player SET x = -1.5 ");
+  ASSERT_EQ("UPDATE Player SET x = -?", sql);
+
+  ASSERT_EQ("", SqlProfiler::normalizeSql(nullptr));
+}
+
+//----------------------------------------------------------------------------
+
+TEST_F(BasicTestFixture, SqlProfilerCollectsStatements)
+{
+  unique_ptr<TournamentDB> db;
+  getScenario02(db);
+
+  SqlProfiler* prof = db->getSqlProfiler();
+  ASSERT_TRUE(prof != nullptr);
+  ASSERT_FALSE(prof->isActive());
+  ASSERT_TRUE(prof->getEntries().empty());
+
+  // run a few queries with the profiler enabled
+  ASSERT_TRUE(prof->start());
+  ASSERT_TRUE(prof->isActive());
+  CatMngr cm{db.get()};
+  for (int i=0; i < 3; ++i)
+  {
+    cm.getAllCategories();
+  }
+  prof->stop();
+  ASSERT_FALSE(prof->isActive());
+
+  auto entries = prof->getEntries();
+  ASSERT_FALSE(entries.empty());
+  long totalCount = 0;
+  for (const SqlProfileEntry& e : entries)
+  {
+    ASSERT_GT(e.count, 0);
+    ASSERT_GE(e.totalNanosecs, e.maxNanosecs);
+    ASSERT_EQ(SqlProfiler::normalizeSql(e.normalizedSql.c_str()), e.normalizedSql);
+    totalCount += e.count;
+  }
+  ASSERT_GE(totalCount, 3);
+  ASSERT_EQ(totalCount, prof->getTotalStatementCount());
+
+  // no further collection after stopping
+  cm.getAllCategories();
+  long newTotalCount = 0;
+  for (const SqlProfileEntry& e : prof->getEntries()) newTotalCount += e.count;
+  ASSERT_EQ(totalCount, newTotalCount);
+  ASSERT_EQ(totalCount, prof->getTotalStatementCount());
+
+  // CSV export
+  QString csvName = "SqlProfilerTest.csv";
+  ASSERT_TRUE(prof->writeCSV(csvName));
+  QFile f{csvName};
+  ASSERT_TRUE(f.open(QIODevice::ReadOnly));
+  QString header = QString::fromUtf8(f.readLine());
+  ASSERT_TRUE(header.startsWith("SQL,Count"));
+  f.close();
+  f.remove();
+
+  prof->reset();
+  ASSERT_TRUE(prof->getEntries().empty());
+  ASSERT_EQ(0, prof->getTotalStatementCount());
+}
@@ -79,6 +79,7 @@ CatTabWidget::CatTabWidget()
   connect(cse, SIGNAL(playerRenamed(Player)), this, SLOT(onPlayerRenamed(Player)));
   connect(cse, SIGNAL(playerStatusChanged(int,int,OBJ_STATE,OBJ_STATE)), this, SLOT(onPlayerStateChanged(int,int,OBJ_STATE,OBJ_STATE)));
   connect(cse, SIGNAL(categoryRemovedFromTournament(int,int)), this, SLOT(onCategoryRemoved()));
+  connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onAllModelsReset()));
 
   // tell the list widgets to emit signals if a context menu is requested
   ui.lwUnpaired->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -169,7 +170,7 @@ void CatTabWidget::updateControls()
     
     // read the current group settings from the database and
     // copy them to the widget
-    KO_Config cfg = KO_Config(selectedCat.getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = selectedCat.getGroupConfig();
     ui.grpCfgWidget->applyConfig(cfg);
   }
   else if (ms == RANDOMIZE)
@@ -245,7 +246,7 @@ void CatTabWidget::updateControls()
   }
   if (ms == GROUPS_WITH_KO)
   {
-    KO_Config cfg = KO_Config(selectedCat.getParameter_string(GROUP_CONFIG));
+    KO_Config cfg = selectedCat.getGroupConfig();
     if (cfg.getStartLevel() == FINAL) enableDrawCheckbox = false;
   }
   ui.cbDraw->setEnabled(enableDrawCheckbox);
@@ -1153,6 +1154,16 @@ void CatTabWidget::onCategoryRemoved()
 
 //----------------------------------------------------------------------------
 
+void CatTabWidget::onAllModelsReset()
+{
+  // bulk operations like the CSV import don't emit
+  // individual signals for each modified object
+  updateControls();
+  updatePairs();
+}
+
+//----------------------------------------------------------------------------
+
 void CatTabWidget::onTwoIterationsChanged()
 {
   if (!(ui.catTableView->hasCategorySelected()))
@@ -34,6 +34,7 @@
 #include "ui/commonCommands/cmdBulkRemovePlayersFromCat.h"
 #include "ui/commonCommands/cmdCreateNewPlayerInCat.h"
 #include "ui/commonCommands/cmdImportSinglePlayerFromExternalDatabase.h"
+#include "ui/commonCommands/cmdRunCategoryOperation.h"
 
 #include "CatMngr.h"
 
@@ -446,9 +447,19 @@ void CategoryTableView::onRunCategory()
    * If we made it to this point, it is safe to apply the settings and write to
    * the database.
    */
-  QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-  e = cm.startCategory(*selectedCat, ppListList, initialRanking);
-  QApplication::restoreOverrideCursor();
+  cmdRunCategoryOperation cmd{db, this, tr("Generating matches..."), [&](ProgressQueue* pq)
+  {
+    return cm.startCategory(*selectedCat, ppListList, initialRanking, pq);
+  }};
+  e = cmd.exec();
+  if (e == OPERATION_CANCELED)
+  {
+    // all changes have been rolled back and the category
+    // is still frozen
+    unfreezeAndCleanup(std::move(selectedCat));
+    QMessageBox::information(this, tr("Start category"), tr("Operation cancelled.\nNo matches have been generated."));
+    return;
+  }
   if (e != OK)  // should never happen
   {
     throw std::runtime_error("Unexpected error when starting the category");
@@ -479,9 +490,9 @@ void CategoryTableView::onCloneCategory()
     return;
   }
 
-  QString msg = tr("Cloning the category partially failed.\n");
-  msg += tr("A new category has been created but not all\n");
-  msg += tr("settings, players and/or pairs could be copied to the clone.");
+  QString msg = tr("Cloning the category failed due to\n");
+  msg += tr("a database error.\n\n");
+  msg += tr("No clone has been created.");
   QMessageBox::warning(this, tr("Clone category"), msg);
 
 }
@@ -574,10 +585,17 @@ void CategoryTableView::handleIntermediateSeedingForSelectedCat()
   /*
    * If we made it to this point, we can generate matches for the next round(s)
    */
-  QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
   CatMngr cm{db};
-  ERR e = cm.continueWithIntermediateSeeding(*selectedCat, seeding);
-  QApplication::restoreOverrideCursor();
+  cmdRunCategoryOperation cmd{db, this, tr("Generating matches..."), [&](ProgressQueue* pq)
+  {
+    return cm.continueWithIntermediateSeeding(*selectedCat, seeding, pq);
+  }};
+  ERR e = cmd.exec();
+  if (e == OPERATION_CANCELED)
+  {
+    QMessageBox::information(this, tr("Intermediate Seeding"), tr("Operation cancelled.\nNo matches have been generated."));
+    return;
+  }
   if (e != OK)  // should never happen
   {
     throw std::runtime_error("Unexpected error when applying intermediate seeding");
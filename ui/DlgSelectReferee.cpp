@@ -273,74 +273,54 @@ void DlgSelectReferee::rebuildPlayerList()
   // stop here
   if ((curFilterMode == REFEREE_MODE::SPECIAL_TEAM) && (curTeamId < 1))
   {
-    ui->tabPlayers->rebuildPlayerList(TaggedPlayerList(), ma.getMatchNumber(), curFilterMode);
+    ui->tabPlayers->rebuildPlayerList(db, TaggedCandidateList(), ma.getMatchNumber(), curFilterMode);
     return;
   }
 
-  // determine the list of players for display
-  PlayerMngr pm{db};
-  TeamMngr tm{db};
-  TaggedPlayerList pList;
-  if (curFilterMode == REFEREE_MODE::ALL_PLAYERS)
-  {
-    PlayerList purePlayerList = pm.getAllPlayers();
-
-    // sort players alphabetically
-    std::sort(purePlayerList.begin(), purePlayerList.end(), [](const Player& p1, const Player& p2) {
-      return p1.getDisplayName() < p2.getDisplayName();
-    });
+  // if we currently calling the match or swapping the umpire, only players in state IDLE
+  // may be selected
+  bool idlePlayersOnly = (refAction != REFEREE_ACTION::PRE_ASSIGN);
 
-    // convert to a tagged player list with all tags set to NEUTRAL
-    for (const Player& p : purePlayerList)
-    {
-      pList.push_back(make_pair(p, RefereeSelectionDelegate::NeutralTag));
-    }
-  }
-  if (curFilterMode == REFEREE_MODE::SPECIAL_TEAM)
+  // determine the list of players for display;
+  // the candidates are already sorted alphabetically
+  RefereeCandidateService* rcs = db->getRefereeCandidateService();
+  TaggedCandidateList pList;
+  if ((curFilterMode == REFEREE_MODE::ALL_PLAYERS) || (curFilterMode == REFEREE_MODE::SPECIAL_TEAM))
   {
-    Team selTeam = tm.getTeamById(curTeamId);
-    PlayerList purePlayerList = tm.getPlayersForTeam(selTeam);
-
-    std::sort(purePlayerList.begin(), purePlayerList.end(), [](const Player& p1, const Player& p2) {
-      return p1.getDisplayName() < p2.getDisplayName();
-    });
+    int teamFilter = (curFilterMode == REFEREE_MODE::SPECIAL_TEAM) ? curTeamId : -1;
 
     // convert to a tagged player list with all tags set to NEUTRAL
-    for (const Player& p : purePlayerList)
+    for (const RefereeCandidate& rc : rcs->getCandidates(teamFilter, idlePlayersOnly))
     {
-      pList.push_back(make_pair(p, RefereeSelectionDelegate::NeutralTag));
+      pList.push_back(make_pair(rc, RefereeSelectionDelegate::NeutralTag));
     }
   }
   if (curFilterMode == REFEREE_MODE::RECENT_FINISHERS)
   {
     pList = getPlayerList_recentFinishers();
-  }
 
-  // if we currently calling the match or swapping the umpire, only players in state IDLE
-  // may be selected
-  if (refAction != REFEREE_ACTION::PRE_ASSIGN)
-  {
-    auto it = pList.begin();
-    while (it != pList.end())
+    if (idlePlayersOnly)
     {
-      const TaggedPlayer& tp = *it;
-      const Player& p = tp.first;
-      if (p.getState() != STAT_PL_IDLE)
+      auto it = pList.begin();
+      while (it != pList.end())
       {
-        it = pList.erase(it);
-      } else {
-        ++it;
+        if (it->first.state != STAT_PL_IDLE)
+        {
+          it = pList.erase(it);
+        } else {
+          ++it;
+        }
       }
     }
   }
 
   // add the players to the table
-  ui->tabPlayers->rebuildPlayerList(pList, ma.getMatchNumber(), curFilterMode);
+  ui->tabPlayers->rebuildPlayerList(db, pList, ma.getMatchNumber(), curFilterMode);
 }
 
 //----------------------------------------------------------------------------
 
-TaggedPlayerList DlgSelectReferee::getPlayerList_recentFinishers()
+TaggedCandidateList DlgSelectReferee::getPlayerList_recentFinishers()
 {
   PlayerMngr pm{db};
   PlayerPairList winners;
@@ -354,41 +334,39 @@ TaggedPlayerList DlgSelectReferee::getPlayerList_recentFinishers()
     {losers, RefereeSelectionDelegate::LoserTag},
     {draws, RefereeSelectionDelegate::NeutralTag},
   };
-  TaggedPlayerList result;
+  RefereeCandidateService* rcs = db->getRefereeCandidateService();
+  TaggedCandidateList result;
   for (pair<PlayerPairList&, int> listDef : allLists)
   {
-    PlayerList purePlayerList;
+    vector<int> playerIds;
     for (const PlayerPair& pp : listDef.first)
     {
-      Player p = pp.getPlayer1();
-
-      // if this player is already a referee, skip this player
-      if (p.getState() == STAT_PL_REFEREE) continue;
-
-      // Before we add this player to the result list,
-      // make sure that the player is not already in it
-      if (std::find(purePlayerList.begin(), purePlayerList.end(), p) == purePlayerList.end())
-      {
-        purePlayerList.push_back(p);
-      }
+      playerIds.push_back(pp.getPlayer1().getId());
 
       // if this is a doubles pair, check the second player as well
       if (pp.hasPlayer2())
       {
-        p = pp.getPlayer2();
-        if (p.getState() == STAT_PL_REFEREE) continue;
-        if (std::find(purePlayerList.begin(), purePlayerList.end(), p) == purePlayerList.end())
-        {
-          purePlayerList.push_back(p);
-        }
+        playerIds.push_back(pp.getPlayer2().getId());
       }
     }
 
-    // convert the winner into a tagged player list
+    // convert the player IDs into a tagged candidate list
     // with the tag set to the appropriate value
-    for (const Player& p : purePlayerList)
+    vector<int> processedIds;
+    for (int playerId : playerIds)
     {
-      result.push_back(make_pair(p, listDef.second));
+      // Before we add this player to the result list,
+      // make sure that the player is not already in it
+      if (std::find(processedIds.begin(), processedIds.end(), playerId) != processedIds.end()) continue;
+      processedIds.push_back(playerId);
+
+      RefereeCandidate rc;
+      if (!(rcs->getCandidate(playerId, rc))) continue;
+
+      // if this player is already a referee, skip this player
+      if (rc.state == STAT_PL_REFEREE) continue;
+
+      result.push_back(make_pair(rc, listDef.second));
     }
   }
 
@@ -416,7 +394,7 @@ RefereeTableWidget::RefereeTableWidget(QWidget* parent)
 
 //----------------------------------------------------------------------------
 
-void RefereeTableWidget::rebuildPlayerList(const TaggedPlayerList& pList, int selectedMatchNumer, REFEREE_MODE _refMode)
+void RefereeTableWidget::rebuildPlayerList(TournamentDB* _db, const TaggedCandidateList& pList, int selectedMatchNumer, REFEREE_MODE _refMode)
 {
   // store the current referee mode. We need this to properly
   // initiate the filtering column
@@ -426,73 +404,68 @@ void RefereeTableWidget::rebuildPlayerList(const TaggedPlayerList& pList, int se
   clearContents();
   setRowCount(0);
 
-  // grab the current database handle from the first entry
-  // in the player list
   if (pList.empty())
   {
     setDatabase(nullptr);
     return;
   } else {
-    setDatabase(pList.at(0).first.getDatabaseHandle());
+    setDatabase(_db);
   }
 
   // disable sorting while we're modifying the table
   setSortingEnabled(false);
 
-  // populate the table rows
-  PlayerMngr pm{db};
+  // populate the table rows; all data has already been
+  // collected by the RefereeCandidateService, so we don't
+  // need any database queries here
   setRowCount(pList.size());
   int idxRow = 0;
-  for (const TaggedPlayer& tp : pList)
+  for (const TaggedCandidate& tc : pList)
   {
-    const Player& p = tp.first;
+    const RefereeCandidate& rc = tc.first;
 
     // add the player's name
-    QTableWidgetItem* newItem = new QTableWidgetItem(p.getDisplayName());
-    newItem->setData(Qt::UserRole, p.getId());
-    newItem->setData(Qt::UserRole + 1, tp.second);  // set the tag
+    QTableWidgetItem* newItem = new QTableWidgetItem(rc.displayName);
+    newItem->setData(Qt::UserRole, rc.playerId);
+    newItem->setData(Qt::UserRole + 1, tc.second);  // set the tag
     newItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
     setItem(idxRow, NAME_COL_ID, newItem);
 
     // add the player's team
-    newItem = new QTableWidgetItem(p.getTeam().getName());
-    newItem->setData(Qt::UserRole, p.getId());
+    newItem = new QTableWidgetItem(rc.teamName);
+    newItem->setData(Qt::UserRole, rc.playerId);
     newItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
     setItem(idxRow, TEAM_COL_ID, newItem);
 
     // add the player's referee count
-    int refereeCount = p.getRefereeCount();
-    newItem = new QTableWidgetItem(QString::number(refereeCount));
-    newItem->setData(Qt::UserRole, p.getId());
+    newItem = new QTableWidgetItem(QString::number(rc.refereeCount));
+    newItem->setData(Qt::UserRole, rc.playerId);
     newItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
     setItem(idxRow, REFEREE_COUNT_COL_ID, newItem);
 
     // add the time of the last finished match
-    auto ma = pm.getLastFinishedMatchForPlayer(p);
     QString txt = "--";
-    if (ma != nullptr)
+    if (rc.lastFinishTime.isValid())
     {
-      QDateTime finishTime = ma->getFinishTime();
-      txt = finishTime.toString("HH:mm");
+      txt = rc.lastFinishTime.toString("HH:mm");
     }
     newItem = new QTableWidgetItem(txt);
-    newItem->setData(Qt::UserRole, p.getId());
+    newItem->setData(Qt::UserRole, rc.playerId);
     newItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
     setItem(idxRow, LAST_FINISH_TIME_COL_ID, newItem);
 
     // add the player's status as a color indication in
     // the first column
     newItem = new QTableWidgetItem("");
-    newItem->setData(Qt::UserRole, p.getId());
+    newItem->setData(Qt::UserRole, rc.playerId);
     newItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
     setItem(idxRow, STAT_COL_ID, newItem);
 
     // add the offset to the next match for the player
-    ma = pm.getNextMatchForPlayer(p);
     txt = "--";
-    if (ma != nullptr)
+    if (rc.nextMatchNumber > 0)
     {
-      int matchNumOffset = ma->getMatchNumber() - selectedMatchNumer;
+      int matchNumOffset = rc.nextMatchNumber - selectedMatchNumer;
 
       if (matchNumOffset > 0) txt = "+ %1";
       if (matchNumOffset < 0)
@@ -503,7 +476,7 @@ void RefereeTableWidget::rebuildPlayerList(const TaggedPlayerList& pList, int se
       txt = txt.arg(matchNumOffset);
     }
     newItem = new QTableWidgetItem(txt);
-    newItem->setData(Qt::UserRole, p.getId());
+    newItem->setData(Qt::UserRole, rc.playerId);
     newItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
     setItem(idxRow, NEXT_MATCH_DIST_COL_ID, newItem);
 
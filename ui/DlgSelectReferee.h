@@ -26,6 +26,7 @@
 
 #include "TournamentDB.h"
 #include "Match.h"
+#include "RefereeCandidateService.h"
 #include "delegates/RefereeSelectionDelegate.h"
 #include "AutoSizingTable.h"
 
@@ -35,8 +36,8 @@ namespace Ui {
 
 using namespace QTournament;
 
-using TaggedPlayer = pair<Player, int>;
-using TaggedPlayerList = QList<TaggedPlayer>;
+using TaggedCandidate = pair<RefereeCandidate, int>;
+using TaggedCandidateList = QList<TaggedCandidate>;
 
 class DlgSelectReferee : public QDialog
 {
@@ -67,7 +68,7 @@ private:
   void rebuildPlayerList();
   void resizeTabColumns();
 
-  TaggedPlayerList getPlayerList_recentFinishers();
+  TaggedCandidateList getPlayerList_recentFinishers();
 
   upPlayer finalPlayerSelection;
 };
@@ -88,7 +89,7 @@ public:
   RefereeTableWidget(QWidget* parent=0);
   virtual ~RefereeTableWidget() {}
 
-  void rebuildPlayerList(const TaggedPlayerList& pList, int selectedMatchNumer, REFEREE_MODE _refMode);
+  void rebuildPlayerList(TournamentDB* _db, const TaggedCandidateList& pList, int selectedMatchNumer, REFEREE_MODE _refMode);
   upPlayer getSelectedPlayer();
   bool hasPlayerSelected();
 
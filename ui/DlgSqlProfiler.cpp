@@ -0,0 +1,138 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QTableWidgetItem>
+
+#include "SqlProfiler.h"
+
+#include "DlgSqlProfiler.h"
+#include "ui_DlgSqlProfiler.h"
+
+using namespace QTournament;
+
+DlgSqlProfiler::DlgSqlProfiler(QWidget *parent, SqlProfiler* _prof) :
+  QDialog(parent),
+  ui(new Ui::DlgSqlProfiler), prof{_prof}
+{
+  ui->setupUi(this);
+
+  QStringList headers{tr("Count"), tr("Total [ms]"), tr("Max [ms]"), tr("Mean [us]"), tr("Rows scanned"), tr("SQL")};
+  ui->tabStats->setColumnCount(headers.size());
+  ui->tabStats->setHorizontalHeaderLabels(headers);
+  ui->tabStats->horizontalHeader()->setStretchLastSection(true);
+
+  ui->cbActive->setChecked(prof->isActive());
+
+  updateTable();
+}
+
+//----------------------------------------------------------------------------
+
+DlgSqlProfiler::~DlgSqlProfiler()
+{
+  delete ui;
+}
+
+//----------------------------------------------------------------------------
+
+void DlgSqlProfiler::updateTable()
+{
+  auto allEntries = prof->getEntries();
+
+  // disable sorting while filling the table,
+  // otherwise rows get re-sorted after every item
+  ui->tabStats->setSortingEnabled(false);
+  ui->tabStats->setRowCount(static_cast<int>(allEntries.size()));
+
+  long totalCount = 0;
+  int64_t totalNanosecs = 0;
+  int row = 0;
+  for (const SqlProfileEntry& e : allEntries)
+  {
+    // numeric columns use Qt::DisplayRole with numbers,
+    // so that sorting by these columns works as expected
+    vector<QVariant> values{
+      static_cast<qlonglong>(e.count),
+      e.totalNanosecs / 1000000.0,
+      e.maxNanosecs / 1000000.0,
+      (e.totalNanosecs / 1000.0) / e.count,
+      static_cast<qlonglong>(e.rowsScanned),
+      QString::fromUtf8(e.normalizedSql.c_str())
+    };
+
+    for (size_t col=0; col < values.size(); ++col)
+    {
+      QTableWidgetItem* item = new QTableWidgetItem();
+      item->setData(Qt::DisplayRole, values[col]);
+      ui->tabStats->setItem(row, static_cast<int>(col), item);
+    }
+
+    totalCount += e.count;
+    totalNanosecs += e.totalNanosecs;
+    ++row;
+  }
+
+  ui->tabStats->setSortingEnabled(true);
+  ui->tabStats->resizeColumnsToContents();
+
+  QString summary = tr("%1 statements, %2 distinct, %3 ms total");
+  summary = summary.arg(totalCount).arg(allEntries.size()).arg(totalNanosecs / 1000000.0, 0, 'f', 1);
+  ui->laSummary->setText(summary);
+}
+
+//----------------------------------------------------------------------------
+
+void DlgSqlProfiler::onResetClicked()
+{
+  prof->reset();
+  updateTable();
+}
+
+//----------------------------------------------------------------------------
+
+void DlgSqlProfiler::onExportClicked()
+{
+  QString fName = QFileDialog::getSaveFileName(this, tr("Export SQL statistics"), QString(), tr("CSV files (*.csv)"));
+  if (fName.isEmpty()) return;
+
+  if (!(prof->writeCSV(fName)))
+  {
+    QMessageBox::warning(this, tr("Export SQL statistics"), tr("Could not write the file."));
+  }
+}
+
+//----------------------------------------------------------------------------
+
+void DlgSqlProfiler::onActiveToggled(bool isActive)
+{
+  if (isActive)
+  {
+    if (!(prof->start()))
+    {
+      QMessageBox::warning(this, tr("SQL profiler"), tr("Could not start the profiler."));
+      ui->cbActive->setChecked(false);
+    }
+  } else {
+    prof->stop();
+  }
+
+  updateTable();
+}
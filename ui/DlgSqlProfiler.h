@@ -0,0 +1,58 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DLGSQLPROFILER_H
+#define DLGSQLPROFILER_H
+
+#include <QDialog>
+
+namespace QTournament
+{
+  class SqlProfiler;
+}
+
+namespace Ui {
+  class DlgSqlProfiler;
+}
+
+/**
+ * A debug dialog that shows the statistics collected by the
+ * SQL profiler of the current tournament database.
+ */
+class DlgSqlProfiler : public QDialog
+{
+  Q_OBJECT
+
+public:
+  explicit DlgSqlProfiler(QWidget *parent, QTournament::SqlProfiler* _prof);
+  ~DlgSqlProfiler();
+
+public slots:
+  void updateTable();
+
+protected slots:
+  void onResetClicked();
+  void onExportClicked();
+  void onActiveToggled(bool isActive);
+
+private:
+  Ui::DlgSqlProfiler *ui;
+  QTournament::SqlProfiler* prof;
+};
+
+#endif // DLGSQLPROFILER_H
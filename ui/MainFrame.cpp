@@ -39,6 +39,9 @@
 #include "commonCommands/cmdStartOnlineSession.h"
 #include "commonCommands/cmdDeleteFromServer.h"
 #include "commonCommands/cmdConnectionSettings.h"
+#include "DlgSqlProfiler.h"
+#include "SqlProfiler.h"
+#include "CentralSignalEmitter.h"
 
 using namespace QTournament;
 
@@ -84,6 +87,12 @@ MainFrame::MainFrame()
   connect(serverSyncTimer.get(), SIGNAL(timeout()), this, SLOT(onServerSyncTimerElapsed()));
   serverSyncTimer->start(ServerSyncStatusInterval_ms);
 
+  // none of the timers may access the database while
+  // a worker thread is modifying it
+  CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+  connect(cse, SIGNAL(beginBackgroundDbOperation()), this, SLOT(onBeginBackgroundDbOperation()), Qt::DirectConnection);
+  connect(cse, SIGNAL(endBackgroundDbOperation()), this, SLOT(onEndBackgroundDbOperation()), Qt::DirectConnection);
+
   // prepare a button for triggering a server ping test
   btnPingTest = new QPushButton(statusBar());
   btnPingTest->setText(tr("Ping"));
@@ -1526,6 +1535,16 @@ void MainFrame::onEditConnectionSettings()
 
 //----------------------------------------------------------------------------
 
+void MainFrame::onShowSqlProfiler()
+{
+  if (currentDb == nullptr) return;
+
+  DlgSqlProfiler dlg{this, currentDb->getSqlProfiler()};
+  dlg.exec();
+}
+
+//----------------------------------------------------------------------------
+
 void MainFrame::onToggleTestMenuVisibility()
 {
   ui.menubar->clear();
@@ -1546,6 +1565,7 @@ void MainFrame::onToggleTestMenuVisibility()
 void MainFrame::onDirtyFlagPollTimerElapsed()
 {
   if (currentDb == nullptr) return;
+  if (currentDb->isBackgroundOperationRunning()) return;
 
   if (currentDb->isDirty() != lastDirtyState)
   {
@@ -1564,6 +1584,9 @@ void MainFrame::onAutosaveTimerElapsed()
     return;
   }
 
+  // never save a half-written tournament
+  if (currentDb->isBackgroundOperationRunning()) return;
+
   if (!(currentDb->isDirty()))
   {
     lastAutosaveTimeStatusLabel->clear();
@@ -1605,6 +1628,9 @@ void MainFrame::onServerSyncTimerElapsed()
     return;
   }
 
+  // never sync a half-written tournament
+  if (currentDb->isBackgroundOperationRunning()) return;
+
   // retrieve the status from the online manager
   OnlineMngr* om = currentDb->getOnlineManager();
 
@@ -1805,7 +1831,22 @@ void MainFrame::onBtnPingTestClicked()
 
 //----------------------------------------------------------------------------
 
+void MainFrame::onBeginBackgroundDbOperation()
+{
+  dirtyFlagPollTimer->stop();
+  autosaveTimer->stop();
+  serverSyncTimer->stop();
+}
 
 //----------------------------------------------------------------------------
 
+void MainFrame::onEndBackgroundDbOperation()
+{
+  // restart with the previously used intervals
+  dirtyFlagPollTimer->start();
+  autosaveTimer->start();
+  serverSyncTimer->start();
+}
+
+//----------------------------------------------------------------------------
 
@@ -113,12 +113,15 @@ public slots:
   void onTerminateSession();
   void onDeleteFromServer();
   void onEditConnectionSettings();
+  void onShowSqlProfiler();
 
 private slots:
   void onToggleTestMenuVisibility();
   void onDirtyFlagPollTimerElapsed();
   void onAutosaveTimerElapsed();
   void onServerSyncTimerElapsed();
+  void onBeginBackgroundDbOperation();
+  void onEndBackgroundDbOperation();
   void onBtnPingTestClicked();
 
 };
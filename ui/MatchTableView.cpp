@@ -82,6 +82,11 @@ MatchTableView::MatchTableView(QWidget* parent)
   predictionUpdateTimer = make_unique<QTimer>(this);
   connect(predictionUpdateTimer.get(), SIGNAL(timeout()), this, SLOT(onMatchTimePredictionUpdate()));
   predictionUpdateTimer->start(PREDICTION_UPDATE_INTERVAL__MS);
+
+  // don't touch the database while a worker thread is modifying it
+  CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+  connect(cse, SIGNAL(beginBackgroundDbOperation()), predictionUpdateTimer.get(), SLOT(stop()), Qt::DirectConnection);
+  connect(cse, SIGNAL(endBackgroundDbOperation()), predictionUpdateTimer.get(), SLOT(start()), Qt::DirectConnection);
 }
 
 //----------------------------------------------------------------------------
@@ -387,6 +392,8 @@ void MatchTableView::onSectionHeaderDoubleClicked()
 
 void MatchTableView::onMatchTimePredictionUpdate()
 {
+  if ((db != nullptr) && (db->isBackgroundOperationRunning())) return;
+
   if (hasCustomDataModel())
   {
     customDataModel->recalcPrediction();
@@ -21,6 +21,7 @@
 #include "PlayerTabWidget.h"
 #include "MainFrame.h"
 #include "ui/commonCommands/cmdImportSinglePlayerFromExternalDatabase.h"
+#include "ui/commonCommands/cmdBulkImportToExternalDatabase.h"
 #include "ui/commonCommands/cmdExportPlayerToExternalDatabase.h"
 #include "DlgBulkImportToExtDb.h"
 #include "ExternalPlayerDB.h"
@@ -55,6 +56,7 @@ PlayerTabWidget::PlayerTabWidget()
   CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
   connect(cse, SIGNAL(endCreatePlayer(int)), this, SLOT(onPlayerCountChanged()));
   connect(cse, SIGNAL(endDeletePlayer()), this, SLOT(onPlayerCountChanged()));
+  connect(cse, SIGNAL(endResetAllModels()), this, SLOT(onPlayerCountChanged()));
 
   // connect to the "external player database changed" signel emitted by the player manager
   connect(cse, SIGNAL(externalPlayerDatabaseChanged()), this, SLOT(onExternalDatabaseChanged()), Qt::DirectConnection);
@@ -110,6 +112,7 @@ void PlayerTabWidget::initExternalDatabaseMenu()
 {
   // prepare actions
   actImportFromExtDatabase = new QAction(tr("Import player..."), this);
+  actBulkImportToExtDatabase = new QAction(tr("Add list of players to database..."), this);
   actExportToExtDatabase = new QAction(tr("Export selected player..."), this);
   actSyncAllToExtDatabase = new QAction(tr("Sync all players to database"), this);
 
@@ -117,11 +120,13 @@ void PlayerTabWidget::initExternalDatabaseMenu()
   extDatabaseMenu = make_unique<QMenu>();
   extDatabaseMenu->addAction(actImportFromExtDatabase);
   extDatabaseMenu->addSeparator();
+  extDatabaseMenu->addAction(actBulkImportToExtDatabase);
   extDatabaseMenu->addAction(actExportToExtDatabase);
   extDatabaseMenu->addAction(actSyncAllToExtDatabase);
 
   // connect actions and slots
   connect(actImportFromExtDatabase, SIGNAL(triggered(bool)), this, SLOT(onImportFromExtDatabase()));
+  connect(actBulkImportToExtDatabase, SIGNAL(triggered(bool)), this, SLOT(onBulkImportToExtDatabase()));
   connect(actExportToExtDatabase, SIGNAL(triggered(bool)), this, SLOT(onExportToExtDatabase()));
   connect(actSyncAllToExtDatabase, SIGNAL(triggered(bool)), this, SLOT(onSyncAllToExtDatabase()));
 
@@ -219,6 +224,15 @@ void PlayerTabWidget::onImportFromExtDatabase()
 
 //----------------------------------------------------------------------------
 
+void PlayerTabWidget::onBulkImportToExtDatabase()
+{
+  cmdBulkImportToExternalDatabase cmd{db, this};
+
+  cmd.exec();
+}
+
+//----------------------------------------------------------------------------
+
 void PlayerTabWidget::onExportToExtDatabase()
 {
   ui.playerView->onExportToExtDatabase();
@@ -282,58 +296,14 @@ void PlayerTabWidget::onImportCsv()
     }
   }
 
-  // the actual import
-  TeamMngr tm{db};
-  PlayerMngr pm{db};
-  CatMngr cm{db};
-  ERR err = OK;
-  QString msg;
-  for (const CSVImportRecord& rec : records)
+  // the actual import; this is all-or-nothing
+  ERR err = importCSV(db, records);
+  if (err != OK)
   {
-    if (!(tm.hasTeam(rec.getTeamName())))
-    {
-      err = tm.createNewTeam(rec.getTeamName());
-      if (err != OK)
-      {
-        msg = tr("Error when creating the team '%1'.");
-        msg = msg.arg(rec.getTeamName());
-        break;
-      }
-    }
-
-    if (!(rec.hasExistingName()))
-    {
-      err = pm.createNewPlayer(rec.getFirstName(), rec.getLastName(), rec.getSex(), rec.getTeamName());
-      if (err != OK)
-      {
-        msg = tr("Error when creating the player '%1 %2'.");
-        msg = msg.arg(rec.getFirstName()).arg(rec.getLastName());
-        break;
-      }
-    }
-
-    Player p = *(rec.getExistingPlayer());   // should return the newly created or existing player
-
-    for (const QString& cName : rec.getCatNames())
-    {
-      // skip non-existing categories
-      if (!(cm.hasCategory(cName))) continue;
-
-      Category cat = cm.getCategory(cName);
-
-      // try to add the player to the category.
-      // ignore potential errors; successfull category assignment is optional...
-      cm.addPlayerToCategory(p, cat);
-    }
-
-    // done.
-  }
-  if ((err != OK) && !(msg.isEmpty()))
-  {
-    msg += tr("Import aborted.\n\nThe import might have ");
-    msg += tr("partially succeeded up to this point.");
+    QString msg = tr("The import failed (error code %1).\n\n");
+    msg = msg.arg(static_cast<int>(err));
+    msg += tr("No data has been imported.");
     QMessageBox::critical(this, tr("Import CSV"), msg);
-    return;
   }
 }
 
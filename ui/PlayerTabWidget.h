@@ -51,6 +51,7 @@ private:
 
   unique_ptr<QMenu> extDatabaseMenu;
   QAction* actImportFromExtDatabase;
+  QAction* actBulkImportToExtDatabase;
   QAction* actExportToExtDatabase;
   QAction* actSyncAllToExtDatabase;
 
@@ -64,6 +65,7 @@ public slots:
   void onRegisterAllTriggered();
   void onUnregisterAllTriggered();
   void onImportFromExtDatabase();
+  void onBulkImportToExtDatabase();
   void onExportToExtDatabase();
   void onSyncAllToExtDatabase();
   void onExternalDatabaseChanged();
@@ -90,6 +90,7 @@ void ReportsTabWidget::updateRepPool()
 void ReportsTabWidget::setDatabase(TournamentDB* _db)
 {
   db = _db;
+  repCache = (db == nullptr) ? nullptr : make_unique<ReportCache>(db);
   onResetRequested();
   setEnabled(db != nullptr);
 }
@@ -151,7 +152,7 @@ void ReportsTabWidget::createRootItem()
   repPool.clear();
 
   // delete the currently displayed report
-  curReport = nullptr;   // this calls the destructor of the old report
+  curReport = nullptr;   // this releases the old report
   ui->repViewer->setReport(nullptr);
 }
 
@@ -178,20 +179,46 @@ void ReportsTabWidget::onTreeSelectionChanged()
 
 void ReportsTabWidget::showReport(const QString& repName)
 {
+  // if the report is outdated, the other reports of the same category
+  // are most likely outdated as well. In this case we regenerate all
+  // outdated reports of the category at once; the cache does this in
+  // parallel and browsing through the category's reports is instant afterwards
+  int catId = ReportFactory::getCategoryIdFromReportName(repName);
+  if ((catId > 0) && !(repCache->isUpToDate(repName)))
+  {
+    QStringList catRepNames;
+    for (const upAbstractReport& rep : repPool)
+    {
+      QString n = rep->getName();
+      if (ReportFactory::getCategoryIdFromReportName(n) == catId) catRepNames.append(n);
+    }
+
+    if (catRepNames.contains(repName))
+    {
+      auto freshReports = repCache->getReports(catRepNames);
+      spSimpleReport newReport = freshReports[repName];
+      if (newReport == nullptr) return;
+
+      // see below
+      curReport = newReport;
+      ui->repViewer->setReport(curReport.get());
+      return;
+    }
+  }
+
   for_each(repPool.cbegin(), repPool.cend(), [&](const upAbstractReport& rep)
   {
     if (rep->getName() == repName)
     {
-      upSimpleReport newReport = rep->regenerateReport();
+      // the cache only regenerates the report if
+      // the underlying data has changed
+      spSimpleReport newReport = repCache->getReport(*rep);
       if (newReport == nullptr) return;
 
-      // store the newly created report in our own unique_ptr.
-      // The old report will be automatically deleted
-      //
-      // if we don't store the new report in curReport,
-      // it would be automatically deleted when we leave
-      // this code block
-      curReport = std::move(newReport);
+      // store the report in our own shared_ptr.
+      // This keeps the report alive even if it
+      // is dropped from the cache in the meantime
+      curReport = newReport;
       SimpleReportLib::SimpleReportGenerator* rawPointer = curReport.get();
       ui->repViewer->setReport(rawPointer);
       return;
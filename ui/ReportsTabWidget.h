@@ -26,6 +26,7 @@
 #include <QTreeWidgetItem>
 
 #include "reports/ReportFactory.h"
+#include "reports/ReportCache.h"
 #include "reports/AbstractReport.h"
 #include "TournamentDB.h"
 
@@ -65,7 +66,8 @@ private:
   QTreeWidgetItem* findTreeItemChildByName(QTreeWidgetItem* _parent, const QString& childName) const;
   void createRootItem();
   void showReport(const QString& repName);
-  upSimpleReport curReport;
+  unique_ptr<ReportCache> repCache;
+  spSimpleReport curReport;
   bool isInResetProcedure;
 };
 
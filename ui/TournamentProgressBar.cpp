@@ -29,6 +29,10 @@ TournamentProgressBar::TournamentProgressBar(QWidget* parentWidget)
   // connect to match time prediction updates and match count updates
   CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
   connect(cse, SIGNAL(matchTimePredictionChanged(int,time_t)), this, SLOT(onMatchTimePredictionChanged(int,time_t)));
+
+  // don't poll the database while a worker thread is modifying it
+  connect(cse, SIGNAL(beginBackgroundDbOperation()), statPollTimer.get(), SLOT(stop()), Qt::DirectConnection);
+  connect(cse, SIGNAL(endBackgroundDbOperation()), statPollTimer.get(), SLOT(start()), Qt::DirectConnection);
 }
 
 //----------------------------------------------------------------------------
@@ -60,6 +64,7 @@ void TournamentProgressBar::setDatabase(TournamentDB* _db)
 void TournamentProgressBar::updateProgressBar()
 {
   if (db == nullptr) return;
+  if (db->isBackgroundOperationRunning()) return;
 
   // get updated match status counters
   MatchMngr mm{db};
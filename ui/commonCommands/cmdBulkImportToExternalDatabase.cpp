@@ -0,0 +1,266 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <exception>
+
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QMessageBox>
+#include <QProgressDialog>
+#include <QSet>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "cmdBulkImportToExternalDatabase.h"
+#include "ui/DlgBulkImportToExtDb.h"
+#include "PlayerMngr.h"
+#include "TeamMngr.h"
+#include "CatMngr.h"
+#include "CSVImporter.h"
+
+constexpr int cmdBulkImportToExternalDatabase::ProgressUpdateInterval_ms;
+
+cmdBulkImportToExternalDatabase::cmdBulkImportToExternalDatabase(TournamentDB* _db, QWidget* p)
+  :QObject(), AbstractCommand(_db, p)
+{
+
+}
+
+//----------------------------------------------------------------------------
+
+ERR cmdBulkImportToExternalDatabase::exec()
+{
+  // make sure we have an external database open
+  PlayerMngr pm{db};
+  if (!(pm.hasExternalPlayerDatabaseAvailable()))
+  {
+    QString msg = tr("No valid database for player import available.\n\n");
+    msg +=tr("Is the database configured and the file existing?");
+    QMessageBox::warning(parentWidget, tr("Import players"), msg);
+    return EPD__NOT_OPENED;
+  }
+  ERR e = pm.openConfiguredExternalPlayerDatabase();
+  if (!(pm.hasExternalPlayerDatabaseOpen()) || (e != OK))
+  {
+    QString msg = tr("Could not open database for player import!");
+    QMessageBox::warning(parentWidget, tr("Import players"), msg);
+    return EPD__NOT_OPENED;
+  }
+
+  ExternalPlayerDB* extDb = pm.getExternalPlayerDatabaseHandle();
+
+  // let the user enter the player list and the target team / category
+  DlgBulkImportToExtDb dlg{db, parentWidget};
+  if (dlg.exec() != QDialog::Accepted)
+  {
+    return OK;
+  }
+  QString csv = dlg.getText();
+  if (csv.trimmed().isEmpty()) return OK;
+
+  // the actual import into the external database
+  ImportResult result;
+  bool isComplete = runImport(extDb, csv, result);
+
+  QString msg = tr("%1 new players have been added to the database.\n");
+  msg = msg.arg(get<0>(result).size());
+  msg += tr("%1 players already existed in the database.\n");
+  msg = msg.arg(get<1>(result).size());
+  int errCnt = get<3>(result);
+  if (errCnt > 0)
+  {
+    msg += tr("%1 lines could not be imported.\n").arg(errCnt);
+  }
+
+  if (!isComplete)
+  {
+    msg += tr("\nThe import has been canceled; the remaining lines have not been imported.");
+    QMessageBox::information(parentWidget, tr("Import players"), msg);
+    return OPERATION_CANCELED;
+  }
+  QMessageBox::information(parentWidget, tr("Import players"), msg);
+
+  // add the players to the tournament, if requested
+  int teamId = dlg.getTargetTeamId();
+  if (teamId < 1) return OK;
+
+  e = addToTournament(extDb, result, teamId, dlg.getTargetCatId());
+  if (e != OK)
+  {
+    msg = tr("The players could not be added to the tournament (error code %1).\n\n");
+    msg = msg.arg(static_cast<int>(e));
+    msg += tr("No players have been added to the tournament.");
+    QMessageBox::critical(parentWidget, tr("Import players"), msg);
+  }
+
+  return e;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * Executes ExternalPlayerDB::bulkImportCSV() in a worker thread
+ * and shows a progress dialog in the meantime.
+ *
+ * The worker thread only accesses the external database which is not
+ * used by any timer or model of the GUI. The window-modal progress dialog
+ * prevents any other access by the user while the import is running.
+ *
+ * @return true if the import has been completed, false if it has been canceled
+ */
+bool cmdBulkImportToExternalDatabase::runImport(ExternalPlayerDB* extDb, const QString& csv, ImportResult& result)
+{
+  QProgressDialog dlg{tr("Importing players..."), tr("Cancel"), 0, 100, parentWidget};
+  dlg.setWindowModality(Qt::WindowModal);
+  dlg.setMinimumDuration(500);
+  dlg.setValue(0);
+  connect(this, SIGNAL(progressChanged(int)), &dlg, SLOT(setValue(int)), Qt::QueuedConnection);
+  connect(&dlg, SIGNAL(canceled()), this, SLOT(onCancelRequested()));
+
+  // start the worker and wait in a local event loop
+  // until it has finished
+  std::exception_ptr workerException;
+  QFutureWatcher<void> watcher;
+  QEventLoop loop;
+  connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+  watcher.setFuture(QtConcurrent::run([this, extDb, &csv, &result, &workerException]()
+  {
+    try
+    {
+      result = extDb->bulkImportCSV(csv, &pq);
+    }
+    catch (...)
+    {
+      workerException = std::current_exception();
+    }
+  }));
+
+  QTimer progressTimer;
+  connect(&progressTimer, SIGNAL(timeout()), this, SLOT(onProgressTimerElapsed()));
+  progressTimer.start(ProgressUpdateInterval_ms);
+
+  if (!(watcher.isFinished())) loop.exec();
+
+  progressTimer.stop();
+  disconnect(this, SIGNAL(progressChanged(int)), &dlg, SLOT(setValue(int)));
+  dlg.setValue(dlg.maximum());
+
+  if (workerException) std::rethrow_exception(workerException);
+
+  return !(pq.isCancelRequested());
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * Forwards the latest progress value of the worker to the progress dialog.
+ */
+void cmdBulkImportToExternalDatabase::onProgressTimerElapsed()
+{
+  vector<int> progressValues;
+  pq.popBatch(progressValues, ProgressQueue::Capacity);
+
+  // negative values indicate the end of the operation;
+  // the max value would close the dialog
+  for (auto it = progressValues.rbegin(); it != progressValues.rend(); ++it)
+  {
+    if ((*it >= 0) && (*it < 100))
+    {
+      emit progressChanged(*it);
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+void cmdBulkImportToExternalDatabase::onCancelRequested()
+{
+  pq.requestCancel();
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * Adds the new and the already existing players of an import to the
+ * tournament and, optionally, to a category.
+ *
+ * Players without a defined sex are ignored. The team name from the
+ * import data is used if provided, otherwise the player is assigned
+ * to the selected default team.
+ *
+ * The actual import is done by importCSV(), so this is all-or-nothing.
+ */
+ERR cmdBulkImportToExternalDatabase::addToTournament(ExternalPlayerDB* extDb, const ImportResult& result, int teamId, int catId)
+{
+  TeamMngr tm{db};
+  string defaultTeamName = tm.getTeamById(teamId).getName().toUtf8().constData();
+
+  string catName;
+  if (catId > 0)
+  {
+    CatMngr cm{db};
+    auto cat = cm.getCategory(catId);
+    if (cat != nullptr) catName = cat->getName().toUtf8().constData();
+  }
+
+  // read all players at once instead of
+  // one query per imported player
+  ExternalPlayerDatabaseEntryList allExtPlayers = extDb->getAllPlayers();
+  QHash<int, int> id2Idx;
+  for (int idx = 0; idx < allExtPlayers.size(); ++idx)
+  {
+    id2Idx[allExtPlayers.at(idx).getId()] = idx;
+  }
+
+  const QHash<int, QString>& id2TeamName = get<2>(result);
+  QSet<int> processedIds;
+  vector<CSVImportRecord> records;
+  for (const QList<int>& idList : {get<0>(result), get<1>(result)})
+  {
+    for (int extId : idList)
+    {
+      if (processedIds.contains(extId)) continue;
+      processedIds.insert(extId);
+
+      int idx = id2Idx.value(extId, -1);
+      if (idx < 0) continue;
+      const ExternalPlayerDatabaseEntry& extPlayer = allExtPlayers.at(idx);
+      if (extPlayer.getSex() == DONT_CARE) continue;
+
+      QString teamName = id2TeamName.value(extId);
+      vector<string> rawTexts{
+        extPlayer.getLastname().toUtf8().constData(),
+        extPlayer.getFirstname().toUtf8().constData(),
+        (extPlayer.getSex() == M) ? "m" : "f",
+        teamName.isEmpty() ? defaultTeamName : string{teamName.toUtf8().constData()},
+        catName
+      };
+      records.push_back(CSVImportRecord{db, rawTexts});
+    }
+  }
+  if (records.empty()) return OK;
+
+  // make sure the data set is error free
+  for (const CSVError& err : analyseCSV(db, records))
+  {
+    if (err.isFatal) return INVALID_NAME;
+  }
+
+  return importCSV(db, records);
+}
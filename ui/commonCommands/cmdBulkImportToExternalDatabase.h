@@ -0,0 +1,70 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CMDBULKIMPORTTOEXTERNALDATABASE_H
+#define CMDBULKIMPORTTOEXTERNALDATABASE_H
+
+#include <tuple>
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+
+#include "AbstractCommand.h"
+#include "ExternalPlayerDB.h"
+#include "ThreadSafeQueue.h"
+
+using namespace QTournament;
+
+/**
+ * Imports a list of players into the external player database
+ * and optionally adds them to the tournament and a category.
+ *
+ * The import into the external database runs in a worker thread
+ * while a progress dialog with a cancel button is shown. Chunks that
+ * have already been committed remain in the database if the user cancels
+ * the import.
+ */
+class cmdBulkImportToExternalDatabase : public QObject, AbstractCommand
+{
+  Q_OBJECT
+
+public:
+  cmdBulkImportToExternalDatabase(TournamentDB* _db, QWidget* p);
+  virtual ERR exec() override;
+  virtual ~cmdBulkImportToExternalDatabase() {}
+
+signals:
+  void progressChanged(int newValue);
+
+protected slots:
+  void onProgressTimerElapsed();
+  void onCancelRequested();
+
+protected:
+  using ImportResult = tuple<QList<int>, QList<int>, QHash<int, QString>, int>;
+
+  static constexpr int ProgressUpdateInterval_ms = 50;
+
+  bool runImport(ExternalPlayerDB* extDb, const QString& csv, ImportResult& result);
+  ERR addToTournament(ExternalPlayerDB* extDb, const ImportResult& result, int teamId, int catId);
+
+  ProgressQueue pq;
+};
+
+#endif // CMDBULKIMPORTTOEXTERNALDATABASE_H
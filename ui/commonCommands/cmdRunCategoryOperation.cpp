@@ -0,0 +1,211 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <exception>
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QProgressDialog>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "cmdRunCategoryOperation.h"
+#include "CentralSignalEmitter.h"
+#include "CatRoundStatusCache.h"
+
+constexpr int cmdRunCategoryOperation::ProgressUpdateInterval_ms;
+
+cmdRunCategoryOperation::cmdRunCategoryOperation(TournamentDB* _db, QWidget* p, const QString& _labelText, CatOperation _op)
+  :QObject(), AbstractCommand(_db, p), labelText(_labelText), op(_op), inputReceiver{nullptr}
+{
+
+}
+
+//----------------------------------------------------------------------------
+
+ERR cmdRunCategoryOperation::exec()
+{
+  // stop all timers that access the database and put all
+  // models in reset state while the worker thread is
+  // modifying the database
+  CentralSignalEmitter* cse = CentralSignalEmitter::getInstance();
+  cse->beginBackgroundDbOperation();
+  db->setBackgroundOperationRunning(true);
+  cse->beginResetAllModels();
+  db->getRoundStatusCache()->setBypass(true);
+
+  QProgressDialog dlg{labelText, tr("Cancel"), 0, 100, parentWidget};
+  dlg.setWindowModality(Qt::WindowModal);
+  dlg.setMinimumDuration(500);
+  dlg.setValue(0);
+  connect(this, SIGNAL(progressChanged(int)), &dlg, SLOT(setValue(int)), Qt::QueuedConnection);
+  connect(&dlg, SIGNAL(canceled()), this, SLOT(onCancelRequested()));
+
+  // only the progress dialog receives user input
+  inputReceiver = &dlg;
+  QCoreApplication::instance()->installEventFilter(this);
+
+  // start the worker and wait in a local event loop
+  // until it has finished
+  std::exception_ptr workerException;
+  QFutureWatcher<ERR> watcher;
+  QEventLoop loop;
+  connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+  watcher.setFuture(QtConcurrent::run([this, &workerException]()
+  {
+    try
+    {
+      return runOperation();
+    }
+    catch (...)
+    {
+      workerException = std::current_exception();
+    }
+    return OK;
+  }));
+
+  QTimer progressTimer;
+  connect(&progressTimer, SIGNAL(timeout()), this, SLOT(onProgressTimerElapsed()));
+  progressTimer.start(ProgressUpdateInterval_ms);
+
+  if (!(watcher.isFinished())) loop.exec();
+
+  progressTimer.stop();
+  QCoreApplication::instance()->removeEventFilter(this);
+  inputReceiver = nullptr;
+  disconnect(this, SIGNAL(progressChanged(int)), &dlg, SLOT(setValue(int)));
+  dlg.setValue(dlg.maximum());
+
+  // the worker might have rolled back its transaction; the caches
+  // are only rebuilt here in the GUI thread and never in the worker
+  db->getRoundStatusCache()->setBypass(false);
+  db->invalidateCaches();
+  db->setBackgroundOperationRunning(false);
+  cse->endResetAllModels();
+  cse->endBackgroundDbOperation();
+
+  // errors like a corrupted database are
+  // reported to the caller as before
+  if (workerException) std::rethrow_exception(workerException);
+
+  return watcher.result();
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * Executes the operation in a transaction; this function
+ * is called from the worker thread.
+ *
+ * @return the result of the operation, OPERATION_CANCELED if the user canceled
+ * the operation or DATABASE_ERROR if the transaction could not be started or committed
+ */
+ERR cmdRunCategoryOperation::runOperation()
+{
+  DbLockHolder lh{db, DatabaseAccessRoles::BackgroundThread};
+
+  // the transaction guard rolls back all changes
+  // unless we explicitly commit them
+  bool isDbErr;
+  auto tg = db->acquireTransactionGuard(false, &isDbErr);
+  if (isDbErr || (tg == nullptr)) return DATABASE_ERROR;
+
+  ERR e;
+  try
+  {
+    e = op(&pq);
+  }
+  catch (OperationCanceledException&)
+  {
+    return OPERATION_CANCELED;
+  }
+  if (e != OK) return e;
+
+  // the operation might have finished without another
+  // call to step() after the user canceled it
+  if (pq.isCancelRequested()) return OPERATION_CANCELED;
+
+  return tg->commit() ? OK : DATABASE_ERROR;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * Forwards the latest progress value of the worker to the progress dialog.
+ */
+void cmdRunCategoryOperation::onProgressTimerElapsed()
+{
+  vector<int> progressValues;
+  pq.popBatch(progressValues, ProgressQueue::Capacity);
+
+  // negative values indicate the end of the operation;
+  // the max value would close the dialog
+  for (auto it = progressValues.rbegin(); it != progressValues.rend(); ++it)
+  {
+    if ((*it >= 0) && (*it < 100))
+    {
+      emit progressChanged(*it);
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+void cmdRunCategoryOperation::onCancelRequested()
+{
+  pq.requestCancel();
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * Drops all user input that is not meant for the progress dialog
+ * while the worker thread is running.
+ */
+bool cmdRunCategoryOperation::eventFilter(QObject* watched, QEvent* ev)
+{
+  if (inputReceiver == nullptr) return false;
+
+  switch (ev->type())
+  {
+  case QEvent::MouseButtonPress:
+  case QEvent::MouseButtonRelease:
+  case QEvent::MouseButtonDblClick:
+  case QEvent::MouseMove:
+  case QEvent::KeyPress:
+  case QEvent::KeyRelease:
+  case QEvent::Wheel:
+  case QEvent::TouchBegin:
+  case QEvent::TouchUpdate:
+  case QEvent::TouchEnd:
+  case QEvent::Shortcut:
+  case QEvent::ShortcutOverride:
+  case QEvent::Close:
+  {
+    QWidget* w = qobject_cast<QWidget*>(watched);
+    if (w == nullptr) return false;  // e.g., the QWindow; the event will be forwarded to a widget
+    return ((w != inputReceiver) && !(inputReceiver->isAncestorOf(w)));
+  }
+
+  default:
+    return false;
+  }
+}
@@ -0,0 +1,81 @@
+/*
+ *    This is QTournament, a badminton tournament management program.
+ *    Copyright (C) 2014 - 2017  Volker Knollmann
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CMDRUNCATEGORYOPERATION_H
+#define CMDRUNCATEGORYOPERATION_H
+
+#include <functional>
+
+#include <QObject>
+#include <QString>
+#include <QWidget>
+
+#include "AbstractCommand.h"
+#include "ThreadSafeQueue.h"
+
+using namespace QTournament;
+
+/**
+ * Executes a long running category operation (e.g., starting a category
+ * and generating all its matches) in a worker thread and shows a
+ * progress dialog in the meantime.
+ *
+ * The operation runs in a single transaction. If the operation fails or if
+ * the user cancels it, the transaction is rolled back and the database
+ * is left unchanged.
+ *
+ * While the operation is running, the worker holds the database lock
+ * with its own role and all models are in reset state so that the GUI
+ * keeps painting without reading from the database. Signals emitted by the
+ * worker don't reach any listeners (see CentralSignalEmitter::getInstance());
+ * instead, all caches and models are reset after the operation.
+ *
+ * Furthermore, all timers that access the database are stopped and
+ * user input is only delivered to the progress dialog.
+ */
+class cmdRunCategoryOperation : public QObject, AbstractCommand
+{
+  Q_OBJECT
+
+public:
+  using CatOperation = std::function<ERR (ProgressQueue*)>;
+
+  cmdRunCategoryOperation(TournamentDB* _db, QWidget* p, const QString& _labelText, CatOperation _op);
+  virtual ERR exec() override;
+  virtual ~cmdRunCategoryOperation() {}
+
+signals:
+  void progressChanged(int newValue);
+
+protected slots:
+  void onProgressTimerElapsed();
+  void onCancelRequested();
+
+protected:
+  static constexpr int ProgressUpdateInterval_ms = 50;
+
+  ERR runOperation();
+  virtual bool eventFilter(QObject* watched, QEvent* ev) override;
+
+  QString labelText;
+  CatOperation op;
+  QWidget* inputReceiver;
+  ProgressQueue pq;
+};
+
+#endif // CMDRUNCATEGORYOPERATION_H
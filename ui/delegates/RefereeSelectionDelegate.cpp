@@ -20,6 +20,7 @@
 
 #include "Match.h"
 #include "PlayerMngr.h"
+#include "RefereeCandidateService.h"
 #include "ui/GuiHelpers.h"
 #include "RefereeSelectionDelegate.h"
 #include "DelegateItemLED.h"
@@ -46,12 +47,11 @@ void RefereeSelectionDelegate::paintUnselectedCell(QPainter* painter, const QSty
 
 void RefereeSelectionDelegate::commonPaint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index, bool isSelected) const
 {
-  PlayerMngr pm{db};
   int playerId = index.data(Qt::UserRole).toInt();
-  auto p = pm.getPlayer_up(playerId);
-  if (p == nullptr) return;
+  RefereeCandidate rc;
+  if (!(db->getRefereeCandidateService()->getCandidate(playerId, rc))) return;
 
-  OBJ_STATE plStat = p->getState();
+  OBJ_STATE plStat = rc.state;
 
   // Fill the first cell with the color that indicates the player state
   int col = index.column();